@@ -20,6 +20,7 @@
 #include "actions.h"
 #include "event_queue.h"
 #include "persist_conf.h"
+#include "coupling.h"
 #include "gui_internal.h"
 #include "gui_keypad.h"
 #include "gui_edit_mode.h"
@@ -38,10 +39,12 @@ using namespace gui;
 
 void action_toggle_channel() {
     Channel& channel = Channel::get(g_foundWidgetAtDown.cursor.i);
-    if (channel.isTripped()) {
+    if (coupling::isSlave(channel)) {
+        errorMessageP(PSTR("Channel is coupled!"));
+    } else if (coupling::isTripped(channel)) {
         errorMessageP(PSTR("Channel is tripped!"));
     } else {
-        channel.outputEnable(!channel.isOutputEnabled());
+        coupling::outputEnable(channel, !channel.isOutputEnabled());
     }
 }
 
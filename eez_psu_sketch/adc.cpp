@@ -27,12 +27,34 @@ namespace psu {
 static const uint8_t ADC_REG2_VAL = 0B01100000; // Register 02h: External Vref, 50Hz rejection, PSW off, IDAC off
 static const uint8_t ADC_REG3_VAL = 0B00000000; // Register 03h: IDAC1 disabled, IDAC2 disabled, dedicated DRDY
 
+static const uint16_t SPS_TO_RATE[] = { 20, 45, 90, 175, 330, 600, 1000 };
+
 ////////////////////////////////////////////////////////////////////////////////
 
 AnalogDigitalConverter::AnalogDigitalConverter(Channel &channel_) : channel(channel_) {
     test_result = psu::TEST_SKIPPED;
 
-    current_sps = ADC_SPS;
+    resetPlan();
+    current_sps = plan.sps;
+}
+
+void AnalogDigitalConverter::resetPlan() {
+    plan.sps = ADC_SPS;
+    plan.oversampling = 1;
+    plan.readback_ratio = 0;
+}
+
+uint16_t AnalogDigitalConverter::spsToRate(uint8_t sps) {
+    return SPS_TO_RATE[sps];
+}
+
+uint8_t AnalogDigitalConverter::rateToSps(float rate) {
+    // highest data rate not above the requested one
+    uint8_t sps = 0;
+    while (sps < ADC_SPS_MAX && SPS_TO_RATE[sps + 1] <= rate) {
+        ++sps;
+    }
+    return sps;
 }
 
 uint8_t AnalogDigitalConverter::getReg1Val() {
@@ -40,42 +62,24 @@ uint8_t AnalogDigitalConverter::getReg1Val() {
 }
 
 bool AnalogDigitalConverter::init() {
-    SPI.beginTransaction(ADS1120_SPI);
-    digitalWrite(channel.isolator_pin, ISOLATOR_ENABLE);
-    digitalWrite(channel.adc_pin, LOW);
-
     // Send RESET command
-    SPI.transfer(ADC_RESET);
+    uint8_t reset[] = { ADC_RESET };
+    spi_queue::transfer(ADS1120_SPI, channel.adc_pin, channel.isolator_pin, reset, sizeof(reset));
     delayMicroseconds(100); // Guard time
 
-    SPI.transfer(ADC_WR3S1);
-
-    uint8_t reg1_val = (current_sps << 5) | 0B00000000; // Register 01h: 256KHz modulator clock, Single shot, disable temp sensor, Current sources off
-    SPI.transfer(reg1_val);
-    
-    SPI.transfer(ADC_REG2_VAL);
-    SPI.transfer(ADC_REG3_VAL);
-
-    digitalWrite(channel.adc_pin, HIGH);
-    digitalWrite(channel.isolator_pin, ISOLATOR_DISABLE);
-    SPI.endTransaction();
+    uint8_t config[] = { ADC_WR3S1, getReg1Val(), ADC_REG2_VAL, ADC_REG3_VAL };
+    spi_queue::transfer(ADS1120_SPI, channel.adc_pin, channel.isolator_pin, config, sizeof(config));
 
     return test();
 }
 
 bool AnalogDigitalConverter::test() {
-    SPI.beginTransaction(ADS1120_SPI);
-    digitalWrite(channel.isolator_pin, ISOLATOR_ENABLE);
-    digitalWrite(channel.adc_pin, LOW);
-
-    SPI.transfer(ADC_RD3S1);
-    byte reg1 = SPI.transfer(0);
-    byte reg2 = SPI.transfer(0);
-    byte reg3 = SPI.transfer(0);
+    uint8_t buffer[] = { ADC_RD3S1, 0, 0, 0 };
+    spi_queue::transfer(ADS1120_SPI, channel.adc_pin, channel.isolator_pin, buffer, sizeof(buffer));
 
-    digitalWrite(channel.adc_pin, HIGH);
-    digitalWrite(channel.isolator_pin, ISOLATOR_DISABLE);
-    SPI.endTransaction();
+    byte reg1 = buffer[1];
+    byte reg2 = buffer[2];
+    byte reg3 = buffer[3];
 
     test_result = psu::TEST_OK;
 
@@ -110,6 +114,13 @@ bool AnalogDigitalConverter::test() {
 }
 
 void AnalogDigitalConverter::tick(unsigned long tick_usec) {
+    unsigned long sample_rate_period = tick_usec - sample_rate_start_time;
+    if (sample_rate_period >= 1000000L) {
+        sample_rate = (uint16_t)(num_conversions * 1000000.0f / sample_rate_period + 0.5f);
+        num_conversions = 0;
+        sample_rate_start_time = tick_usec;
+    }
+
     if (channel.isOutputEnabled()) {
         noInterrupts();
         unsigned long last_adc_start_time = start_time;
@@ -149,50 +160,81 @@ void AnalogDigitalConverter::tick(unsigned long tick_usec) {
 }
 
 void AnalogDigitalConverter::start(uint8_t reg0) {
-    SPI.beginTransaction(ADS1120_SPI);
-    digitalWrite(channel.isolator_pin, ISOLATOR_ENABLE);
-    digitalWrite(channel.adc_pin, LOW);
+    uint8_t buffer[4];
+    uint8_t length = 0;
+
+    sample_sum = 0;
+    sample_count = 0;
 
-    uint8_t sps = psu::isTimeCriticalMode() ? ADC_SPS_TIME_CRITICAL : ADC_SPS;
+    // only data rate can change in register 01h, registers 02h and 03h are written once in init
+    uint8_t sps = psu::isTimeCriticalMode() ? ADC_SPS_TIME_CRITICAL : plan.sps;
     if (sps != current_sps) {
         current_sps = sps;
-        SPI.transfer(ADC_WR4S0);
-        SPI.transfer(reg0);
-        SPI.transfer(getReg1Val());
-        SPI.transfer(ADC_REG2_VAL);
-        SPI.transfer(ADC_REG3_VAL);
+        buffer[length++] = ADC_WR2S0;
+        buffer[length++] = reg0;
+        buffer[length++] = getReg1Val();
     } else {
-        SPI.transfer(ADC_WR1S0);
-        SPI.transfer(reg0);
+        buffer[length++] = ADC_WR1S0;
+        buffer[length++] = reg0;
     }
 
+    // Start conversion (single shot)
+    buffer[length++] = ADC_START;
+
     start_reg0 = reg0;
     start_time = micros();
 
-    // Start conversion (single shot)
-    SPI.transfer(ADC_START);
+    spi_queue::transfer(ADS1120_SPI, channel.adc_pin, channel.isolator_pin, buffer, length);
+}
 
-    digitalWrite(channel.adc_pin, HIGH);
-    digitalWrite(channel.isolator_pin, ISOLATOR_DISABLE);
-    SPI.endTransaction();
+bool AnalogDigitalConverter::addSample(int16_t &data) {
+    ++num_conversions;
+
+    sample_sum += data;
+    if (++sample_count < plan.oversampling) {
+        return false;
+    }
+
+    data = (int16_t)(sample_sum / sample_count);
+    return true;
 }
 
+void AnalogDigitalConverter::next() {
+    start_time = micros();
 
-int16_t AnalogDigitalConverter::read() {
-    SPI.beginTransaction(ADS1120_SPI);
-    digitalWrite(channel.isolator_pin, ISOLATOR_ENABLE);
-    digitalWrite(channel.adc_pin, LOW);
+    uint8_t buffer[] = { ADC_START };
+    spi_queue::transfer(ADS1120_SPI, channel.adc_pin, channel.isolator_pin, buffer, sizeof(buffer));
+}
+
+bool AnalogDigitalConverter::isReadbackDue() {
+    if (plan.readback_ratio == 0) {
+        return false;
+    }
 
-    // Read conversion data
-    SPI.transfer(ADC_RDATA);
-    uint16_t dmsb = SPI.transfer(0);
-    uint16_t dlsb = SPI.transfer(0);
+    if (++readback_counter < plan.readback_ratio) {
+        return false;
+    }
 
-    digitalWrite(channel.adc_pin, HIGH);
-    digitalWrite(channel.isolator_pin, ISOLATOR_DISABLE);
-    SPI.endTransaction();
+    readback_counter = 0;
+    return true;
+}
+
+void AnalogDigitalConverter::readFromInterrupt(spi_queue::Callback callback, uint8_t param) {
+    spi_queue::Transaction transaction;
+    transaction.settings = &ADS1120_SPI;
+    transaction.select_pin = channel.adc_pin;
+    transaction.isolator_pin = channel.isolator_pin;
+    transaction.length = 3;
+    transaction.param = param;
+    transaction.data[0] = ADC_RDATA;
+    transaction.data[1] = 0;
+    transaction.data[2] = 0;
+    transaction.callback = callback;
+    spi_queue::transferFromInterrupt(transaction);
+}
 
-    return (int16_t)((dmsb << 8) | dlsb);
+int16_t AnalogDigitalConverter::getReadData(const spi_queue::Transaction &transaction) {
+    return (int16_t)((transaction.data[1] << 8) | transaction.data[2]);
 }
 
 }
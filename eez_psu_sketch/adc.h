@@ -34,6 +34,7 @@ public:
     static const uint8_t ADC_WR3S1 = 0B01000110;
     static const uint8_t ADC_RD3S1 = 0B00100110;
     static const uint8_t ADC_WR1S0 = 0B01000000;
+    static const uint8_t ADC_WR2S0 = 0B01000001;
     static const uint8_t ADC_WR4S0 = 0B01000011;
 
     static const uint8_t ADC_REG0_READ_U_MON = 0x91; // B10010001: [7:4] AINP = AIN1, AINN = AVSS, [3:1] Gain = 1, [0] PGA disabled and bypassed
@@ -42,8 +43,22 @@ public:
     static const uint8_t ADC_REG0_READ_U_SET = 0x81; // B10000001: [7:4] AINP = AIN0, AINN = AVSS, [3:1] Gain = 1, [0] PGA disabled and bypassed
     static const uint8_t ADC_REG0_READ_I_SET = 0xB1; // B10110001: [7:4] AINP = AIN3, AINN = AVSS, [3:1] Gain = 1, [0] PGA disabled and bypassed
 
+    static const uint8_t ADC_SPS_MAX = 6;
+
+    /// How channel is sampled, see SENSe subsystem.
+    struct AcquisitionPlan {
+        /// Data rate code, 0: 20 SPS ... 6: 1000 SPS.
+        uint8_t sps;
+        /// Number of conversions averaged into the single U_MON, I_MON, U_SET or I_SET value.
+        uint8_t oversampling;
+        /// While output is enabled, U_SET and I_SET are read back once every
+        /// readback_ratio U_MON/I_MON cycles. 0 means no readback.
+        uint8_t readback_ratio;
+    };
+
     psu::TestResult test_result;
     uint8_t start_reg0;
+    AcquisitionPlan plan;
 
     AnalogDigitalConverter(Channel &channel);
 
@@ -52,8 +67,28 @@ public:
 
     void tick(unsigned long tick_usec);
 
+    void resetPlan();
+
+    static uint16_t spsToRate(uint8_t sps);
+    static uint8_t rateToSps(float rate);
+
+    /// Measured number of conversions per second.
+    uint16_t getSampleRate() { return sample_rate; }
+
+    /// Start sampling of the signal selected with reg0.
     void start(uint8_t reg0);
-    int16_t read();
+    /// Add conversion result to the current value. Returns false if more
+    /// conversions are required, otherwise data is set to the averaged value.
+    bool addSample(int16_t &data);
+    /// Start next conversion of the same signal.
+    void next();
+    /// Returns true when it is time to read back U_SET and I_SET.
+    bool isReadbackDue();
+
+    /// Read the conversion data from the interrupt handler (see spi_queue::transferFromInterrupt).
+    void readFromInterrupt(spi_queue::Callback callback, uint8_t param);
+    /// Get conversion data from the completed read transaction.
+    static int16_t getReadData(const spi_queue::Transaction &transaction);
 
 private:
     Channel &channel;
@@ -63,6 +98,14 @@ private:
 
     uint8_t adc_timeout_recovery_attempts_counter;
 
+    int32_t sample_sum;
+    uint8_t sample_count;
+    uint8_t readback_counter;
+
+    uint16_t num_conversions;
+    unsigned long sample_rate_start_time;
+    uint16_t sample_rate;
+
     uint8_t getReg1Val();
 };
 
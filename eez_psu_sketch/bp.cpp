@@ -31,16 +31,12 @@ static uint16_t last_conf;
 
 void set(uint16_t conf) {
     if (OPTION_BP) {
-        SPI.beginTransaction(TLC5925_SPI);
+        uint8_t buffer[] = { (uint8_t)(conf >> 8), (uint8_t)(conf & 0xFF) };
         digitalWrite(BP_OE, HIGH);
-        digitalWrite(BP_SELECT, LOW);
-        SPI.transfer(conf >> 8);
-        SPI.transfer(conf & 0xFF);
+        spi_queue::transfer(TLC5925_SPI, BP_SELECT, spi_queue::NO_PIN, buffer, sizeof(buffer));
         last_conf = conf;
-        digitalWrite(BP_SELECT, HIGH);
         digitalWrite(BP_SELECT, LOW);
         digitalWrite(BP_OE, LOW);
-        SPI.endTransaction();
     }
 }
 
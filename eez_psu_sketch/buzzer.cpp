@@ -20,16 +20,6 @@
 #include "buzzer.h"
 
 #if defined (_VARIANT_ARDUINO_DUE_X_)
-/*
-Tone generator
-v1  use timer, and toggle any digital pin in ISR
-funky duration from arduino version
-TODO use FindMckDivisor?
-timer selected will preclude using associated pins for PWM etc.
-could also do timer/pwm hardware toggle where caller controls duration
-*/
-
-
 // timers TC0 TC1 TC2   channels 0-2 ids 0-2  3-5  6-8     AB 0 1
 // use TC1 channel 0
 #define TONE_TIMER TC1
@@ -39,75 +29,182 @@ could also do timer/pwm hardware toggle where caller controls duration
 // TIMER_CLOCK4   84MHz/128 with 16 bit counter give 10 Hz to 656KHz
 //  piano 27Hz to 4KHz
 
-static uint8_t pinEnabled[PINS_COUNT];
-static uint8_t TCChanEnabled = 0;
-static boolean pin_state = false;
-static Tc *chTC = TONE_TIMER;
-static uint32_t chNo = TONE_CHNL;
+/// Timer frequency used to measure the duration of the pause.
+#define PAUSE_FREQUENCY 1000
+#endif
+
+namespace eez {
+namespace psu {
+namespace buzzer {
+
+struct Tone {
+    uint16_t frequency;
+    uint16_t duration;
+};
 
-volatile static int32_t toggle_count;
-static uint32_t tone_pin;
+// Single producer (main loop) and single consumer (timer interrupt) queue.
+static Tone g_queue[BUZZER_QUEUE_SIZE];
+static volatile uint8_t g_head;
+static volatile uint8_t g_tail;
 
-// frequency (in hertz) and duration (in milliseconds).
+static volatile bool g_playing;
 
-void tone(uint32_t ulPin, uint32_t frequency, int32_t duration)
-{
-    const uint32_t rc = VARIANT_MCK / 256 / frequency;
-    tone_pin = ulPin;
-    toggle_count = 0;  // strange  wipe out previous duration
-    if (duration > 0) toggle_count = 2 * frequency * duration / 1000;
-    else toggle_count = -1;
+static bool dequeue(Tone &tone) {
+    if (g_head == g_tail) {
+        return false;
+    }
+    tone = g_queue[g_head];
+    g_head = (g_head + 1) % BUZZER_QUEUE_SIZE;
+    return true;
+}
 
-    if (!TCChanEnabled) {
+#if defined (_VARIANT_ARDUINO_DUE_X_)
+
+static bool g_timerConfigured;
+static volatile int32_t g_toggleCount;
+static volatile bool g_silent;
+static bool g_pinState;
+
+static void setTone(const Tone &tone) {
+    uint32_t frequency = tone.frequency ? tone.frequency : PAUSE_FREQUENCY;
+    g_silent = tone.frequency == 0;
+    // timer interrupt is at the double frequency, pin is toggled on every interrupt
+    g_toggleCount = 2 * frequency * tone.duration / 1000;
+    TC_SetRC(TONE_TIMER, TONE_CHNL, VARIANT_MCK / 256 / frequency);
+}
+
+static void stop() {
+    TC_Stop(TONE_TIMER, TONE_CHNL);
+    digitalWrite(BUZZER, LOW);
+    g_pinState = false;
+    g_playing = false;
+}
+
+/// Start the timer with the first tone from the queue, timer must be stopped.
+static void start() {
+    if (!g_timerConfigured) {
         pmc_set_writeprotect(false);
         pmc_enable_periph_clk((uint32_t)TONE_IRQ);
-        TC_Configure(chTC, chNo,
+        TC_Configure(TONE_TIMER, TONE_CHNL,
             TC_CMR_TCCLKS_TIMER_CLOCK4 |
             TC_CMR_WAVE |         // Waveform mode
             TC_CMR_WAVSEL_UP_RC); // Counter running up and reset when equals to RC
 
-        chTC->TC_CHANNEL[chNo].TC_IER = TC_IER_CPCS;  // RC compare interrupt
-        chTC->TC_CHANNEL[chNo].TC_IDR = ~TC_IER_CPCS;
+        TONE_TIMER->TC_CHANNEL[TONE_CHNL].TC_IER = TC_IER_CPCS;  // RC compare interrupt
+        TONE_TIMER->TC_CHANNEL[TONE_CHNL].TC_IDR = ~TC_IER_CPCS;
         NVIC_EnableIRQ(TONE_IRQ);
-        TCChanEnabled = 1;
+
+        pinMode(BUZZER, OUTPUT);
+
+        g_timerConfigured = true;
     }
-    if (!pinEnabled[ulPin]) {
-        pinMode(ulPin, OUTPUT);
-        pinEnabled[ulPin] = 1;
+
+    Tone tone;
+    if (dequeue(tone)) {
+        g_playing = true;
+        setTone(tone);
+        TC_Start(TONE_TIMER, TONE_CHNL);
     }
-    TC_Stop(chTC, chNo);
-    TC_SetRC(chTC, chNo, rc);    // set frequency
-    TC_Start(chTC, chNo);
 }
 
-void noTone(uint32_t ulPin)
-{
-    TC_Stop(chTC, chNo);  // stop timer
-    digitalWrite(ulPin, LOW);  // no signal on pin
+/// Called from the timer interrupt. RC is changed only here, just after
+/// the counter is reset, so the next tone starts without the glitch.
+static void onTimer() {
+    if (g_toggleCount > 0) {
+        if (!g_silent) {
+            digitalWrite(BUZZER, g_pinState = !g_pinState);
+        }
+        --g_toggleCount;
+    } else {
+        Tone tone;
+        if (dequeue(tone)) {
+            setTone(tone);
+        } else {
+            stop();
+        }
+    }
 }
 
-// timer ISR  TC1 ch 0
-void TC3_Handler(void) {
-    TC_GetStatus(TC1, 0);
-    if (toggle_count != 0) {
-        // toggle pin  TODO  better
-        digitalWrite(tone_pin, pin_state = !pin_state);
-        if (toggle_count > 0) toggle_count--;
+void tick(unsigned long tick_usec) {
+    // tone could be queued just when the timer interrupt stopped the playing
+    if (!g_playing && g_head != g_tail) {
+        start();
+    }
+}
+
+#else
+
+static unsigned long g_toneStart;
+static unsigned long g_toneDuration;
+
+void tick(unsigned long tick_usec) {
+    if (g_playing && tick_usec - g_toneStart < g_toneDuration) {
+        return;
     }
-    else {
-        noTone(tone_pin);
+
+    Tone tone;
+    if (dequeue(tone)) {
+        if (tone.frequency) {
+            ::tone(BUZZER, tone.frequency, tone.duration);
+        }
+        g_toneStart = tick_usec;
+        g_toneDuration = tone.duration * 1000UL;
+        g_playing = true;
+    } else {
+        g_playing = false;
     }
 }
+
 #endif
 
-namespace eez {
-namespace psu {
-namespace buzzer {
+bool enqueue(uint16_t frequency, uint16_t duration) {
+    uint8_t tail = (g_tail + 1) % BUZZER_QUEUE_SIZE;
+    if (tail == g_head) {
+        return false;
+    }
 
-void tone(uint32_t frequency, int32_t duration) {
-    ::tone(BUZZER, frequency, duration);
+    g_queue[g_tail].frequency = frequency;
+    g_queue[g_tail].duration = duration;
+    g_tail = tail;
+
+#if defined (_VARIANT_ARDUINO_DUE_X_)
+    if (!g_playing) {
+        start();
+    }
+#endif
+
+    return true;
+}
+
+int getFreeQueueSize() {
+    return BUZZER_QUEUE_SIZE - 1 - (g_tail - g_head + BUZZER_QUEUE_SIZE) % BUZZER_QUEUE_SIZE;
+}
+
+void clear() {
+    noInterrupts();
+#if defined (_VARIANT_ARDUINO_DUE_X_)
+    if (g_playing) {
+        stop();
+    }
+#else
+    g_playing = false;
+#endif
+    g_head = g_tail;
+    interrupts();
+}
+
+bool isPlaying() {
+    return g_playing || g_head != g_tail;
 }
 
 }
 }
-} // namespace eez::psu::buzzer
\ No newline at end of file
+} // namespace eez::psu::buzzer
+
+#if defined (_VARIANT_ARDUINO_DUE_X_)
+// timer ISR  TC1 ch 0
+void TC3_Handler(void) {
+    TC_GetStatus(TONE_TIMER, TONE_CHNL);
+    eez::psu::buzzer::onTimer();
+}
+#endif
@@ -20,9 +20,26 @@
 
 namespace eez {
 namespace psu {
+/// Tone sequencer. Queued tones are played one after another
+/// by the timer interrupt on Arduino Due, or from the tick elsewhere.
 namespace buzzer {
 
-void tone(uint32_t frequency, int32_t duration);
+void tick(unsigned long tick_usec);
+
+/// Queue the tone. Frequency 0 is the pause.
+/// @param frequency in hertz
+/// @param duration in milliseconds
+/// @return false if queue is full
+bool enqueue(uint16_t frequency, uint16_t duration);
+
+/// Number of free places in the queue.
+int getFreeQueueSize();
+
+/// Stop the current tone and remove all the queued tones.
+void clear();
+
+/// True if tone is playing or waiting in the queue.
+bool isPlaying();
 
 }
 }
@@ -217,7 +217,8 @@ void setRemark(const char *value, size_t len) {
 }
 
 static bool checkCalibrationValue(calibration::Value &calibrationValue, int16_t &scpiErr) {
-    if (calibrationValue.min_val >= calibrationValue.max_val) {
+    // protection thresholds in ADC counts need monotonic calibration
+    if (calibrationValue.min_val >= calibrationValue.max_val || calibrationValue.min_adc >= calibrationValue.max_adc) {
         scpiErr = SCPI_ERROR_INVALID_CAL_DATA;
         return false;
     }
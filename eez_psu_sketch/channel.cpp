@@ -34,6 +34,9 @@
 #include "sound.h"
 #include "profile.h"
 #include "event_queue.h"
+#include "list.h"
+#include "ramp.h"
+#include "power_fail.h"
 
 namespace eez {
 namespace psu {
@@ -281,6 +284,11 @@ Channel::Channel(
 }
 
 void Channel::protectionEnter(ProtectionValue &cpv) {
+    prot_latency.last = micros() - ioexp.getAdcReadTime();
+    if (prot_latency.last > prot_latency.max) {
+        prot_latency.max = prot_latency.last;
+    }
+
     outputEnable(false);
 
     cpv.flags.tripped = 1;
@@ -301,35 +309,77 @@ void Channel::protectionEnter(ProtectionValue &cpv) {
 	event_queue::pushEvent(eventId);
 }
 
+static uint32_t protectionDelayToMicros(float delay) {
+    return delay > 0 ? (uint32_t)(delay * 1000000UL) : 0;
+}
+
+int16_t Channel::getVoltageProtectionThreshold(float u_level) {
+    // Smallest ADC value for which greaterOrEqual(mon, level, CHANNEL_VALUE_PRECISION) is true.
+    u_level -= 0.5f / CHANNEL_VALUE_PRECISION;
+    if (isCalibrationEnabled()) {
+        u_level = util::remap(u_level, cal_conf.u.min.val, cal_conf.u.min.adc, cal_conf.u.max.val, cal_conf.u.max.adc);
+    }
+    float u_adc = ceilf(util::remap(u_level, U_MIN, (float)AnalogDigitalConverter::ADC_MIN, U_MAX, (float)AnalogDigitalConverter::ADC_MAX));
+    return (int16_t)util::clamp(u_adc, (float)(-AnalogDigitalConverter::ADC_MAX - 1), (float)AnalogDigitalConverter::ADC_MAX);
+}
+
+int16_t Channel::getCurrentProtectionThreshold(float i_level) {
+    i_level -= 0.5f / CHANNEL_VALUE_PRECISION;
+    if (isCalibrationEnabled()) {
+        i_level = util::remap(i_level, cal_conf.i.min.val, cal_conf.i.min.adc, cal_conf.i.max.val, cal_conf.i.max.adc);
+    }
+    float i_adc = ceilf(util::remap(i_level, I_MIN, (float)AnalogDigitalConverter::ADC_MIN, I_MAX, (float)AnalogDigitalConverter::ADC_MAX));
+    return (int16_t)util::clamp(i_adc, (float)(-AnalogDigitalConverter::ADC_MAX - 1), (float)AnalogDigitalConverter::ADC_MAX);
+}
+
+void Channel::raiseVoltageProtectionThreshold(int16_t u_adc) {
+    if (u_adc > prot_thresholds.u_adc) {
+        prot_thresholds.u_adc = u_adc;
+    }
+}
+
+void Channel::raiseCurrentProtectionThreshold(int16_t i_adc) {
+    if (i_adc > prot_thresholds.i_adc) {
+        prot_thresholds.i_adc = i_adc;
+    }
+}
+
+void Channel::updateProtectionThresholds() {
+    prot_thresholds.u_adc = getVoltageProtectionThreshold(prot_conf.u_level);
+    prot_thresholds.i_adc = getCurrentProtectionThreshold(i.set);
+
+    prot_thresholds.u_delay = protectionDelayToMicros(prot_conf.u_delay - PROT_DELAY_CORRECTION);
+    prot_thresholds.i_delay = protectionDelayToMicros(prot_conf.i_delay - PROT_DELAY_CORRECTION);
+    prot_thresholds.p_delay = protectionDelayToMicros(prot_conf.p_delay);
+}
+
 void Channel::protectionCheck(ProtectionValue &cpv) {
     bool state;
     bool condition;
-    float delay;
+    uint32_t delay;
     
     if (IS_OVP_VALUE(this, cpv)) {
         state = flags.rprogEnabled || prot_conf.flags.u_state;
 		//condition = flags.cv_mode && (!flags.cc_mode || fabs(i.mon - i.set) >= CHANNEL_VALUE_PRECISION) && (prot_conf.u_level <= u.set);
-		condition = util::greaterOrEqual(u.mon, prot_conf.u_level, CHANNEL_VALUE_PRECISION);
-        delay = prot_conf.u_delay;
-        delay -= PROT_DELAY_CORRECTION;
+		condition = u.mon_adc >= prot_thresholds.u_adc;
+        delay = prot_thresholds.u_delay;
     }
     else if (IS_OCP_VALUE(this, cpv)) {
         state = prot_conf.flags.i_state;
         //condition = flags.cc_mode && (!flags.cv_mode || fabs(u.mon - u.set) >= CHANNEL_VALUE_PRECISION);
-		condition = util::greaterOrEqual(i.mon, i.set, CHANNEL_VALUE_PRECISION);
-        delay = prot_conf.i_delay;
-        delay -= PROT_DELAY_CORRECTION;
+		condition = i.mon_adc >= prot_thresholds.i_adc;
+        delay = prot_thresholds.i_delay;
     }
     else {
         state = prot_conf.flags.p_state;
         condition = u.mon * i.mon > prot_conf.p_level;
-        delay = prot_conf.p_delay;
+        delay = prot_thresholds.p_delay;
     }
 
     if (state && isOutputEnabled() && condition) {
         if (delay > 0) {
             if (cpv.flags.alarmed) {
-                if (micros() - cpv.alarm_started >= delay * 1000000UL) {
+                if (micros() - cpv.alarm_started >= delay) {
                     cpv.flags.alarmed = 0;
 
                     if (IS_OVP_VALUE(this, cpv)) {
@@ -405,6 +455,18 @@ void Channel::onPowerDown() {
 }
 
 void Channel::reset() {
+    // [SOUR[n]]:LIST:STAT OFF
+    // [SOUR[n]]:LIST:VOLT
+    // [SOUR[n]]:LIST:CURR
+    // [SOUR[n]]:LIST:DWEL
+    // [SOUR[n]]:LIST:COUN -> set all to default
+    list::resetChannelList(*this);
+
+    // [SOUR[n]]:VOLT:SLEW MAX
+    // [SOUR[n]]:CURR:SLEW MAX
+    // OUTP:DEL:ON 0
+    ramp::resetChannel(*this);
+
     flags.outputEnabled = 0;
     flags.dpOn = 0;
     flags.senseEnabled = 0;
@@ -463,6 +525,11 @@ void Channel::reset() {
 
 	maxCurrentLimitCause = MAX_CURRENT_LIMIT_CAUSE_NONE;
 	p_limit = PTOT;
+
+    // SENSe#:ADC:RATE
+    // SENSe#:AVERage:COUNt
+    // SENSe#:READback:RATio -> set all to default
+    adc.resetPlan();
 }
 
 void Channel::clearCalibrationConf() {
@@ -495,6 +562,8 @@ void Channel::clearProtectionConf() {
     prot_conf.i_delay = OCP_DEFAULT_DELAY;
     prot_conf.p_delay = OPP_DEFAULT_DELAY;
     prot_conf.p_level = OPP_DEFAULT_LEVEL;
+
+    updateProtectionThresholds();
 }
 
 bool Channel::test() {
@@ -593,6 +662,11 @@ extern int16_t debug::i_mon_dac[CH_MAX];
 #endif
 
 void Channel::adcDataIsReady(int16_t data) {
+    if (!adc.addSample(data)) {
+        adc.next();
+        return;
+    }
+
     switch (adc.start_reg0) {
 
     case AnalogDigitalConverter::ADC_REG0_READ_U_MON:
@@ -632,7 +706,7 @@ void Channel::adcDataIsReady(int16_t data) {
 		}
 
 		if (isOutputEnabled()) {
-			if (isRemoteProgrammingEnabled()) {
+			if (isRemoteProgrammingEnabled() || adc.isReadbackDue()) {
 				adc.start(AnalogDigitalConverter::ADC_REG0_READ_U_SET);
 			}
 			else {
@@ -646,6 +720,8 @@ void Channel::adcDataIsReady(int16_t data) {
 			i.mon = 0;
 			adc.start(AnalogDigitalConverter::ADC_REG0_READ_U_SET);
 		}
+
+		mon_time = micros();
 	}
 	break;
 
@@ -758,17 +834,17 @@ void Channel::event(uint8_t gpio, int16_t adc_data) {
 
 void Channel::adcReadMonDac() {
     adc.start(AnalogDigitalConverter::ADC_REG0_READ_U_SET);
-    delay(ADC_TIMEOUT_MS * 2);
+    spi_queue::delay(ADC_TIMEOUT_MS * 2 * adc.plan.oversampling);
 }
 
 void Channel::adcReadAll() {
     if (isOutputEnabled()) {
         adc.start(AnalogDigitalConverter::ADC_REG0_READ_U_SET);
-        delay(ADC_TIMEOUT_MS * 3);
+        spi_queue::delay(ADC_TIMEOUT_MS * 3 * adc.plan.oversampling);
     }
     else {
         adc.start(AnalogDigitalConverter::ADC_REG0_READ_U_MON);
-        delay(ADC_TIMEOUT_MS * 4);
+        spi_queue::delay(ADC_TIMEOUT_MS * 4 * adc.plan.oversampling);
     }
 }
 
@@ -854,6 +930,7 @@ void Channel::doRemoteProgrammingEnable(bool enable) {
         setVoltage(u.min);
         prot_conf.u_level = u.max;
 		prot_conf.flags.u_state = true;
+        updateProtectionThresholds();
     }
     ioexp.changeBit(ioexp.IO_BIT_OUT_EXT_PROG, enable);
     bp::switchProg(this, enable);
@@ -934,6 +1011,11 @@ void Channel::update() {
 
 void Channel::outputEnable(bool enable) {
     if (enable != flags.outputEnabled) {
+        if (enable) {
+            ramp::onOutputEnable(*this);
+        } else {
+            ramp::stop(*this);
+        }
         doOutputEnable(enable);
 		event_queue::pushEvent((enable ? event_queue::EVENT_INFO_CH1_OUTPUT_ENABLED :
 			event_queue::EVENT_INFO_CH1_OUTPUT_DISABLED) + index - 1);
@@ -978,6 +1060,8 @@ void Channel::doCalibrationEnable(bool enable) {
 
 	u.def = u.min;
 	i.def = i.min;
+
+	updateProtectionThresholds();
 }
 
 void Channel::calibrationEnable(bool enable) {
@@ -1013,17 +1097,21 @@ void Channel::calibrationFindVoltageRange(float minDac, float minVal, float minA
 	cal_conf.u.max.val = maxVal;
     cal_conf.u.max.adc = maxAdc;
 
+	updateProtectionThresholds();
+
 	setVoltage(U_MIN);
-	delay(100); 
+	spi_queue::delay(100); 
 	*min = u.mon;
 
 	setVoltage(U_MAX);
-	delay(200); // guard time, because without load it will require more than 15ms to jump to the max
+	spi_queue::delay(200); // guard time, because without load it will require more than 15ms to jump to the max
 	*max = u.mon;
 
 	cal_conf.u = calValueConf;
 
 	flags._calEnabled = false;
+
+	updateProtectionThresholds();
 }
 
 void Channel::calibrationFindCurrentRange(float minDac, float minVal, float minAdc, float maxDac, float maxVal, float maxAdc, float *min, float *max) {
@@ -1039,18 +1127,22 @@ void Channel::calibrationFindCurrentRange(float minDac, float minVal, float minA
 	cal_conf.i.max.val = maxVal;
     cal_conf.i.max.adc = maxAdc;
 
+	updateProtectionThresholds();
+
 	//setCurrent(I_MIN);
 	//delay(20);
 	//*min = i.mon;
 	*min = 0;
 
 	setCurrent(I_MAX);
-	delay(20);
+	spi_queue::delay(20);
 	*max = i.mon;
 
 	cal_conf.i = calValueConf;
 
 	flags._calEnabled = false;
+
+	updateProtectionThresholds();
 }
 
 void Channel::remoteSensingEnable(bool enable) {
@@ -1104,13 +1196,27 @@ bool Channel::isLowRippleAutoEnabled() {
 }
 
 void Channel::setVoltage(float value) {
+    float previous = u.set;
+    updateVoltageLevel(value);
+
+    if (!ramp::startVoltage(*this, previous, value)) {
+        dac.set_voltage_code(getVoltageDacCode(value));
+    }
+
+    profile::save();
+}
+
+void Channel::updateVoltageLevel(float value) {
     u.set = value;
     u.mon_dac = 0;
 
     if (prot_conf.u_level < u.set) {
         prot_conf.u_level = u.set;
+        updateProtectionThresholds();
     }
+}
 
+uint16_t Channel::getVoltageDacCode(float value) {
     if (U_MAX != U_MAX_CONF) {
 		value = util::remap(value, 0, 0, U_MAX_CONF, U_MAX);
 	}
@@ -1118,27 +1224,44 @@ void Channel::setVoltage(float value) {
     if (isCalibrationEnabled()) {
         value = util::remap(value, cal_conf.u.min.val, cal_conf.u.min.dac, cal_conf.u.max.val, cal_conf.u.max.dac);
     }
-    dac.set_voltage(value);
 
-    profile::save();
+    return dac.voltageToCode(value);
 }
 
 void Channel::setCurrent(float value) {
+    float previous = i.set;
+    updateCurrentLevel(value);
+
+    if (!ramp::startCurrent(*this, previous, value)) {
+        dac.set_current_code(getCurrentDacCode(value));
+    }
+
+    profile::save();
+}
+
+void Channel::updateCurrentLevel(float value) {
     i.set = value;
     i.mon_dac = 0;
 
+    updateProtectionThresholds();
+}
+
+uint16_t Channel::getCurrentDacCode(float value) {
     if (isCalibrationEnabled()) {
         value = util::remap(value, cal_conf.i.min.val, cal_conf.i.min.dac, cal_conf.i.max.val, cal_conf.i.max.dac);
     }
-    dac.set_current(value);
 
-    profile::save();
+    return dac.currentToCode(value);
 }
 
 bool Channel::isCalibrationExists() {
     return cal_conf.flags.i_cal_params_exists && cal_conf.flags.u_cal_params_exists;
 }
 
+bool Channel::isCalibrationValueMonotonic(const CalibrationValueConfiguration &value) {
+    return value.min.val < value.max.val && value.min.adc < value.max.adc;
+}
+
 bool Channel::isTripped() {
     return ovp.flags.tripped ||
         ocp.flags.tripped ||
@@ -1172,21 +1295,11 @@ void Channel::disableProtection() {
 }
 
 void Channel::setQuesBits(int bit_mask, bool on) {
-    reg_set_ques_isum_bit(&serial::scpi_context, this, bit_mask, on);
-#if OPTION_ETHERNET
-	if (ethernet::test_result == psu::TEST_OK) {
-        reg_set_ques_isum_bit(&ethernet::scpi_context, this, bit_mask, on);
-	}
-#endif
+    reg_set_ques_isum_bit(this, bit_mask, on);
 }
 
 void Channel::setOperBits(int bit_mask, bool on) {
-    reg_set_oper_isum_bit(&serial::scpi_context, this, bit_mask, on);
-#if OPTION_ETHERNET
-	if (ethernet::test_result == psu::TEST_OK) {
-        reg_set_oper_isum_bit(&ethernet::scpi_context, this, bit_mask, on);
-	}
-#endif
+    reg_set_oper_isum_bit(this, bit_mask, on);
 }
 
 char *Channel::getCvModeStr() {
@@ -1291,8 +1404,9 @@ void Channel::testPwrgood(uint8_t gpio) {
     if (!(gpio & (1 << IOExpander::IO_BIT_IN_PWRGOOD))) {
         DebugTraceF("Ch%d PWRGOOD bit changed to 0", index);
         flags.powerOk = 0;
-        psu::generateError(SCPI_ERROR_CH1_FAULT_DETECTED - (index - 1));
-        psu::powerDownBySensor();
+        // this could be the mains failure, outputs are switched off at once,
+        // the critical state is saved and PSU powered down from the main loop
+        power_fail::onPowerFail(SCPI_ERROR_CH1_FAULT_DETECTED - (index - 1));
         return;
     }
 }
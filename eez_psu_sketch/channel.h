@@ -181,6 +181,25 @@ public:
         uint32_t alarm_started;
     };
 
+    /// Protection settings precomputed for the protection check,
+    /// updated with updateProtectionThresholds().
+    struct ProtectionThresholds {
+        /// OVP condition is u.mon_adc >= u_adc
+        int16_t u_adc;
+        /// OCP condition is i.mon_adc >= i_adc
+        int16_t i_adc;
+        /// delays in microseconds
+        uint32_t u_delay;
+        uint32_t i_delay;
+        uint32_t p_delay;
+    };
+
+    /// Time (in microseconds) from reading the ADC sample to the protection trip decision.
+    struct ProtectionLatency {
+        uint32_t last;
+        uint32_t max;
+    };
+
 #ifdef EEZ_PSU_SIMULATOR
     /// Per channel simulator data
     struct Simulator {
@@ -297,6 +316,9 @@ public:
 
 	float p_limit;
 
+    /// Time, in microseconds, when u.mon and i.mon were last updated from the same ADC cycle.
+    uint32_t mon_time;
+
     CalibrationConfiguration cal_conf;
     ChannelProtectionConfiguration prot_conf;
 
@@ -304,6 +326,9 @@ public:
     ProtectionValue ocp;
     ProtectionValue opp;
 
+    ProtectionThresholds prot_thresholds;
+    ProtectionLatency prot_latency;
+
 	ontime::Counter onTimeCounter;
 
 #ifdef EEZ_PSU_SIMULATOR
@@ -417,9 +442,27 @@ public:
     /// Set channel current level
     void setCurrent(float current);
 
+    /// Update channel state for the voltage level which is already written
+    /// to the DAC outside of setVoltage (by the LIST sequencer or the trigger).
+    void updateVoltageLevel(float voltage);
+
+    /// Same as updateVoltageLevel, but for the current level.
+    void updateCurrentLevel(float current);
+
+    /// DAC code for the voltage level, with U_MAX_CONF and calibration remap applied.
+    uint16_t getVoltageDacCode(float voltage);
+
+    /// DAC code for the current level, with calibration remap applied.
+    uint16_t getCurrentDacCode(float current);
+
     /// Is channel calibrated, both voltage and current?
     bool isCalibrationExists();
 
+    /// Do both real and ADC values increase from the min to the max calibration point?
+    /// Protection thresholds are precomputed in ADC counts (see updateProtectionThresholds),
+    /// which is correct only if they do.
+    static bool isCalibrationValueMonotonic(const CalibrationValueConfiguration &value);
+
     /// Is OVP, OCP or OPP tripped?
     bool isTripped();
 
@@ -430,9 +473,11 @@ public:
     void disableProtection();
 
 	/// Turn on/off bit in SCPI Questinable Instrument Isummary register for this channel.
+    /// Registers are updated in the next psu::tick, so it is safe to call from the interrupt handler.
     void setQuesBits(int bit_mask, bool on);
 
     /// Turn on/off bit in SCPI Operational Instrument Isummary register for this channel.
+    /// Registers are updated in the next psu::tick, so it is safe to call from the interrupt handler.
     void setOperBits(int bit_mask, bool on);
 
     /// Is channel in CV (constant voltage) mode?
@@ -456,6 +501,23 @@ public:
     /// Remap current value to ADC data value (use calibration if configured).
     int16_t remapCurrentToAdcData(float value);
 
+    /// Recompute prot_thresholds, must be called after any change of
+    /// protection configuration, I_SET or calibration.
+    void updateProtectionThresholds();
+
+    /// OVP threshold (see ProtectionThresholds::u_adc) for the OVP level.
+    int16_t getVoltageProtectionThreshold(float u_level);
+    /// OCP threshold (see ProtectionThresholds::i_adc) for the I_SET.
+    int16_t getCurrentProtectionThreshold(float i_set);
+
+    /// Raise the OVP threshold, if lower, to the threshold precomputed for the level
+    /// which is about to be written to the DAC from the interrupt handler (trigger).
+    /// Exact thresholds are set once the channel state is updated in the main loop.
+    /// Can be called from the interrupt handler.
+    void raiseVoltageProtectionThreshold(int16_t u_adc);
+    /// Same as raiseVoltageProtectionThreshold, but for the OCP threshold (LIST step or trigger).
+    void raiseCurrentProtectionThreshold(int16_t i_adc);
+
     /// Returns name of the board revison of this channel.
     const char *getBoardRevisionName();
 
@@ -61,6 +61,12 @@
 #endif
 #define ADC_SPS_TIME_CRITICAL 0 // used when time/performance critical operation is running
 
+/// Max. number of ADC conversions averaged into the single measured value.
+#define ADC_MAX_OVERSAMPLING 16
+
+/// Max. number of U_MON/I_MON cycles between two U_SET/I_SET readbacks.
+#define ADC_MAX_READBACK_RATIO 255
+
 /// Duration, in milliseconds, from the last ADC interrupt
 /// after which ADC timeout condition is declared.  
 #define ADC_TIMEOUT_MS 60
@@ -68,6 +74,9 @@
 /// Maximum number of attempts to recover from ADC timeout before giving up.
 #define MAX_ADC_TIMEOUT_RECOVERY_ATTEMPTS 3
 
+/// Max. time, in milliseconds, MEASure:ALL? waits for the new U_MON/I_MON samples.
+#define MEAS_TIMEOUT_MS 500
+
 /// Password minimum length in number characters.
 #define PASSWORD_MIN_LENGTH 4
 
@@ -137,8 +146,13 @@
 /// Maximum OTP level
 #define OTP_MAIN_MAX_LEVEL     100.0f
 
-/// Number of profile storage locations
+/// Number of profile storage locations, at most 50 fit in EEPROM.
+/// GUI shows only the first 10 locations.
+#ifdef EEZ_PSU_ARDUINO_MEGA
 #define NUM_PROFILE_LOCATIONS 10
+#else
+#define NUM_PROFILE_LOCATIONS 50
+#endif
 
 /// Profile name maximum length in number of characters.
 #define PROFILE_NAME_MAX_LENGTH 32
@@ -220,7 +234,8 @@
 #define WATCHDOG_INTERVAL 1000
 
 /// Interval (in minutes) at which "on time" will be written to EEPROM
-#define WRITE_ONTIME_INTERVAL 10
+/// Counters are also written on power down and on power failure (see power_fail.h).
+#define WRITE_ONTIME_INTERVAL 60
 
 /// Maximum allowed length (including label) of the keypad text.
 #define MAX_KEYPAD_TEXT_LENGTH 128
@@ -236,4 +251,87 @@
 
 /// How much to wait (in seconds) for a lease for an IP address from a DHCP server
 /// until we declare ethernet initialization failure.
-#define ETHERNET_DHCP_TIMEOUT 15
\ No newline at end of file
+#define ETHERNET_DHCP_TIMEOUT 15
+
+/// UDP port from which telemetry datagrams are sent.
+#define TELEMETRY_LOCAL_PORT 5026
+
+/// Default UDP port of the telemetry collector.
+#define TELEMETRY_DEFAULT_PORT 5026
+
+/// Default interval (in milliseconds) between two telemetry datagrams.
+#define TELEMETRY_DEFAULT_INTERVAL 1000
+
+/// Min. interval (in milliseconds) between two telemetry datagrams.
+#define TELEMETRY_MIN_INTERVAL 10
+
+/// Max. interval (in milliseconds) between two telemetry datagrams.
+#define TELEMETRY_MAX_INTERVAL 60000
+
+/// Max. number of bytes in the single SPI transaction from the interrupt handler.
+#define SPI_QUEUE_MAX_TRANSFER 4
+
+/// Number of transactions from the interrupt handlers that can wait
+/// for the bus to be released by the main loop.
+#define SPI_QUEUE_DEFERRED_SIZE 5
+
+/// Max. number of entries in the voltage, current and dwell LIST of the single channel.
+#ifdef EEZ_PSU_ARDUINO_MEGA
+#define LIST_MAX_LENGTH 4
+#else
+#define LIST_MAX_LENGTH 100
+#endif
+
+/// Period, in microseconds, of the timer interrupt which executes LIST steps.
+/// It is the resolution of the LIST dwell time.
+#define LIST_TIMER_PERIOD 100
+
+/// Min. LIST dwell time in seconds.
+#define LIST_MIN_DWELL 0.001f
+
+/// Max. LIST dwell time in seconds.
+#define LIST_MAX_DWELL 3600.0f
+
+/// Default LIST dwell time in seconds.
+#define LIST_DEF_DWELL 0.01f
+
+/// Period, in microseconds, of the timer interrupt which feeds
+/// intermediate DAC codes during the voltage and current ramp.
+#define RAMP_TIMER_PERIOD 1000
+
+/// Min. voltage slew rate in V/s.
+#define U_SLEW_MIN 0.01f
+
+/// Max. voltage slew rate in V/s, this and greater value means that
+/// the voltage is changed immediately (no ramp).
+#define U_SLEW_MAX 10000.0f
+
+/// Min. current slew rate in A/s.
+#define I_SLEW_MIN 0.001f
+
+/// Max. current slew rate in A/s, this and greater value means that
+/// the current is changed immediately (no ramp).
+#define I_SLEW_MAX 1000.0f
+
+/// Max. soft-start duration (OUTP:DEL:ON) in seconds.
+#define SOFT_START_MAX_DELAY 60.0f
+
+/// Default trigger delay in seconds.
+#define TRIGGER_DEF_DELAY 0.0f
+
+/// Max. trigger delay in seconds.
+#define TRIGGER_MAX_DELAY 3600.0f
+
+/// Max. number of tones (notes and pauses) waiting in the buzzer queue.
+#define BUZZER_QUEUE_SIZE 8
+
+/// Time, in milliseconds, after the last occurrence of the error
+/// during which the same error doesn't play beep again.
+#define SOUND_ERROR_BURST_TIME 1000
+
+/// Max. number of the not yet written events stored on power failure.
+#define POWER_FAIL_MAX_EVENTS 4
+
+/// Max. time, in microseconds, spent in the steps of the long operation
+/// (see long_operation.h) per main loop iteration.
+#define LONG_OPERATION_TICK_TIME 2000
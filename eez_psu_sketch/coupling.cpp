@@ -0,0 +1,288 @@
+/*
+ * EEZ PSU Firmware
+ * Copyright (C) 2015-present, Envox d.o.o.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+ 
+#include "psu.h"
+#include "coupling.h"
+#include "calibration.h"
+#include "list.h"
+#include "trigger.h"
+#include "scpi_regs.h"
+
+namespace eez {
+namespace psu {
+namespace coupling {
+
+static Type g_type = TYPE_NONE;
+
+static Channel &master() {
+    return Channel::get(0);
+}
+
+static Channel &slave() {
+    return Channel::get(1);
+}
+
+static bool isPair() {
+    return g_type == TYPE_PARALLEL || g_type == TYPE_SERIES;
+}
+
+static bool haveSameRatings(Channel &channel1, Channel &channel2) {
+    return channel1.U_CAL_VAL_MAX == channel2.U_CAL_VAL_MAX &&
+        channel1.I_CAL_VAL_MAX == channel2.I_CAL_VAL_MAX &&
+        channel1.PTOT == channel2.PTOT;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void tick(unsigned long tick_usec) {
+    if (!isPair()) {
+        return;
+    }
+
+    // If one channel of the pair is turned off (protection trip, temperature, fault),
+    // the other channel must not continue to drive the load alone.
+    if (master().isOutputEnabled() != slave().isOutputEnabled()) {
+        DebugTrace("Channels pair output state mismatch, turning off both outputs");
+        master().outputEnable(false);
+        slave().outputEnable(false);
+    }
+}
+
+void reset() {
+    int16_t err;
+    setType(TYPE_NONE, err);
+}
+
+bool setType(Type type, int16_t &err) {
+    if (type == g_type) {
+        return true;
+    }
+
+    if (type != TYPE_NONE) {
+        if (CH_NUM < 2) {
+            err = SCPI_ERROR_EXECUTION_ERROR;
+            return false;
+        }
+
+        if (!master().isOk() || !slave().isOk()) {
+            err = SCPI_ERROR_HARDWARE_ERROR;
+            return false;
+        }
+
+        if (!haveSameRatings(master(), slave())) {
+            err = SCPI_ERROR_SETTINGS_CONFLICT;
+            return false;
+        }
+
+        if (calibration::isEnabled()) {
+            err = SCPI_ERROR_BAD_SEQUENCE_OF_CALIBRATION_COMMANDS;
+            return false;
+        }
+
+        if (master().isRemoteProgrammingEnabled() || slave().isRemoteProgrammingEnabled() ||
+            list::isRunning(master()) || list::isRunning(slave())) {
+            err = SCPI_ERROR_SETTINGS_CONFLICT;
+            return false;
+        }
+    }
+
+    // outputs are always turned off when channels are joined or separated
+    if (isPair() || type == TYPE_PARALLEL || type == TYPE_SERIES) {
+        master().outputEnable(false);
+        slave().outputEnable(false);
+    }
+
+    trigger::abort();
+
+    g_type = type;
+
+    psu::setOperBits(OPER_GROUP_PARALLEL, g_type == TYPE_PARALLEL);
+    psu::setOperBits(OPER_GROUP_SERIAL, g_type == TYPE_SERIES);
+
+    if (g_type != TYPE_NONE) {
+        // CH2 takes over CH1 configuration,
+        // CH1 setpoints become setpoints of the combined output
+        slave().setVoltageLimit(master().u.limit);
+        slave().setCurrentLimit(master().i.limit);
+        slave().setPowerLimit(master().p_limit);
+
+        slave().prot_conf = master().prot_conf;
+        slave().updateProtectionThresholds();
+
+        float u = master().u.set;
+        float i = master().i.set;
+        setVoltage(master(), u);
+        setCurrent(master(), i);
+    }
+
+    return true;
+}
+
+Type getType() {
+    return g_type;
+}
+
+bool isMaster(const Channel &channel) {
+    return g_type != TYPE_NONE && channel.index == 1;
+}
+
+bool isSlave(const Channel &channel) {
+    return isPair() && channel.index == 2;
+}
+
+float getVoltageFactor(const Channel &channel) {
+    return g_type == TYPE_SERIES && channel.index == 1 ? 2.0f : 1.0f;
+}
+
+float getCurrentFactor(const Channel &channel) {
+    return g_type == TYPE_PARALLEL && channel.index == 1 ? 2.0f : 1.0f;
+}
+
+float getPowerFactor(const Channel &channel) {
+    return isPair() && channel.index == 1 ? 2.0f : 1.0f;
+}
+
+float getVoltageMon(Channel &channel) {
+    if (g_type == TYPE_SERIES && channel.index == 1) {
+        return master().u.mon + slave().u.mon;
+    }
+    return channel.u.mon;
+}
+
+float getCurrentMon(Channel &channel) {
+    if (g_type == TYPE_PARALLEL && channel.index == 1) {
+        return master().i.mon + slave().i.mon;
+    }
+    return channel.i.mon;
+}
+
+float getVoltageMonDac(Channel &channel) {
+    if (g_type == TYPE_SERIES && channel.index == 1) {
+        return master().u.mon_dac + slave().u.mon_dac;
+    }
+    return channel.u.mon_dac;
+}
+
+float getCurrentMonDac(Channel &channel) {
+    if (g_type == TYPE_PARALLEL && channel.index == 1) {
+        return master().i.mon_dac + slave().i.mon_dac;
+    }
+    return channel.i.mon_dac;
+}
+
+void setVoltage(Channel &channel, float value) {
+    if (g_type == TYPE_NONE) {
+        channel.setVoltage(value);
+        return;
+    }
+
+    value /= getVoltageFactor(master());
+
+    master().setVoltage(value);
+    slave().setVoltage(value);
+}
+
+void setCurrent(Channel &channel, float value) {
+    if (g_type == TYPE_NONE) {
+        channel.setCurrent(value);
+        return;
+    }
+
+    value /= getCurrentFactor(master());
+
+    master().setCurrent(value);
+    slave().setCurrent(value);
+}
+
+void setVoltageLimit(Channel &channel, float limit) {
+    if (g_type == TYPE_NONE) {
+        channel.setVoltageLimit(limit);
+        return;
+    }
+
+    limit /= getVoltageFactor(master());
+
+    master().setVoltageLimit(limit);
+    slave().setVoltageLimit(limit);
+}
+
+void setCurrentLimit(Channel &channel, float limit) {
+    if (g_type == TYPE_NONE) {
+        channel.setCurrentLimit(limit);
+        return;
+    }
+
+    limit /= getCurrentFactor(master());
+
+    master().setCurrentLimit(limit);
+    slave().setCurrentLimit(limit);
+}
+
+void setPowerLimit(Channel &channel, float limit) {
+    if (g_type == TYPE_NONE) {
+        channel.setPowerLimit(limit);
+        return;
+    }
+
+    limit /= getPowerFactor(master());
+
+    master().setPowerLimit(limit);
+    slave().setPowerLimit(limit);
+}
+
+void outputEnable(Channel &channel, bool enable) {
+    if (!isPair()) {
+        channel.outputEnable(enable);
+        return;
+    }
+
+    master().outputEnable(enable);
+    slave().outputEnable(enable);
+}
+
+bool isTripped(Channel &channel) {
+    if (!isPair()) {
+        return channel.isTripped();
+    }
+
+    return master().isTripped() || slave().isTripped();
+}
+
+void clearProtection(Channel &channel) {
+    if (!isPair()) {
+        channel.clearProtection();
+        return;
+    }
+
+    master().clearProtection();
+    slave().clearProtection();
+}
+
+void updateProtection(Channel &channel) {
+    if (g_type == TYPE_NONE) {
+        return;
+    }
+
+    Channel &other = channel.index == 1 ? slave() : master();
+    other.prot_conf = channel.prot_conf;
+    other.updateProtectionThresholds();
+}
+
+}
+}
+} // namespace eez::psu::coupling
@@ -0,0 +1,98 @@
+/*
+ * EEZ PSU Firmware
+ * Copyright (C) 2015-present, Envox d.o.o.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+ 
+#pragma once
+
+namespace eez {
+namespace psu {
+/// Channel coupling (INST:COUP:TRAC and OUTP:PAIR).
+///
+/// In tracking mode CH2 mirrors the setpoints, limits and protection configuration
+/// of CH1, while outputs can still be enabled independently. In parallel and series
+/// mode the two channels act as one output, addressed through CH1: current (parallel)
+/// or voltage (series) is split between the channels and measured values are summed.
+/// All the combined settings go through this module, so both DACs are updated from
+/// the same call, i.e. within the same loop iteration.
+namespace coupling {
+
+enum Type {
+    TYPE_NONE,
+    TYPE_TRACKED,
+    TYPE_PARALLEL,
+    TYPE_SERIES
+};
+
+void tick(unsigned long tick_usec);
+
+/// Restore *RST default, i.e. uncouple the channels.
+void reset();
+
+/// Change coupling type.
+/// Returns false and SCPI error code in err if channels can't be coupled.
+bool setType(Type type, int16_t &err);
+Type getType();
+
+/// Is this channel the CH1 of the channels pair (or tracked channels)?
+bool isMaster(const Channel &channel);
+
+/// Is this channel CH2 of the parallel or series pair?
+/// Such channel is not accessible on its own until the channels are uncoupled.
+bool isSlave(const Channel &channel);
+
+/// Combined output voltage / per channel voltage (2 for series pair, otherwise 1).
+float getVoltageFactor(const Channel &channel);
+
+/// Combined output current / per channel current (2 for parallel pair, otherwise 1).
+float getCurrentFactor(const Channel &channel);
+
+/// Combined output power / per channel power.
+float getPowerFactor(const Channel &channel);
+
+/// Measured voltage of the combined output.
+float getVoltageMon(Channel &channel);
+
+/// Measured current of the combined output.
+float getCurrentMon(Channel &channel);
+
+/// Voltage measured on the DAC side of the combined output.
+float getVoltageMonDac(Channel &channel);
+
+/// Current measured on the DAC side of the combined output.
+float getCurrentMonDac(Channel &channel);
+
+void setVoltage(Channel &channel, float value);
+void setCurrent(Channel &channel, float value);
+
+void setVoltageLimit(Channel &channel, float limit);
+void setCurrentLimit(Channel &channel, float limit);
+void setPowerLimit(Channel &channel, float limit);
+
+void outputEnable(Channel &channel, bool enable);
+
+/// Is any channel of the combined output tripped?
+bool isTripped(Channel &channel);
+
+void clearProtection(Channel &channel);
+
+/// Must be called after protection configuration of the channel is changed,
+/// it copies protection configuration of CH1 to CH2 if channels are coupled.
+void updateProtection(Channel &channel);
+
+}
+}
+} // namespace eez::psu::coupling
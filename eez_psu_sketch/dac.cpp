@@ -43,9 +43,7 @@ DigitalAnalogConverter::DigitalAnalogConverter(Channel &channel_) : channel(chan
     test_result = psu::TEST_SKIPPED;
 }
 
-void DigitalAnalogConverter::set_value(uint8_t buffer, float value) {
-    uint16_t DAC_value = (uint16_t)util::clamp(round(value), DAC_MIN, DAC_MAX);
-
+void DigitalAnalogConverter::set_code(uint8_t buffer, uint16_t DAC_value) {
 #if CONF_DEBUG
     if (buffer == DATA_BUFFER_A) {
         debug::u_dac[channel.index - 1] = DAC_value;
@@ -55,11 +53,12 @@ void DigitalAnalogConverter::set_value(uint8_t buffer, float value) {
     }
 #endif
 
-    SPI.beginTransaction(DAC8552_SPI);
-    digitalWrite(channel.dac_pin, LOW);
-    SPI.transfer(buffer);
-    SPI.transfer(DAC_value >> 8); // send first byte
-    SPI.transfer(DAC_value & 0xFF);  // send second byte
+    uint8_t data[] = {
+        buffer,
+        (uint8_t)(DAC_value >> 8), // first byte
+        (uint8_t)(DAC_value & 0xFF) // second byte
+    };
+    spi_queue::transfer(DAC8552_SPI, channel.dac_pin, spi_queue::NO_PIN, data, sizeof(data));
 
 #if CONF_DEBUG
 	if  (debug::g_set_voltage_or_current_time_start != 0) {
@@ -68,9 +67,6 @@ void DigitalAnalogConverter::set_value(uint8_t buffer, float value) {
 		debug::g_set_voltage_or_current_time_start = 0;
 	}
 #endif
-
-    digitalWrite(channel.dac_pin, HIGH); // Deselect DAC
-    SPI.endTransaction();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -114,7 +110,7 @@ bool DigitalAnalogConverter::test() {
     float i_set_save = channel.i.set;
     channel.setCurrent(i_set);
 
-    delay(200);
+    spi_queue::delay(200);
 
     channel.adcReadMonDac();
 
@@ -170,12 +166,58 @@ bool DigitalAnalogConverter::test() {
 
 ////////////////////////////////////////////////////////////////////////////////
 
+uint16_t DigitalAnalogConverter::voltageToCode(float value) {
+    value = util::remap(value, channel.U_MIN, (float)DAC_MIN, channel.U_MAX, (float)DAC_MAX);
+    return (uint16_t)util::clamp(round(value), DAC_MIN, DAC_MAX);
+}
+
+uint16_t DigitalAnalogConverter::currentToCode(float value) {
+    value = util::remap(value, channel.I_MIN, (float)DAC_MIN, channel.I_MAX, (float)DAC_MAX);
+    return (uint16_t)util::clamp(round(value), DAC_MIN, DAC_MAX);
+}
+
 void DigitalAnalogConverter::set_voltage(float value) {
-    set_value(DATA_BUFFER_A, util::remap(value, channel.U_MIN, (float)DAC_MIN, channel.U_MAX, (float)DAC_MAX));
+    set_code(DATA_BUFFER_A, voltageToCode(value));
 }
 
 void DigitalAnalogConverter::set_current(float value) {
-    set_value(DATA_BUFFER_B, util::remap(value, channel.I_MIN, (float)DAC_MIN, channel.I_MAX, (float)DAC_MAX));
+    set_code(DATA_BUFFER_B, currentToCode(value));
+}
+
+void DigitalAnalogConverter::set_voltage_code(uint16_t code) {
+    set_code(DATA_BUFFER_A, code);
+}
+
+void DigitalAnalogConverter::set_current_code(uint16_t code) {
+    set_code(DATA_BUFFER_B, code);
+}
+
+void DigitalAnalogConverter::set_code_from_interrupt(uint8_t buffer, uint16_t code) {
+    spi_queue::Transaction transaction;
+    transaction.settings = &DAC8552_SPI;
+    transaction.select_pin = channel.dac_pin;
+    transaction.isolator_pin = spi_queue::NO_PIN;
+    transaction.length = 3;
+    transaction.param = 0;
+    transaction.callback = 0;
+
+    transaction.data[0] = buffer;
+    transaction.data[1] = (uint8_t)(code >> 8);
+    transaction.data[2] = (uint8_t)(code & 0xFF);
+    spi_queue::transferFromInterrupt(transaction);
+}
+
+void DigitalAnalogConverter::set_codes_from_interrupt(uint16_t u_code, uint16_t i_code) {
+    set_code_from_interrupt(DATA_BUFFER_A, u_code);
+    set_code_from_interrupt(DATA_BUFFER_B, i_code);
+}
+
+void DigitalAnalogConverter::set_voltage_code_from_interrupt(uint16_t code) {
+    set_code_from_interrupt(DATA_BUFFER_A, code);
+}
+
+void DigitalAnalogConverter::set_current_code_from_interrupt(uint16_t code) {
+    set_code_from_interrupt(DATA_BUFFER_B, code);
 }
 
 }
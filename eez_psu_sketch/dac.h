@@ -40,10 +40,25 @@ public:
     void set_voltage(float voltage);
     void set_current(float voltage);
 
+    /// Convert (already calibrated) value to the DAC code.
+    uint16_t voltageToCode(float value);
+    uint16_t currentToCode(float value);
+
+    void set_voltage_code(uint16_t code);
+    void set_current_code(uint16_t code);
+
+    /// Write both codes from the timer interrupt handler, used by the LIST sequencer.
+    void set_codes_from_interrupt(uint16_t u_code, uint16_t i_code);
+
+    /// Write single code from the timer interrupt handler, used by the ramp generator.
+    void set_voltage_code_from_interrupt(uint16_t code);
+    void set_current_code_from_interrupt(uint16_t code);
+
 private:
     Channel &channel;
 
-    void set_value(uint8_t buffer, float value);
+    void set_code(uint8_t buffer, uint16_t code);
+    void set_code_from_interrupt(uint8_t buffer, uint16_t code);
 };
 
 }
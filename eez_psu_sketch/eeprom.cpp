@@ -18,6 +18,7 @@
  
 #include "psu.h"
 #include "eeprom.h"
+#include "watchdog.h"
 
 namespace eez {
 namespace psu {
@@ -27,61 +28,62 @@ psu::TestResult test_result = psu::TEST_FAILED;
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void send_address(uint16_t address) {
-    SPI.transfer((uint8_t)(address >> 8)); // MSByte
-    SPI.transfer((uint8_t)(address));      // LSByte
+static const uint16_t CHUNK_SIZE = 64; // AT25256B page size
+static const uint16_t HEADER_SIZE = 3;
+
+static uint8_t g_transferBuffer[HEADER_SIZE + CHUNK_SIZE];
+
+void send_command(uint8_t command) {
+    uint8_t buffer[] = { command };
+    spi_queue::transfer(AT25256B_SPI, EEPROM_SELECT, spi_queue::NO_PIN, buffer, sizeof(buffer));
+}
+
+void set_header(uint8_t opcode, uint16_t address) {
+    g_transferBuffer[0] = opcode;
+    g_transferBuffer[1] = (uint8_t)(address >> 8); // MSByte
+    g_transferBuffer[2] = (uint8_t)(address);      // LSByte
 }
 
 void read_chunk(uint8_t *buffer, uint16_t buffer_size, uint16_t address) {
-    SPI.beginTransaction(AT25256B_SPI);
+    // bus is held while g_transferBuffer is in use, so nothing deferred
+    // by the interrupt handler is executed in between
+    spi_queue::holdBus();
 
-    digitalWrite(EEPROM_SELECT, LOW);  // select chip
-    SPI.transfer(READ);                // transmit read opcode
+    set_header(READ, address);
+    memset(g_transferBuffer + HEADER_SIZE, 0xFF, buffer_size);
 
-    send_address(address);
+    spi_queue::transfer(AT25256B_SPI, EEPROM_SELECT, spi_queue::NO_PIN, g_transferBuffer, HEADER_SIZE + buffer_size);
 
-    while (buffer_size--) {
-        *buffer++ = SPI.transfer(0xFF);    // get data byte
-    }
+    memcpy(buffer, g_transferBuffer + HEADER_SIZE, buffer_size);
 
-    digitalWrite(EEPROM_SELECT, HIGH); // release chip, signal end transfer
-
-    SPI.endTransaction();
+    spi_queue::releaseBus();
 }
 
 void read(uint8_t *buffer, uint16_t buffer_size, uint16_t address) {
-    for (uint16_t i = 0; i < buffer_size; i += 64) {
-        read_chunk(buffer + i, min(buffer_size - i, 64), address + i);
+    for (uint16_t i = 0; i < buffer_size; i += CHUNK_SIZE) {
+        read_chunk(buffer + i, min(buffer_size - i, CHUNK_SIZE), address + i);
     }
 }
 
 bool is_write_in_progress() {
-    digitalWrite(EEPROM_SELECT, LOW);
-    SPI.transfer(RDSR); // send RDSR command
-    uint8_t data = SPI.transfer(0xFF); // get data byte
-    digitalWrite(EEPROM_SELECT, HIGH);
-    return (data & (1 << 0));
+    uint8_t buffer[] = { RDSR, 0xFF };
+    spi_queue::transfer(AT25256B_SPI, EEPROM_SELECT, spi_queue::NO_PIN, buffer, sizeof(buffer));
+    return (buffer[1] & (1 << 0));
 }
 
 void write_chunk(const uint8_t *buffer, uint16_t buffer_size, uint16_t address) {
-    SPI.beginTransaction(AT25256B_SPI);
+    // bus is held from WREN until the WRITE is sent (see read_chunk)
+    spi_queue::holdBus();
 
     // enable writing
-    digitalWrite(EEPROM_SELECT, LOW);  // select chip
-    SPI.transfer(WREN);                // send write enable command
-    digitalWrite(EEPROM_SELECT, HIGH); // deselect chip
-
-    digitalWrite(EEPROM_SELECT, LOW);  // select chip
-    SPI.transfer(WRITE);               // send write command
+    send_command(WREN);
 
-    send_address(address);
+    set_header(WRITE, address);
+    memcpy(g_transferBuffer + HEADER_SIZE, buffer, buffer_size);
 
-    // write buffer
-    for (uint16_t i = 0; i < buffer_size; ++i) {
-        SPI.transfer(buffer[i]);
-    }
+    spi_queue::transfer(AT25256B_SPI, EEPROM_SELECT, spi_queue::NO_PIN, g_transferBuffer, HEADER_SIZE + buffer_size);
 
-    digitalWrite(EEPROM_SELECT, HIGH); // release chip
+    spi_queue::releaseBus();
 
     unsigned long s = micros();
     while (is_write_in_progress()) {
@@ -90,22 +92,24 @@ void write_chunk(const uint8_t *buffer, uint16_t buffer_size, uint16_t address)
             DebugTrace("EEPROM write failure!");
             break;
         }
+#if EEZ_PSU_SELECTED_REVISION == EEZ_PSU_REVISION_R3B4
+        watchdog::tick(e);
+#endif
     }
 
     // disable writing
-    digitalWrite(EEPROM_SELECT, LOW);  // select chip
-    SPI.transfer(WRDI);                // send write disable command
-    digitalWrite(EEPROM_SELECT, HIGH); // deselect chip
-
-    SPI.endTransaction();
+    send_command(WRDI);
 }
 
 static uint8_t *buffer_verify;
 static uint16_t buffer_verify_size;
 
 bool write(const uint8_t *buffer, uint16_t buffer_size, uint16_t address) {
-    for (uint16_t i = 0; i < buffer_size; i += 64) {
-        write_chunk(buffer + i, min(buffer_size - i, 64), address + i);
+    // chunk must not cross the page boundary, write would wrap around to the page start
+    for (uint16_t i = 0; i < buffer_size; ) {
+        uint16_t chunk_size = min(buffer_size - i, CHUNK_SIZE - (address + i) % CHUNK_SIZE);
+        write_chunk(buffer + i, chunk_size, address + i);
+        i += chunk_size;
     }
 
 	if (!buffer_verify || buffer_size > buffer_verify_size) {
@@ -130,12 +134,8 @@ bool write(const uint8_t *buffer, uint16_t buffer_size, uint16_t address) {
 bool init() {
     if (OPTION_EXT_EEPROM) {
         // write 0 (no protection) to status register
-        SPI.beginTransaction(AT25256B_SPI);
-        digitalWrite(EEPROM_SELECT, LOW);
-        SPI.transfer(WRSR);
-        SPI.transfer(0);
-        digitalWrite(EEPROM_SELECT, HIGH);
-        SPI.endTransaction();
+        uint8_t buffer[] = { WRSR, 0 };
+        spi_queue::transfer(AT25256B_SPI, EEPROM_SELECT, spi_queue::NO_PIN, buffer, sizeof(buffer));
     }
 
     return test();
@@ -28,19 +28,15 @@
 |64     |  24|[Total ON-time counter](#ontime-counter)  |
 |128    |  24|[CH1 ON-time counter](#ontime-counter)    |
 |192    |  24|[CH2 ON-time counter](#ontime-counter)    |
-|1024   |  55|[Device configuration](#device)           |
+|512    |  43|[Power fail record](#power-fail)          |
+|1024   |  64|[Device configuration](#device)           |
 |2048   | 137|CH1 [calibration parameters](#calibration)|
 |2560   | 137|CH2 [calibration parameters](#calibration)|
-|4096   | 196|[Profile](#profile) 0                     |
-|5120   | 196|[Profile](#profile) 1                     |
-|6144   | 196|[Profile](#profile) 2                     |
-|7168   | 196|[Profile](#profile) 3                     |
-|8192   | 196|[Profile](#profile) 4                     |
-|9216   | 196|[Profile](#profile) 5                     |
-|10240  | 196|[Profile](#profile) 6                     |
-|11264  | 196|[Profile](#profile) 7                     |
-|12288  | 196|[Profile](#profile) 8                     |
-|13312  | 196|[Profile](#profile) 9                     |
+|4096   |2560|[Profile directory](#profile-directory)   |
+|6656   | 158|[Profile](#profile) 0                     |
+|6848   | 158|[Profile](#profile) 1                     |
+|...    |    |every 192 bytes                           |
+|16064  | 158|[Profile](#profile) 49                    |
 |16384  | 610|[Event Queue](#event-queue)               |
 
 ## <a name="ontime-counter">ON-time counter</a>
@@ -54,6 +50,17 @@
 |16    |4   |int                      |2nd counter                  |
 |20    |4   |int                      |2bd counter (copy)           |
 
+## <a name="power-fail">Power fail record</a>
+
+|Offset|Size|Type                     |Description                  |
+|------|----|-------------------------|-----------------------------|
+|0     |6   |[struct](#block-header)  |[Block header](#block-header)|
+|6     |12  |int                      |Total, CH1 and CH2 ON-time   |
+|18    |8   |float                    |CH1 and CH2 voltage set      |
+|26    |8   |float                    |CH1 and CH2 current set      |
+|34    |8   |int                      |Pending events               |
+|42    |1   |int                      |Number of pending events     |
+
 ## <a name="device">Device configuration</a>
 
 |Offset|Size|Type                     |Description                  |
@@ -77,6 +84,9 @@
 |49    |2   |int                      |Touch screen cal. BRY        |
 |51    |2   |int                      |Touch screen cal. TRX        |
 |53    |2   |int                      |Touch screen cal. TRY        |
+|56    |4   |int                      |Telemetry IP address         |
+|60    |2   |int                      |Telemetry UDP port           |
+|62    |2   |int                      |Telemetry interval [ms]      |
 
 #### <a name="device-flags">Device flags</a>
 
@@ -91,9 +101,7 @@
 |6  |Channel display mode|
 |7  |Channel display mode|
 |8  |Ethernet enabled    |
-|7  |Reserved            |
-|8  |Reserved            |
-|9  |Reserved            |
+|9  |Telemetry enabled   |
 |10 |Reserved            |
 |11 |Reserved            |
 |12 |Reserved            |
@@ -137,17 +145,28 @@
 |4     |4   |float|Real value |
 |8     |4   |float|ADC value  |
 
+## <a name="profile-directory">Profile directory</a>
+
+Array of entries, one for each profile location. Profile is valid only if
+the profile checksum in the entry matches the profile block checksum.
+
+|Offset|Size|Type                   |Description                    |
+|------|----|-----------------------|-------------------------------|
+|0     |6   |[struct](#block-header)|[Block header](#block-header)  |
+|6     |4   |int                    |Profile checksum               |
+|10    |1   |boolean                |Is valid?                      |
+|11    |33  |string                 |Name                           |
+
 ## <a name="profile">Profile</a>
 
 |Offset|Size|Type                   |Description                    |
 |------|----|-----------------------|-------------------------------|
 |0     |6   |[struct](#block-header)|[Block header](#block-header)  |
 |6     |1   |boolean                |Is valid?                      |
-|7     |33  |string                 |Name                           |
-|40    |1   |boolean                |Is power up?                   |
-|41    |50  |[struct](#ch-params)   |CH1 [parameters](#ch-params)   |
-|91    |50  |[struct](#ch-params)   |CH2 [parameters](#ch-params)   |
-|141   |55  |[struct](#otp-conf)[5] |[OTP configurations](#otp-conf)|
+|7     |1   |boolean                |Is power up?                   |
+|8     |50  |[struct](#ch-params)   |CH1 [parameters](#ch-params)   |
+|58    |50  |[struct](#ch-params)   |CH2 [parameters](#ch-params)   |
+|108   |50  |[struct](#otp-conf)[5] |[OTP configurations](#otp-conf)|
 
 #### <a name="ch-params">Channel parameters</a>
 
@@ -192,10 +211,10 @@
 
 |Offset|Size|Type              |Description                     |
 |------|----|------------------|--------------------------------|
-|0     |2   |[enum](#temp-sens)|[Temperature sensor](#temp-sens)|
-|2     |4   |float             |OTP delay                       |
-|6     |4   |float             |OTP level                       |
-|10    |1   |boolean           |OTP state                       |
+|0     |1   |[enum](#temp-sens)|[Temperature sensor](#temp-sens)|
+|1     |4   |float             |OTP delay                       |
+|5     |4   |float             |OTP level                       |
+|9     |1   |boolean           |OTP state                       |
 
 
 ##### <a name="temp-sens">Temperature sensor</a>
@@ -254,6 +273,9 @@ static const uint8_t WRITE = 2;
 static const uint16_t EEPROM_ONTIME_START_ADDRESS = 64;
 static const uint16_t EEPROM_ONTIME_SIZE = 64;
 
+static const uint16_t EEPROM_POWER_FAIL_START_ADDRESS = 512;
+static const uint16_t EEPROM_POWER_FAIL_SIZE = 64;
+
 static const uint16_t EEPROM_START_ADDRESS = 1024;
 
 static const uint16_t EEPROM_EVENT_QUEUE_START_ADDRESS = 16384;
@@ -53,12 +53,20 @@ EthernetClient firstClient;
 
 ////////////////////////////////////////////////////////////////////////////////
 
-size_t ethernet_client_write(EthernetClient &client, const char *data, size_t len) {
-    SPI.beginTransaction(ENC28J60_SPI);
-    size_t size = client.write(data, len);
-    SPI.endTransaction();
+#if defined(EEZ_PSU_SIMULATOR) || EEZ_PSU_SELECTED_REVISION == EEZ_PSU_REVISION_R1B9
+// Ethernet library holds the bus only while the chip is selected, so the conversion
+// reads from the interrupt handler are not deferred during the whole DHCP or client poll.
+static void beginLibraryTransaction() {
+    spi_queue::beginTransaction(ENC28J60_SPI);
+}
 
-    return size;
+static void endLibraryTransaction() {
+    spi_queue::endTransaction();
+}
+#endif
+
+size_t ethernet_client_write(EthernetClient &client, const char *data, size_t len) {
+    return client.write(data, len);
 }
 
 size_t ethernet_client_write_str(EthernetClient &client, const char *str) {
@@ -77,7 +85,7 @@ scpi_result_t SCPI_Flush(scpi_t * context) {
 
 int SCPI_Error(scpi_t *context, int_fast16_t err) {
     if (err != 0) {
-        scpi::printError(err);
+        scpi::onError(err);
     }
     return 0;
 }
@@ -103,6 +111,10 @@ scpi_result_t SCPI_Reset(scpi_t *context) {
     return psu::reset() ? SCPI_RES_OK : SCPI_RES_ERR;
 }
 
+uint32_t SCPI_Time(scpi_t *context) {
+    return scpi::getErrorTime();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 scpi_reg_val_t scpi_psu_regs[SCPI_PSU_REG_COUNT];
@@ -114,10 +126,11 @@ scpi_interface_t scpi_interface = {
     SCPI_Control,
     SCPI_Flush,
     SCPI_Reset,
+    SCPI_Time,
 };
 
 char scpi_input_buffer[SCPI_PARSER_INPUT_BUFFER_LENGTH];
-int16_t error_queue_data[SCPI_PARSER_ERROR_QUEUE_SIZE + 1];
+scpi_error_info_t error_queue_data[SCPI_PARSER_ERROR_QUEUE_SIZE + 1];
 
 scpi_t scpi_context;
 
@@ -135,16 +148,15 @@ bool init() {
 
 #if defined(EEZ_PSU_SIMULATOR) || EEZ_PSU_SELECTED_REVISION == EEZ_PSU_REVISION_R1B9
     Enc28J60Network::setControlCS(ETH_SELECT);
+    Enc28J60Network::setTransactionHooks(beginLibraryTransaction, endLibraryTransaction);
 #elif EEZ_PSU_SELECTED_REVISION == EEZ_PSU_REVISION_R3B4
+    // library sets up the SPI transaction itself, the bus is held while the chip is selected
+    W5500Class::setTransactionHooks(spi_queue::holdBus, spi_queue::releaseBus);
     Ethernet.init(ETH_SELECT);
     Ethernet.setDhcpTimeout(ETHERNET_DHCP_TIMEOUT * 1000UL);
 #endif
 
-    SPI.beginTransaction(ENC28J60_SPI);
-
     if (!Ethernet.begin(mac)) {
-        SPI.endTransaction();
-
         test_result = psu::TEST_WARNING;
         DebugTrace("Ethernet not connected!");
         event_queue::pushEvent(event_queue::EVENT_WARNING_ETHERNET_NOT_CONNECTED);
@@ -154,8 +166,6 @@ bool init() {
 
     server.begin();
 
-    SPI.endTransaction();
-
     test_result = psu::TEST_OK;
 
     DebugTraceF("Listening on port %d", (int)TCP_PORT);
@@ -191,8 +201,6 @@ void tick(unsigned long tick_usec) {
         return;
     }
 
-    SPI.beginTransaction(ENC28J60_SPI);
-
     if (firstClientDetected) {
         if (!firstClient.connected()) {
             firstClientDetected = false;
@@ -215,16 +223,12 @@ void tick(unsigned long tick_usec) {
             uint8_t* msg = (uint8_t*)malloc(size);
             size = client.read(msg, size);
             if (client == firstClient) {
-                SPI.endTransaction();
                 for (size_t i = 0; i < size; ++i) {
                     input(scpi_context, msg[i]);
                 }
-                SPI.beginTransaction(ENC28J60_SPI);
             }
             else {
-                SPI.endTransaction();
                 ethernet_client_write_str(client, "Already connected!\r\n");
-                SPI.beginTransaction(ENC28J60_SPI);
 
                 client.stop();
 
@@ -233,8 +237,6 @@ void tick(unsigned long tick_usec) {
             free(msg);
         }
     }
-
-    SPI.endTransaction();
 }
 
 uint32_t getIpAddress() {
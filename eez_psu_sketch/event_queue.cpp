@@ -31,7 +31,6 @@ namespace event_queue {
 static const uint32_t MAGIC = 0xD8152FC3L;
 static const uint16_t VERSION = 4;
 
-static const uint16_t MAX_EVENTS = 100;
 static const uint16_t NULL_INDEX = MAX_EVENTS;
 
 static const uint16_t EVENT_HEADER_SIZE = 16;
@@ -53,6 +52,15 @@ static const int MAX_EVENTS_DURING_INTERRUPT_HANDLING = sizeof(g_eventsDuringInt
 
 static uint8_t g_pageIndex = 0;
 
+#if !defined(EEZ_PSU_ARDUINO_MEGA)
+// RAM copy of the events, so paging doesn't read EEPROM
+static Event g_events[MAX_EVENTS];
+#endif
+
+// event type (low nibble) and channel (high nibble) of each event, so filtering
+// doesn't parse the event names and, on Arduino Mega, doesn't read EEPROM
+static uint8_t g_eventTypeAndChannel[MAX_EVENTS];
+
 void readHeader() {
 	eeprom::read((uint8_t *)&eventQueue, sizeof(EventQueueHeader), eeprom::EEPROM_EVENT_QUEUE_START_ADDRESS);
 }
@@ -62,11 +70,27 @@ void writeHeader() {
 }
 
 void readEvent(uint16_t eventIndex, Event *e) {
+#if defined(EEZ_PSU_ARDUINO_MEGA)
 	eeprom::read((uint8_t *)e, sizeof(Event), eeprom::EEPROM_EVENT_QUEUE_START_ADDRESS + EVENT_HEADER_SIZE + eventIndex * EVENT_SIZE);
+#else
+	*e = g_events[eventIndex];
+#endif
+}
+
+static void indexEvent(uint16_t eventIndex, Event *e) {
+	g_eventTypeAndChannel[eventIndex] = getEventType(e) | (getEventChannel(e) << 4);
 }
 
 void writeEvent(uint16_t eventIndex, Event *e) {
 	eeprom::write((uint8_t *)e, sizeof(Event), eeprom::EEPROM_EVENT_QUEUE_START_ADDRESS + EVENT_HEADER_SIZE + eventIndex * EVENT_SIZE);
+#if !defined(EEZ_PSU_ARDUINO_MEGA)
+	g_events[eventIndex] = *e;
+#endif
+	indexEvent(eventIndex, e);
+}
+
+static uint16_t getEventIndex(int index) {
+	return (eventQueue.head - (index + 1) + MAX_EVENTS) % MAX_EVENTS;
 }
 
 void init() {
@@ -83,13 +107,32 @@ void init() {
 
 		pushEvent(EVENT_INFO_WELCOME);
 	}
+	else {
+		for (uint16_t i = 0; i < eventQueue.size; ++i) {
+			uint16_t eventIndex = getEventIndex(i);
+			Event e;
+			eeprom::read((uint8_t *)&e, sizeof(Event), eeprom::EEPROM_EVENT_QUEUE_START_ADDRESS + EVENT_HEADER_SIZE + eventIndex * EVENT_SIZE);
+#if !defined(EEZ_PSU_ARDUINO_MEGA)
+			g_events[eventIndex] = e;
+#endif
+			indexEvent(eventIndex, &e);
+		}
+	}
 }
 
 void tick(unsigned long tick_usec) {
-	for (int i = 0; i < g_eventsDuringInterruptHandlingHead; ++i) {
-		pushEvent(g_eventsDuringInterruptHandling[i]);
+	// one event per main loop iteration, each is written to EEPROM
+	if (g_eventsDuringInterruptHandlingHead > 0) {
+		noInterrupts();
+		int16_t eventId = g_eventsDuringInterruptHandling[0];
+		--g_eventsDuringInterruptHandlingHead;
+		for (int i = 0; i < g_eventsDuringInterruptHandlingHead; ++i) {
+			g_eventsDuringInterruptHandling[i] = g_eventsDuringInterruptHandling[i + 1];
+		}
+		interrupts();
+
+		pushEvent(eventId);
 	}
-	g_eventsDuringInterruptHandlingHead = 0;
 }
 
 int getNumEvents() {
@@ -97,8 +140,7 @@ int getNumEvents() {
 }
 
 void getEvent(uint16_t index, Event *e) {
-	uint16_t eventIndex = (eventQueue.head - (index + 1) + MAX_EVENTS) % MAX_EVENTS;
-	readEvent(eventIndex, e);
+	readEvent(getEventIndex(index), e);
 }
 
 void getLastErrorEvent(Event *e) {
@@ -121,6 +163,40 @@ int getEventType(Event *e) {
 	}
 }
 
+int getEventChannel(Event *e) {
+	const char *p_name = 0;
+
+	switch (e->eventId) {
+#define EVENT_SCPI_ERROR(ID, TEXT) case ID: p_name = PSTR(#ID); break;
+#define EVENT_ERROR(NAME, ID, TEXT) case EVENT_ERROR_START_ID + ID: p_name = PSTR(#NAME); break;
+#define EVENT_WARNING(NAME, ID, TEXT) case EVENT_WARNING_START_ID + ID: p_name = PSTR(#NAME); break;
+#define EVENT_INFO(NAME, ID, TEXT) case EVENT_INFO_START_ID + ID: p_name = PSTR(#NAME); break;
+		LIST_OF_EVENTS
+#undef EVENT_SCPI_ERROR
+#undef EVENT_INFO
+#undef EVENT_WARNING
+#undef EVENT_ERROR
+	}
+
+	if (p_name) {
+		// channel events are named CH<n>_..., SCPI errors SCPI_ERROR_CH<n>_...
+		char name[16];
+		strncpy_P(name, p_name, sizeof(name) - 1);
+		name[sizeof(name) - 1] = 0;
+
+		const char *p = name;
+		if (strncmp_P(p, PSTR("SCPI_ERROR_"), 11) == 0) {
+			p += 11;
+		}
+
+		if (p[0] == 'C' && p[1] == 'H' && p[2] >= '1' && p[2] <= '9' && p[3] == '_') {
+			return p[2] - '0';
+		}
+	}
+
+	return 0;
+}
+
 const char *getEventMessage(Event *e) {
 	static char message[35];
 
@@ -211,11 +287,19 @@ void pushEvent(int16_t eventId) {
 		writeHeader();
 
 		if (getEventType(&e) == EVENT_TYPE_ERROR) {
-			sound::playBeep();
+			sound::playErrorBeep(e.eventId);
 		}
 	}
 }
 
+int getPendingEvents(int16_t *events, int maxEvents) {
+	int numEvents = min((int)g_eventsDuringInterruptHandlingHead, maxEvents);
+	for (int i = 0; i < numEvents; ++i) {
+		events[i] = g_eventsDuringInterruptHandling[i];
+	}
+	return numEvents;
+}
+
 void markAsRead() {
 	if (eventQueue.lastErrorEventIndex != NULL_INDEX) {
 		eventQueue.lastErrorEventIndex = NULL_INDEX;
@@ -223,6 +307,64 @@ void markAsRead() {
 	}
 }
 
+static bool isTypeAndChannelMatching(uint16_t eventIndex, const EventFilter *filter) {
+	uint8_t typeAndChannel = g_eventTypeAndChannel[eventIndex];
+
+	if (filter->type != EVENT_TYPE_NONE && (typeAndChannel & 0x0F) != filter->type) {
+		return false;
+	}
+
+	if (filter->channel && (typeAndChannel >> 4) != filter->channel) {
+		return false;
+	}
+
+	return true;
+}
+
+static bool isTimeMatching(Event *e, const EventFilter *filter) {
+	if (filter->from && e->dateTime < filter->from) {
+		return false;
+	}
+
+	if (filter->to && e->dateTime > filter->to) {
+		return false;
+	}
+
+	return true;
+}
+
+bool findEvent(const EventFilter *filter, int &index, Event *e) {
+	for (; index < getNumEvents(); ++index) {
+		uint16_t eventIndex = getEventIndex(index);
+		if (isTypeAndChannelMatching(eventIndex, filter)) {
+			readEvent(eventIndex, e);
+			if (isTimeMatching(e, filter)) {
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+int getNumMatchingEvents(const EventFilter *filter) {
+	int count = 0;
+	for (int index = 0; index < getNumEvents(); ++index) {
+		uint16_t eventIndex = getEventIndex(index);
+		if (isTypeAndChannelMatching(eventIndex, filter)) {
+			if (filter->from || filter->to) {
+				// time is not indexed, there is no RAM for it on Arduino Mega
+				Event e;
+				readEvent(eventIndex, &e);
+				if (!isTimeMatching(&e, filter)) {
+					continue;
+				}
+			}
+			++count;
+		}
+	}
+	return count;
+}
+
 int getNumPages() {
 	return (getNumEvents() + EVENTS_PER_PAGE - 1) / EVENTS_PER_PAGE;
 }
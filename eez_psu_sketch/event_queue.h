@@ -27,6 +27,8 @@ static const int EVENT_TYPE_INFO = 1;
 static const int EVENT_TYPE_WARNING = 2;
 static const int EVENT_TYPE_ERROR = 3;
 
+static const uint16_t MAX_EVENTS = 100;
+
 ////////////////////////////////////////////////////////////////////////////////
 
 #define LIST_OF_EVENTS \
@@ -47,6 +49,7 @@ static const int EVENT_TYPE_ERROR = 3;
 	EVENT_WARNING(CH1_CALIBRATION_DISABLED, 0, "Ch1 calibration disabled") \
 	EVENT_WARNING(CH2_CALIBRATION_DISABLED, 1, "Ch2 calibration disabled") \
     EVENT_WARNING(ETHERNET_NOT_CONNECTED, 2, "Ethernet not connected") \
+    EVENT_WARNING(OLD_PROFILES_LOST, 3, "Old profiles lost") \
 	EVENT_INFO(WELCOME, 0, "Welcome!") \
 	EVENT_INFO(POWER_UP, 1, "Power up") \
 	EVENT_INFO(POWER_DOWN, 2, "Power down") \
@@ -90,6 +93,9 @@ static const int EVENT_TYPE_ERROR = 3;
 	EVENT_INFO(DEFAULE_PROFILE_CHANGED_TO_9, 89, "Default profile changed to 9") \
 	EVENT_INFO(CH1_CALIBRATION_ENABLED, 90, "Ch1 calibration enabled") \
 	EVENT_INFO(CH2_CALIBRATION_ENABLED, 91, "Ch2 calibration enabled") \
+	EVENT_INFO(RECALL_FROM_PROFILE, 92, "Recall from profile") \
+	EVENT_INFO(DEFAULE_PROFILE_CHANGED, 93, "Default profile changed") \
+	EVENT_INFO(OLD_PROFILES_CONVERTED, 94, "Old profiles converted") \
 
 #define EVENT_ERROR_START_ID 10000
 #define EVENT_WARNING_START_ID 12000
@@ -122,16 +128,39 @@ struct Event {
 	int16_t eventId;
 };
 
+/// Selects the events returned by findEvent. Zero initialized filter selects all events.
+struct EventFilter {
+	uint8_t type;     // EVENT_TYPE_INFO, EVENT_TYPE_WARNING, EVENT_TYPE_ERROR or EVENT_TYPE_NONE for any type
+	uint8_t channel;  // 1 or 2, 0 for any channel
+	uint32_t from;    // minimal event date and time, 0 if not limited
+	uint32_t to;      // maximal event date and time, 0 if not limited
+};
+
 void init();
 void tick(unsigned long tick_usec);
 
 void getLastErrorEvent(Event *e);
 
 int getEventType(Event *e);
+/// Returns the channel (1 or 2) the event refers to, 0 if it doesn't refer to the channel.
+int getEventChannel(Event *e);
 const char *getEventMessage(Event *e);
 
+int getNumEvents();
+/// Get the event at the index, 0 is the most recent event.
+void getEvent(uint16_t index, Event *e);
+
+/// Find the first event, at or after the index, matching the filter.
+/// Index is moved to the found event. Returns false if there is no such event.
+bool findEvent(const EventFilter *filter, int &index, Event *e);
+int getNumMatchingEvents(const EventFilter *filter);
+
 void pushEvent(int16_t eventId);
 
+/// Copy the events pushed from the interrupt handler which are not written yet.
+/// Returns the number of copied events.
+int getPendingEvents(int16_t *events, int maxEvents);
+
 void markAsRead();
 
 int getNumPages();
@@ -131,7 +131,6 @@ void finish_rpm_measure() {
 
 bool init() {
 	g_rpmMeasureInterruptNumber = digitalPinToInterrupt(FAN_SENSE);
-    SPI.usingInterrupt(g_rpmMeasureInterruptNumber);
 
 	return test();
 }
@@ -147,7 +146,7 @@ bool test() {
 	if (OPTION_FAN) {
 		unsigned long time_since_test_start = millis() - g_testStartTime;
 		if (time_since_test_start < 250) {
-			delay(300 - time_since_test_start);
+			spi_queue::delay(300 - time_since_test_start);
 		}
 
 #ifdef EEZ_PSU_SIMULATOR
@@ -9,6 +9,12 @@
 //#define MAX_TAP_DURATION 250 * 1000UL
 #define MAX_TAP_DISTANCE 150
 
+#define MIN_FLING_VELOCITY 600
+
+#define CONF_GUI_LONG_PRESS_TIMEOUT 1000000UL
+#define CONF_GUI_AUTO_REPEAT_DELAY 500000UL
+#define CONF_GUI_AUTO_REPEAT_PERIOD 100000UL
+
 namespace eez {
 namespace psu {
 namespace gui {
@@ -18,6 +24,12 @@ GestureType gesture_type = GESTURE_NONE;
 int start_x;
 int start_y;
 
+long velocity_x;
+long velocity_y;
+
+long acceleration_x;
+long acceleration_y;
+
 static unsigned long last_tick_usec;
 static int last_x;
 static int last_y;
@@ -27,18 +39,76 @@ static long distance_y;
 static unsigned long time;
 static unsigned long count;
 
+static unsigned long last_sample_usec;
+static int last_sample_x;
+static int last_sample_y;
+
+static bool is_moved_away;
+static bool is_long_press;
+static unsigned long next_repeat_usec;
+
+void updateVelocity(unsigned long tick_usec) {
+    unsigned long dt = tick_usec - last_sample_usec;
+    if (dt == 0) {
+        return;
+    }
+
+    // average with the previous velocity to filter out the touch panel noise
+    long new_velocity_x = (velocity_x + (touch::x - last_sample_x) * 1000000L / (long)dt) / 2;
+    long new_velocity_y = (velocity_y + (touch::y - last_sample_y) * 1000000L / (long)dt) / 2;
+
+    long dt_ms = dt / 1000;
+    if (dt_ms == 0) {
+        dt_ms = 1;
+    }
+    acceleration_x = (new_velocity_x - velocity_x) * 1000L / dt_ms;
+    acceleration_y = (new_velocity_y - velocity_y) * 1000L / dt_ms;
+
+    velocity_x = new_velocity_x;
+    velocity_y = new_velocity_y;
+
+    last_sample_usec = tick_usec;
+    last_sample_x = touch::x;
+    last_sample_y = touch::y;
+}
+
 void recognize() {
     DebugTraceF("Distance X: %ld", distance_x);
     DebugTraceF("Distance Y: %ld", distance_y);
+    DebugTraceF("Velocity X: %ld", velocity_x);
+    DebugTraceF("Velocity Y: %ld", velocity_y);
     DebugTraceF("Time: %lu", time);
     DebugTraceF("Count: %lu", count);
 
+    // touch already consumed by the long press
+    if (is_long_press) {
+        return;
+    }
+
     // tap
     if (/*time >= MIN_TAP_DURATION && time <= MAX_TAP_DURATION && */abs(distance_x) < MAX_TAP_DISTANCE && abs(distance_y) < MAX_TAP_DISTANCE) {
         gesture_type = GESTURE_TAP;
         return;
     }
 
+    // fling, i.e. slide still in motion at release
+    if (velocity_y < -MIN_FLING_VELOCITY && distance_y < -MIN_SLIDE_DISTANCE && abs(velocity_y) > abs(velocity_x)) {
+        gesture_type = GESTURE_FLING_UP;
+        return;
+    }
+    if (velocity_x > MIN_FLING_VELOCITY && distance_x > MIN_SLIDE_DISTANCE && abs(velocity_x) > abs(velocity_y)) {
+        gesture_type = GESTURE_FLING_RIGHT;
+        return;
+    }
+    if (velocity_y > MIN_FLING_VELOCITY && distance_y > MIN_SLIDE_DISTANCE && abs(velocity_y) > abs(velocity_x)) {
+        gesture_type = GESTURE_FLING_DOWN;
+        return;
+    }
+    if (velocity_x < -MIN_FLING_VELOCITY && distance_x < -MIN_SLIDE_DISTANCE && abs(velocity_x) > abs(velocity_y)) {
+        gesture_type = GESTURE_FLING_LEFT;
+        return;
+    }
+
     // sliding
     if (time > MIN_SLIDE_DURATION) {
         if (distance_y < -MIN_SLIDE_DISTANCE && abs(distance_y) > abs(distance_x)) {
@@ -70,11 +140,41 @@ void tick(unsigned long tick_usec) {
         distance_y = 0;
         time = 0;
         count = 1;
+
+        velocity_x = 0;
+        velocity_y = 0;
+        acceleration_x = 0;
+        acceleration_y = 0;
+        last_sample_usec = tick_usec;
+        last_sample_x = touch::x;
+        last_sample_y = touch::y;
+
+        is_moved_away = false;
+        is_long_press = false;
+        next_repeat_usec = tick_usec + CONF_GUI_AUTO_REPEAT_DELAY;
     } else if (touch::event_type == touch::TOUCH_MOVE) {
         distance_x += touch::x - last_x;
         distance_y += touch::y - last_y;
         time += tick_usec - last_tick_usec;
         count++;
+
+        if (touch::is_new_sample) {
+            updateVelocity(tick_usec);
+        }
+
+        if (abs(distance_x) >= MAX_TAP_DISTANCE || abs(distance_y) >= MAX_TAP_DISTANCE) {
+            is_moved_away = true;
+        }
+
+        if (!is_moved_away) {
+            if (!is_long_press && time >= CONF_GUI_LONG_PRESS_TIMEOUT) {
+                is_long_press = true;
+                gesture_type = GESTURE_LONG_PRESS;
+            } else if ((long)(tick_usec - next_repeat_usec) >= 0) {
+                next_repeat_usec = tick_usec + CONF_GUI_AUTO_REPEAT_PERIOD;
+                gesture_type = GESTURE_AUTO_REPEAT;
+            }
+        }
     } else if (touch::event_type == touch::TOUCH_UP) {
         recognize();
     }
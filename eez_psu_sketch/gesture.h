@@ -13,13 +13,32 @@ enum GestureType {
     GESTURE_SLIDE_UP,
     GESTURE_SLIDE_RIGHT,
     GESTURE_SLIDE_DOWN,
-    GESTURE_SLIDE_LEFT
+    GESTURE_SLIDE_LEFT,
+
+    GESTURE_FLING_UP,
+    GESTURE_FLING_RIGHT,
+    GESTURE_FLING_DOWN,
+    GESTURE_FLING_LEFT,
+
+    /// Reported once, while still pressed, when touch is held in place for CONF_GUI_LONG_PRESS_TIMEOUT.
+    GESTURE_LONG_PRESS,
+    /// Reported periodically, while still pressed, after CONF_GUI_AUTO_REPEAT_DELAY.
+    GESTURE_AUTO_REPEAT
 };
 
+/// Gesture recognized in the last tick, GESTURE_NONE if none.
 extern GestureType gesture_type;
 extern int start_x;
 extern int start_y;
 
+/// Smoothed touch velocity in pixels per second.
+extern long velocity_x;
+extern long velocity_y;
+
+/// Touch acceleration in pixels per second squared.
+extern long acceleration_x;
+extern long acceleration_y;
+
 void tick(unsigned long tick_usec);
 
 }
@@ -52,7 +52,6 @@
 #define CONF_GUI_STANDBY_PAGE_TIMEOUT 10000000UL
 #define CONF_GUI_ENTERING_STANDBY_PAGE_TIMEOUT 5000000UL
 #define CONF_GUI_WELCOME_PAGE_TIMEOUT 2000000UL
-#define CONF_GUI_LONG_PRESS_TIMEOUT 1000000UL
 #define CONF_GUI_DRAW_TICK_ITERATIONS 100
 #define CONF_GUI_PAGE_NAVIGATION_STACK_SIZE 5
 
@@ -94,8 +93,19 @@ static bool g_wasBlinkTime;
 
 static unsigned long g_showPageTime;
 static unsigned long g_timeOfLastActivity;
-static unsigned long g_touchDownTime;
-static bool g_touchActionExecuted;
+
+static bool g_isFrameStart = true;
+static bool g_isTouchMovePending;
+static int g_touchMoveX;
+static int g_touchMoveY;
+static unsigned long g_touchMoveSampleTime;
+static unsigned long g_touchMoveDrawnSampleTime;
+
+#ifdef EEZ_PSU_SIMULATOR
+static TouchStatistics g_touchStatistics;
+static FrameStatistics g_frameStatistics;
+static uint32_t g_framePixelsWritten;
+#endif
 
 Channel *g_channel;
 
@@ -1690,19 +1700,109 @@ void do_action(int action_id) {
 void standbyTouchHandling(unsigned long tick_usec) {
     // touch handling in power off:
     // wait for long press anywhere on the screen and then turn power on
-    if (touch::event_type == touch::TOUCH_DOWN) {
-        g_touchDownTime = tick_usec;
-        g_touchActionExecuted = false;
-    } else if (touch::event_type == touch::TOUCH_MOVE) {
-        if (tick_usec - g_touchDownTime >= CONF_GUI_LONG_PRESS_TIMEOUT) {
-            if (!g_touchActionExecuted) {
-                g_touchActionExecuted = true;
-                psu::changePowerState(true);
-            }
-        }
+    if (gesture::gesture_type == gesture::GESTURE_LONG_PRESS) {
+        psu::changePowerState(true);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+/// Remember the latest touch position for the edit mode page.
+/// Position is applied once per frame (see applyTouchMove), so the value,
+/// and therefore the DAC, is not set for every sample read while the frame is drawn.
+void queueTouchMove(unsigned long tick_usec) {
+    if (touch::x == g_touchMoveX && touch::y == g_touchMoveY) {
+        return;
+    }
+
+#ifdef EEZ_PSU_SIMULATOR
+    if (g_isTouchMovePending) {
+        ++g_touchStatistics.coalesced;
+    }
+#endif
+
+    if (!g_isTouchMovePending) {
+        g_isTouchMovePending = true;
+        g_touchMoveSampleTime = tick_usec;
+    }
+
+    g_touchMoveX = touch::x;
+    g_touchMoveY = touch::y;
+}
+
+void applyTouchMove() {
+    if (!g_isTouchMovePending) {
+        return;
+    }
+
+    g_isTouchMovePending = false;
+
+    if (g_activePageId == PAGE_ID_EDIT_MODE_SLIDER) {
+        edit_mode_slider::onTouchMove();
+    } else if (g_activePageId == PAGE_ID_EDIT_MODE_STEP) {
+        edit_mode_step::onTouchMove();
+    } else {
+        return;
+    }
+
+    if (g_touchMoveDrawnSampleTime == 0) {
+        g_touchMoveDrawnSampleTime = g_touchMoveSampleTime;
+    }
+
+#ifdef EEZ_PSU_SIMULATOR
+    ++g_touchStatistics.moves;
+#endif
+}
+
+void onFrameDrawn() {
+#ifdef EEZ_PSU_SIMULATOR
+    uint32_t pixels = lcd::lcd.pixels_written - g_framePixelsWritten;
+    g_framePixelsWritten = lcd::lcd.pixels_written;
+    ++g_frameStatistics.frames;
+    g_frameStatistics.last_pixels = pixels;
+    if (pixels > g_frameStatistics.max_pixels) {
+        g_frameStatistics.max_pixels = pixels;
+    }
+    g_frameStatistics.total_pixels += pixels;
+#endif
+
+    if (g_touchMoveDrawnSampleTime == 0) {
+        return;
+    }
+
+#ifdef EEZ_PSU_SIMULATOR
+    uint32_t latency = micros() - g_touchMoveDrawnSampleTime;
+    if (latency > g_touchStatistics.max_latency) {
+        g_touchStatistics.max_latency = latency;
     }
+    g_touchStatistics.total_latency += latency;
+    ++g_touchStatistics.num_latencies;
+#endif
+
+    g_touchMoveDrawnSampleTime = 0;
 }
 
+#ifdef EEZ_PSU_SIMULATOR
+
+TouchStatistics &getTouchStatistics() {
+    return g_touchStatistics;
+}
+
+void resetTouchStatistics() {
+    memset(&g_touchStatistics, 0, sizeof(TouchStatistics));
+}
+
+FrameStatistics &getFrameStatistics() {
+    return g_frameStatistics;
+}
+
+void resetFrameStatistics() {
+    memset(&g_frameStatistics, 0, sizeof(FrameStatistics));
+    g_framePixelsWritten = lcd::lcd.pixels_written;
+}
+
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////
 
 void init() {
@@ -1733,12 +1833,19 @@ int getStartPageId() {
 
 void tick(unsigned long tick_usec) {
 #ifdef EEZ_PSU_SIMULATOR
-    if (!simulator::front_panel::isOpened()) {
+    if (!simulator::front_panel::isOpened() && !simulator::isGuiHeadless()) {
         return;
     }
 #endif
 
     touch::tick(tick_usec);
+    gesture::tick(tick_usec);
+
+#ifdef EEZ_PSU_SIMULATOR
+    if (touch::is_new_sample && touch::event_type != touch::TOUCH_NONE && touch::event_type != touch::TOUCH_UP) {
+        ++g_touchStatistics.samples;
+    }
+#endif
 
     if (g_activePageId == -1) {
         standbyTouchHandling(tick_usec);
@@ -1794,8 +1901,10 @@ void tick(unsigned long tick_usec) {
 				return;
 			}
 
-			g_touchDownTime = tick_usec;
-			g_touchActionExecuted = false;
+			g_isTouchMovePending = false;
+			g_touchMoveX = touch::x;
+			g_touchMoveY = touch::y;
+
 			find_widget(touch::x, touch::y);
 			DECL_WIDGET(widget, found_widget.widgetOffset);
 			if (found_widget && widget->action) {
@@ -1822,21 +1931,19 @@ void tick(unsigned long tick_usec) {
 
 			if (g_foundWidgetAtDown) {
 				DECL_WIDGET(widget, g_foundWidgetAtDown.widgetOffset);
-				if (widget->action == ACTION_ID_TURN_OFF) {
-					if (tick_usec - g_touchDownTime >= CONF_GUI_LONG_PRESS_TIMEOUT) {
-						if (!g_touchActionExecuted) {
-							deselect_widget();
-							g_foundWidgetAtDown = 0;
-							g_touchActionExecuted = true;
-							psu::changePowerState(false);
-						}
-					}
+				if (widget->action == ACTION_ID_TURN_OFF && gesture::gesture_type == gesture::GESTURE_LONG_PRESS) {
+					deselect_widget();
+					g_foundWidgetAtDown = 0;
+					psu::changePowerState(false);
 				}
 			} else {
 				if (g_activePageId == PAGE_ID_EDIT_MODE_SLIDER) {
-					edit_mode_slider::onTouchMove();
+					queueTouchMove(tick_usec);
 				} else if (g_activePageId == PAGE_ID_EDIT_MODE_STEP) {
-					edit_mode_step::onTouchMove();
+					queueTouchMove(tick_usec);
+					if (gesture::gesture_type == gesture::GESTURE_AUTO_REPEAT) {
+						edit_mode_step::onTouchRepeat();
+					}
 				} else if (g_activePageId == PAGE_ID_SCREEN_CALIBRATION_YES_NO || g_activePageId == PAGE_ID_SCREEN_CALIBRATION_YES_NO_CANCEL) {
 	#ifdef CONF_DEBUG
 					int x = touch::x;
@@ -1864,10 +1971,19 @@ void tick(unsigned long tick_usec) {
 				do_action(widget->action);
 				g_foundWidgetAtDown = 0;
 			} else {
+				// the last position must not be lost
+				applyTouchMove();
+
 				if (g_activePageId == PAGE_ID_EDIT_MODE_SLIDER) {
 					edit_mode_slider::onTouchUp();
 				} else if (g_activePageId == PAGE_ID_EDIT_MODE_STEP) {
 					edit_mode_step::onTouchUp();
+				} else if (g_activePageId == PAGE_ID_EVENT_QUEUE) {
+					if (gesture::gesture_type == gesture::GESTURE_FLING_LEFT || gesture::gesture_type == gesture::GESTURE_FLING_UP) {
+						event_queue::moveToNextPage();
+					} else if (gesture::gesture_type == gesture::GESTURE_FLING_RIGHT || gesture::gesture_type == gesture::GESTURE_FLING_DOWN) {
+						event_queue::moveToPreviousPage();
+					}
 				}
 			}
 		}
@@ -1897,7 +2013,13 @@ void tick(unsigned long tick_usec) {
 	}
 
     // update screen
-    draw_tick();
+    if (g_isFrameStart) {
+        applyTouchMove();
+    }
+    g_isFrameStart = !draw_tick();
+    if (g_isFrameStart) {
+        onFrameDrawn();
+    }
 }
 
 }
@@ -33,6 +33,40 @@ void showStandbyPage();
 void showEnteringStandbyPage();
 void showEthernetInit();
 
+/// Finish drawing of the current frame.
+void flush();
+
+#ifdef EEZ_PSU_SIMULATOR
+/// Touch responsiveness counters, used to benchmark replayed touch traces.
+struct TouchStatistics {
+    /// Number of touch positions read while pressed.
+    uint32_t samples;
+    /// Number of positions applied to the edit mode pages.
+    uint32_t moves;
+    /// Number of positions dropped because a newer one arrived in the same frame.
+    uint32_t coalesced;
+    /// Time from the position read until the frame showing it is drawn, in microseconds.
+    uint32_t max_latency;
+    uint32_t total_latency;
+    uint32_t num_latencies;
+};
+
+TouchStatistics &getTouchStatistics();
+void resetTouchStatistics();
+
+/// Framebuffer write counters, used to measure the drawing cost of the pages.
+struct FrameStatistics {
+    /// Number of frames drawn.
+    uint32_t frames;
+    /// Pixels written to the framebuffer since the previous frame.
+    uint32_t last_pixels;
+    uint32_t max_pixels;
+    uint32_t total_pixels;
+};
+
+FrameStatistics &getFrameStatistics();
+void resetFrameStatistics();
+#endif
 
 }
 }
@@ -24,6 +24,7 @@
 #include "gui_edit_mode_keypad.h"
 #include "gui_edit_mode_step.h"
 #include "channel.h"
+#include "coupling.h"
 
 namespace eez {
 namespace psu {
@@ -256,9 +257,11 @@ void select(Cursor &cursor, uint8_t id, int index) {
 
 Value getMin(const Cursor &cursor, uint8_t id) {
     if (id == DATA_ID_CHANNEL_U_SET || id == DATA_ID_CHANNEL_U_MON) {
-        return Value(Channel::get(cursor.i).u.min, VALUE_TYPE_FLOAT_VOLT);
+        Channel &channel = Channel::get(cursor.i);
+        return Value(channel.u.min * coupling::getVoltageFactor(channel), VALUE_TYPE_FLOAT_VOLT);
     } else if (id == DATA_ID_CHANNEL_I_SET || id == DATA_ID_CHANNEL_I_MON) {
-        return Value(Channel::get(cursor.i).i.min, VALUE_TYPE_FLOAT_AMPER);
+        Channel &channel = Channel::get(cursor.i);
+        return Value(channel.i.min * coupling::getCurrentFactor(channel), VALUE_TYPE_FLOAT_AMPER);
     } else if (id == DATA_ID_EDIT_VALUE) {
         return edit_mode::getMin();
     }
@@ -267,9 +270,11 @@ Value getMin(const Cursor &cursor, uint8_t id) {
 
 Value getMax(const Cursor &cursor, uint8_t id) {
     if (id == DATA_ID_CHANNEL_U_SET || id == DATA_ID_CHANNEL_U_MON) {
-        return Value(Channel::get(cursor.i).u.max, VALUE_TYPE_FLOAT_VOLT);
+        Channel &channel = Channel::get(cursor.i);
+        return Value(channel.u.max * coupling::getVoltageFactor(channel), VALUE_TYPE_FLOAT_VOLT);
     } else if (id == DATA_ID_CHANNEL_I_SET || id == DATA_ID_CHANNEL_I_MON) {
-        return Value(Channel::get(cursor.i).i.max, VALUE_TYPE_FLOAT_AMPER);
+        Channel &channel = Channel::get(cursor.i);
+        return Value(channel.i.max * coupling::getCurrentFactor(channel), VALUE_TYPE_FLOAT_AMPER);
     } else if (id == DATA_ID_EDIT_VALUE) {
         return edit_mode::getMax();
     }
@@ -292,42 +297,58 @@ void getButtonLabels(const Cursor &cursor, uint8_t id, const Value **labels, int
 }
 
 bool set(const Cursor &cursor, uint8_t id, Value value, int16_t *error) {
+	if (id == DATA_ID_CHANNEL_U_SET || id == DATA_ID_CHANNEL_I_SET) {
+		Channel &channel = Channel::get(cursor.i);
+		if (coupling::isSlave(channel)) {
+			if (error) *error = SCPI_ERROR_SETTINGS_CONFLICT;
+			return false;
+		}
+	}
+
 	if (id == DATA_ID_CHANNEL_U_SET) {
-		if (value.getFloat() < Channel::get(cursor.i).u.min || value.getFloat() > Channel::get(cursor.i).u.max) {
+		Channel &channel = Channel::get(cursor.i);
+		float u_factor = coupling::getVoltageFactor(channel);
+		float i_factor = coupling::getCurrentFactor(channel);
+
+		if (value.getFloat() < channel.u.min * u_factor || value.getFloat() > channel.u.max * u_factor) {
 			if (error) *error = SCPI_ERROR_DATA_OUT_OF_RANGE;
 			return false;
 		}
 		
-		if (value.getFloat() > Channel::get(cursor.i).getVoltageLimit()) {
+		if (value.getFloat() > channel.getVoltageLimit() * u_factor) {
 			if (error) *error = SCPI_ERROR_VOLTAGE_LIMIT_EXCEEDED;
 			return false;
 		}
         
-		if (value.getFloat() * Channel::get(cursor.i).i.set > Channel::get(cursor.i).getPowerLimit()) {
+		if (value.getFloat() * channel.i.set * i_factor > channel.getPowerLimit() * u_factor * i_factor) {
 			if (error) *error = SCPI_ERROR_POWER_LIMIT_EXCEEDED;
             return false;
         }
         
-		Channel::get(cursor.i).setVoltage(value.getFloat());
+		coupling::setVoltage(channel, value.getFloat());
 
 		return true;
     } else if (id == DATA_ID_CHANNEL_I_SET) {
-		if (value.getFloat() < Channel::get(cursor.i).i.min || value.getFloat() > Channel::get(cursor.i).i.max) {
+		Channel &channel = Channel::get(cursor.i);
+		float u_factor = coupling::getVoltageFactor(channel);
+		float i_factor = coupling::getCurrentFactor(channel);
+
+		if (value.getFloat() < channel.i.min * i_factor || value.getFloat() > channel.i.max * i_factor) {
 			if (error) *error = SCPI_ERROR_DATA_OUT_OF_RANGE;
 			return false;
 		}
 		
-		if (value.getFloat() > Channel::get(cursor.i).getCurrentLimit()) {
+		if (value.getFloat() > channel.getCurrentLimit() * i_factor) {
 			if (error) *error = SCPI_ERROR_CURRENT_LIMIT_EXCEEDED;
 			return false;
 		}
         
-		if (value.getFloat() * Channel::get(cursor.i).u.set > Channel::get(cursor.i).getPowerLimit()) {
+		if (value.getFloat() * channel.u.set * u_factor > channel.getPowerLimit() * u_factor * i_factor) {
 			if (error) *error = SCPI_ERROR_POWER_LIMIT_EXCEEDED;
             return false;
         }
         
-		Channel::get(cursor.i).setCurrent(value.getFloat());
+		coupling::setCurrent(channel, value.getFloat());
 
 		return true;
     } else if (id == DATA_ID_ALERT_MESSAGE) {
@@ -20,6 +20,7 @@
 #include "calibration.h"
 #include "temperature.h"
 #include "persist_conf.h"
+#include "coupling.h"
 #include "gui_data_snapshot.h"
 #include "gui_internal.h"
 #include "gui_keypad.h"
@@ -91,11 +92,15 @@ void Snapshot::takeSnapshot() {
 
         channelSnapshots[i].flags.state = channel.isOutputEnabled() ? 1 : 0;
 
+        // in case of coupled channels CH1 displays combined output
+        float uFactor = coupling::getVoltageFactor(channel);
+        float iFactor = coupling::getCurrentFactor(channel);
+
         if (timeout) {
             char *mode_str = channel.getCvModeStr();
             channelSnapshots[i].flags.mode = 0;
-            float uMon = channel.u.mon;
-            float iMon = channel.i.mon;
+            float uMon = coupling::getVoltageMon(channel);
+            float iMon = coupling::getCurrentMon(channel);
             if (strcmp(mode_str, "CC") == 0) {
                 channelSnapshots[i].mon_value = Value(uMon, VALUE_TYPE_FLOAT_VOLT);
             } else if (strcmp(mode_str, "CV") == 0) {
@@ -109,17 +114,17 @@ void Snapshot::takeSnapshot() {
                 }
             }
 
-			channelSnapshots[i].p_mon = util::multiply(channel.u.mon, channel.i.mon, CHANNEL_VALUE_PRECISION);
+			channelSnapshots[i].p_mon = util::multiply(uMon, iMon, CHANNEL_VALUE_PRECISION);
         }
 
-        channelSnapshots[i].u_set = channel.u.set;
-		channelSnapshots[i].u_mon = channel.u.mon;
-		channelSnapshots[i].u_monDac = channel.u.mon_dac;
-		channelSnapshots[i].u_limit = channel.getVoltageLimit();
-        channelSnapshots[i].i_set = channel.i.set;
-		channelSnapshots[i].i_mon = channel.i.mon;
-		channelSnapshots[i].i_monDac = channel.i.mon_dac;
-		channelSnapshots[i].i_limit = channel.getCurrentLimit();
+        channelSnapshots[i].u_set = channel.u.set * uFactor;
+		channelSnapshots[i].u_mon = coupling::getVoltageMon(channel);
+		channelSnapshots[i].u_monDac = coupling::getVoltageMonDac(channel);
+		channelSnapshots[i].u_limit = channel.getVoltageLimit() * uFactor;
+        channelSnapshots[i].i_set = channel.i.set * iFactor;
+		channelSnapshots[i].i_mon = coupling::getCurrentMon(channel);
+		channelSnapshots[i].i_monDac = coupling::getCurrentMonDac(channel);
+		channelSnapshots[i].i_limit = channel.getCurrentLimit() * iFactor;
 
 		channelSnapshots[i].flags.lrip = channel.flags.lrippleEnabled ? 1 : 0;
 		channelSnapshots[i].flags.rprog = channel.flags.rprogEnabled ? 1 : 0;
@@ -53,6 +53,7 @@ static int step_index = 2;
 
 static bool changed;
 static int start_pos;
+static int direction;
 
 float getStepValue() {
     if (edit_mode::getUnit() == VALUE_TYPE_FLOAT_VOLT) {
@@ -80,6 +81,36 @@ void setStepIndex(int value) {
     step_index = value;
 }
 
+bool step(int d) {
+    float min = edit_mode::getMin().getFloat();
+    float max = edit_mode::getMax().getFloat();
+
+    float value = edit_mode::getEditValue().getFloat();
+
+    float stepValue = getStepValue();
+    if (d > 0) {
+        if (value == min) {
+            value = (floorf(min / stepValue) + 1) * stepValue;
+        } else {
+            value += getStepValue();
+        }
+        if (value > max) {
+            value = max;
+        }
+    } else {
+        if (value == max) {
+            value = (ceilf(max / stepValue) - 1) * stepValue;
+        } else {
+            value -= getStepValue();
+        }
+        if (value < min) {
+            value = min;
+        }
+    }
+
+    return edit_mode::setValue(value);
+}
+
 void test() {
     if (!changed) {
 #if DISPLAY_ORIENTATION == DISPLAY_ORIENTATION_PORTRAIT
@@ -88,34 +119,9 @@ void test() {
         int d = touch::x - start_pos;
 #endif
         if (abs(d) >= CONF_GUI_EDIT_MODE_STEP_THRESHOLD_PX) {
-            float min = edit_mode::getMin().getFloat();
-            float max = edit_mode::getMax().getFloat();
-
-            float value = edit_mode::getEditValue().getFloat();
-
-            float stepValue = getStepValue();
-            if (d > 0) {
-                if (value == min) {
-                    value = (floorf(min / stepValue) + 1) * stepValue;
-                } else {
-                    value += getStepValue();
-                }
-                if (value > max) {
-                    value = max;
-                }
-            } else {
-                if (value == max) {
-                    value = (ceilf(max / stepValue) - 1) * stepValue;
-                } else {
-                    value -= getStepValue();
-                }
-                if (value < min) {
-                    value = min;
-                }
-            }
-
-            if (edit_mode::setValue(value)) {
+            if (step(d)) {
 	            changed = true;
+                direction = d;
 			}
         }
     }
@@ -138,6 +144,12 @@ void onTouchUp() {
     test();
 }
 
+void onTouchRepeat() {
+    if (changed) {
+        step(direction);
+    }
+}
+
 }
 }
 }
@@ -31,6 +31,8 @@ void setStepIndex(int value);
 void onTouchDown();
 void onTouchMove();
 void onTouchUp();
+/// Touch is held after the step was made, make another step in the same direction.
+void onTouchRepeat();
 
 }
 }
@@ -20,6 +20,7 @@
 
 #include "profile.h"
 #include "temperature.h"
+#include "coupling.h"
 
 #include "gui_data_snapshot.h"
 #include "gui_page_ch_settings_protection.h"
@@ -32,14 +33,15 @@ namespace gui {
 ////////////////////////////////////////////////////////////////////////////////
 
 void ChSettingsProtectionPage::clear() {
-	g_channel->clearProtection();
+	coupling::clearProtection(*g_channel);
 
 	infoMessageP(PSTR("Cleared!"), actions[ACTION_ID_SHOW_CH_SETTINGS_PROT]);
 }
 
 void onClearAndDisableYes() {
-	g_channel->clearProtection();
+	coupling::clearProtection(*g_channel);
 	g_channel->disableProtection();
+	coupling::updateProtection(*g_channel);
 	profile::save();
 
 	infoMessageP(PSTR("Cleared and disabled!"), actions[ACTION_ID_SHOW_CH_SETTINGS_PROT]);
@@ -231,15 +233,17 @@ void ChSettingsProtectionSetPage::editDelay() {
 ChSettingsOvpProtectionPage::ChSettingsOvpProtectionPage() {
 	origState = state = g_channel->prot_conf.flags.u_state ? 1 : 0;
 
-	origLimit = limit = data::Value(g_channel->u.limit, data::VALUE_TYPE_FLOAT_VOLT);
-	minLimit = g_channel->u.min;
-	maxLimit = g_channel->u.max;
-	defLimit = g_channel->u.max;
+	float factor = coupling::getVoltageFactor(*g_channel);
 
-	origLevel = level = data::Value(g_channel->prot_conf.u_level, data::VALUE_TYPE_FLOAT_VOLT);
-	minLevel = g_channel->u.set;
-	maxLevel = g_channel->u.max;
-	defLevel = g_channel->u.max;
+	origLimit = limit = data::Value(g_channel->u.limit * factor, data::VALUE_TYPE_FLOAT_VOLT);
+	minLimit = g_channel->u.min * factor;
+	maxLimit = g_channel->u.max * factor;
+	defLimit = g_channel->u.max * factor;
+
+	origLevel = level = data::Value(g_channel->prot_conf.u_level * factor, data::VALUE_TYPE_FLOAT_VOLT);
+	minLevel = g_channel->u.set * factor;
+	maxLevel = g_channel->u.max * factor;
+	defLevel = g_channel->u.max * factor;
 
 	origDelay = delay = data::Value(g_channel->prot_conf.u_delay, data::VALUE_TYPE_FLOAT_SECOND);
 	minDelay = g_channel->OVP_MIN_DELAY;
@@ -252,13 +256,15 @@ void ChSettingsOvpProtectionPage::onSetParamsOk() {
 }
 
 void ChSettingsOvpProtectionPage::setParams(bool checkLoad) {
-	if (checkLoad && g_channel->isOutputEnabled() && limit.getFloat() < g_channel->u.mon && util::greaterOrEqual(g_channel->i.mon, 0, CHANNEL_VALUE_PRECISION)) {
+	if (checkLoad && g_channel->isOutputEnabled() && limit.getFloat() < coupling::getVoltageMon(*g_channel) && util::greaterOrEqual(g_channel->i.mon, 0, CHANNEL_VALUE_PRECISION)) {
 		areYouSureWithMessage(PSTR("This change will affect current load."), onSetParamsOk);
 	} else {
-		g_channel->setVoltageLimit(limit.getFloat());
+		coupling::setVoltageLimit(*g_channel, limit.getFloat());
 		g_channel->prot_conf.flags.u_state = state;
-		g_channel->prot_conf.u_level = level.getFloat();
+		g_channel->prot_conf.u_level = level.getFloat() / coupling::getVoltageFactor(*g_channel);
 		g_channel->prot_conf.u_delay = delay.getFloat();
+		g_channel->updateProtectionThresholds();
+		coupling::updateProtection(*g_channel);
 		onSetFinish(checkLoad);
 	}
 }
@@ -268,9 +274,11 @@ void ChSettingsOvpProtectionPage::setParams(bool checkLoad) {
 ChSettingsOcpProtectionPage::ChSettingsOcpProtectionPage() {
 	origState = state = g_channel->prot_conf.flags.i_state ? 1 : 0;
 
-	origLimit = limit = data::Value(g_channel->i.limit, data::VALUE_TYPE_FLOAT_AMPER);
-	minLimit = g_channel->i.min;
-	maxLimit = g_channel->getMaxCurrentLimit();
+	float factor = coupling::getCurrentFactor(*g_channel);
+
+	origLimit = limit = data::Value(g_channel->i.limit * factor, data::VALUE_TYPE_FLOAT_AMPER);
+	minLimit = g_channel->i.min * factor;
+	maxLimit = g_channel->getMaxCurrentLimit() * factor;
 	defLimit = maxLimit;
 
 	origLevel = level = 0;
@@ -286,12 +294,14 @@ void ChSettingsOcpProtectionPage::onSetParamsOk() {
 }
 
 void ChSettingsOcpProtectionPage::setParams(bool checkLoad) {
-	if (checkLoad && g_channel->isOutputEnabled() && limit.getFloat() < g_channel->i.mon) {
+	if (checkLoad && g_channel->isOutputEnabled() && limit.getFloat() < coupling::getCurrentMon(*g_channel)) {
 		areYouSureWithMessage(PSTR("This change will affect current load."), onSetParamsOk);
 	} else {
-		g_channel->setCurrentLimit(limit.getFloat());
+		coupling::setCurrentLimit(*g_channel, limit.getFloat());
 		g_channel->prot_conf.flags.i_state = state;
 		g_channel->prot_conf.i_delay = delay.getFloat();
+		g_channel->updateProtectionThresholds();
+		coupling::updateProtection(*g_channel);
 		onSetFinish(checkLoad);
 	}
 }
@@ -301,15 +311,17 @@ void ChSettingsOcpProtectionPage::setParams(bool checkLoad) {
 ChSettingsOppProtectionPage::ChSettingsOppProtectionPage() {
 	origState = state = g_channel->prot_conf.flags.p_state ? 1 : 0;
 
-	origLimit = limit = data::Value(g_channel->p_limit, data::VALUE_TYPE_FLOAT_WATT);
-	minLimit = g_channel->OPP_MIN_LEVEL;
-	maxLimit = g_channel->OPP_MAX_LEVEL;
-	defLimit = g_channel->OPP_DEFAULT_LEVEL;
+	float factor = coupling::getPowerFactor(*g_channel);
+
+	origLimit = limit = data::Value(g_channel->p_limit * factor, data::VALUE_TYPE_FLOAT_WATT);
+	minLimit = g_channel->OPP_MIN_LEVEL * factor;
+	maxLimit = g_channel->OPP_MAX_LEVEL * factor;
+	defLimit = g_channel->OPP_DEFAULT_LEVEL * factor;
 
-	origLevel = level = data::Value(g_channel->prot_conf.p_level, data::VALUE_TYPE_FLOAT_WATT);
-	minLevel = g_channel->OPP_MIN_LEVEL;
-	maxLevel = g_channel->OPP_MAX_LEVEL;
-	defLevel = g_channel->OPP_DEFAULT_LEVEL;
+	origLevel = level = data::Value(g_channel->prot_conf.p_level * factor, data::VALUE_TYPE_FLOAT_WATT);
+	minLevel = g_channel->OPP_MIN_LEVEL * factor;
+	maxLevel = g_channel->OPP_MAX_LEVEL * factor;
+	defLevel = g_channel->OPP_DEFAULT_LEVEL * factor;
 
 	origDelay = delay = data::Value(g_channel->prot_conf.p_delay, data::VALUE_TYPE_FLOAT_SECOND);
 	minDelay = g_channel->OPP_MIN_DELAY;
@@ -323,17 +335,19 @@ void ChSettingsOppProtectionPage::onSetParamsOk() {
 
 void ChSettingsOppProtectionPage::setParams(bool checkLoad) {
 	if (checkLoad && g_channel->isOutputEnabled()) {
-		float pMon = g_channel->u.mon * g_channel->i.mon;
+		float pMon = coupling::getVoltageMon(*g_channel) * coupling::getCurrentMon(*g_channel);
 		if (limit.getFloat() < pMon && util::greaterOrEqual(g_channel->i.mon, 0, CHANNEL_VALUE_PRECISION)) {
 			areYouSureWithMessage(PSTR("This change will affect current load."), onSetParamsOk);
 			return;
 		}
 	}
 
-	g_channel->setPowerLimit(limit.getFloat());
+	coupling::setPowerLimit(*g_channel, limit.getFloat());
 	g_channel->prot_conf.flags.p_state = state;
-	g_channel->prot_conf.p_level = level.getFloat();
+	g_channel->prot_conf.p_level = level.getFloat() / coupling::getPowerFactor(*g_channel);
 	g_channel->prot_conf.p_delay = delay.getFloat();
+	g_channel->updateProtectionThresholds();
+	coupling::updateProtection(*g_channel);
 	onSetFinish(checkLoad);
 }
 
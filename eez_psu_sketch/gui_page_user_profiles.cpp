@@ -153,7 +153,7 @@ void UserProfilesPage::onSaveYes() {
 	if (g_selectedProfileLocation > 0) {
 
 		char remark[PROFILE_NAME_MAX_LENGTH + 1];
-		profile::getSaveName(&(((UserProfilesPage *)getActivePage())->profile), remark);
+		profile::getSaveName(g_selectedProfileLocation, remark);
 
 		keypad::startPush(0, remark, PROFILE_NAME_MAX_LENGTH, false, onSaveEditRemarkOk, 0);
 	} else {
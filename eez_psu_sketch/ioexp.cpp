@@ -86,7 +86,6 @@ bool IOExpander::init() {
     }
 
     int intNum = digitalPinToInterrupt(channel.convend_pin);
-    SPI.usingInterrupt(intNum);
     attachInterrupt(
         intNum,
         channel.index == 1 ? ioexp_interrupt_ch1 : ioexp_interrupt_ch2,
@@ -181,10 +180,21 @@ void IOExpander::onInterrupt() {
     // IMPORTANT!
     // Read ADC first, then INTF and GPIO.
     // Otherwise, it will generate 2 interrupts for single ADC start shot!
-    int16_t adc_data = channel.adc.read();
-    uint8_t gpio = reg_read(REG_GPIO);
-
-    channel.event(gpio, adc_data);
+    // Reads are executed at once if the bus is free, otherwise as soon as the main loop
+    // releases the bus, so the protection doesn't wait for the main loop tick.
+    channel.adc.readFromInterrupt(onAdcDataRead, channel.index - 1);
+
+    spi_queue::Transaction transaction;
+    transaction.settings = &MCP23S08_SPI;
+    transaction.select_pin = channel.ioexp_pin;
+    transaction.isolator_pin = channel.isolator_pin;
+    transaction.length = 3;
+    transaction.param = channel.index - 1;
+    transaction.data[0] = IOEXP_READ;
+    transaction.data[1] = REG_GPIO;
+    transaction.data[2] = 0;
+    transaction.callback = onGpioRead;
+    spi_queue::transferFromInterrupt(transaction);
 
 #if CONF_DEBUG
     debug::ioexpIntTick(micros());
@@ -193,17 +203,21 @@ void IOExpander::onInterrupt() {
 	g_insideInterruptHandler = false;
 }
 
+void IOExpander::onAdcDataRead(const spi_queue::Transaction &transaction) {
+    IOExpander &ioexp = Channel::get(transaction.param).ioexp;
+    ioexp.adc_data = AnalogDigitalConverter::getReadData(transaction);
+    ioexp.adc_read_time = micros();
+}
+
+void IOExpander::onGpioRead(const spi_queue::Transaction &transaction) {
+    Channel &channel = Channel::get(transaction.param);
+    channel.event(transaction.data[2], channel.ioexp.adc_data);
+}
+
 uint8_t IOExpander::reg_read_write(uint8_t opcode, uint8_t reg, uint8_t val) {
-    SPI.beginTransaction(MCP23S08_SPI);
-    digitalWrite(channel.isolator_pin, ISOLATOR_ENABLE);
-    digitalWrite(channel.ioexp_pin, LOW);
-    SPI.transfer(opcode);
-    SPI.transfer(reg);
-    uint8_t result = SPI.transfer(val);
-    digitalWrite(channel.ioexp_pin, HIGH);
-    digitalWrite(channel.isolator_pin, ISOLATOR_DISABLE);
-    SPI.endTransaction();
-    return result;
+    uint8_t buffer[] = { opcode, reg, val };
+    spi_queue::transfer(MCP23S08_SPI, channel.ioexp_pin, channel.isolator_pin, buffer, sizeof(buffer));
+    return buffer[2];
 }
 
 uint8_t IOExpander::reg_read(uint8_t reg) {
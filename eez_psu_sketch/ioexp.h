@@ -103,10 +103,18 @@ public:
 
     void onInterrupt();
 
+    /// Time the last ADC sample was read, in microseconds.
+    uint32_t getAdcReadTime() { return adc_read_time; }
+
 private:
     Channel &channel;
 	uint8_t gpio;
 	bool writeDisabled;
+    int16_t adc_data;
+    uint32_t adc_read_time;
+
+    static void onAdcDataRead(const spi_queue::Transaction &transaction);
+    static void onGpioRead(const spi_queue::Transaction &transaction);
 
 	uint8_t getRegInitValue(int i);
     uint8_t reg_read_write(uint8_t opcode, uint8_t reg, uint8_t val);
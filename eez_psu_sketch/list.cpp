@@ -0,0 +1,414 @@
+/*
+ * EEZ PSU Firmware
+ * Copyright (C) 2015-present, Envox d.o.o.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+ 
+#include "psu.h"
+#include "list.h"
+#include "coupling.h"
+#include "ramp.h"
+
+#if defined (_VARIANT_ARDUINO_DUE_X_)
+// use TC1 channel 1 (TC1 channel 0 is used by the buzzer)
+#define LIST_TIMER TC1
+#define LIST_CHNL 1
+#define LIST_IRQ TC4_IRQn
+#endif
+
+namespace eez {
+namespace psu {
+namespace list {
+
+struct ChannelList {
+    float voltage[LIST_MAX_LENGTH];
+    uint16_t voltage_length;
+    float current[LIST_MAX_LENGTH];
+    uint16_t current_length;
+    float dwell[LIST_MAX_LENGTH];
+    uint16_t dwell_length;
+    uint16_t count;
+
+    // precomputed by start()
+    uint16_t u_dac[LIST_MAX_LENGTH];
+    uint16_t i_dac[LIST_MAX_LENGTH];
+    int16_t i_prot_adc[LIST_MAX_LENGTH];
+    uint32_t dwell_us[LIST_MAX_LENGTH];
+    uint16_t length;
+
+    // used by the timer interrupt
+    volatile bool running;
+    volatile uint16_t step;
+    uint16_t iteration;
+    uint32_t next_step_time;
+
+    // step for which u.set and i.set are updated in the main loop
+    bool active;
+    uint16_t synced_step;
+
+    Statistics stats;
+};
+
+static ChannelList g_lists[CH_MAX];
+
+////////////////////////////////////////////////////////////////////////////////
+
+static uint16_t getListValueIndex(uint16_t length, uint16_t step) {
+    // list with only one entry is used for all the steps
+    return length == 1 ? 0 : step;
+}
+
+static float getVoltage(Channel &channel, ChannelList &list, uint16_t step) {
+    return list.voltage_length > 0 ? list.voltage[getListValueIndex(list.voltage_length, step)] : channel.u.set;
+}
+
+static float getCurrent(Channel &channel, ChannelList &list, uint16_t step) {
+    return list.current_length > 0 ? list.current[getListValueIndex(list.current_length, step)] : channel.i.set;
+}
+
+/// Execute next step of the list if it is time for it.
+/// Called from the timer interrupt handler on Arduino Due, otherwise from the main loop.
+static void executeStep(Channel &channel, ChannelList &list, uint32_t now) {
+    int32_t error = (int32_t)(now - list.next_step_time);
+    if (error < 0) {
+        return;
+    }
+
+    uint16_t step = list.step + 1;
+    if (step == list.length) {
+        if (list.count != 0 && ++list.iteration >= list.count) {
+            // stay on the last step
+            list.running = false;
+            return;
+        }
+        step = 0;
+    }
+
+    // OCP must not trip on the new step before the main loop updates I_SET,
+    // OVP level is already raised by start() to cover all the steps
+    channel.raiseCurrentProtectionThreshold(list.i_prot_adc[step]);
+    channel.dac.set_codes_from_interrupt(list.u_dac[step], list.i_dac[step]);
+
+    list.step = step;
+    list.next_step_time += list.dwell_us[step];
+
+    ++list.stats.num_steps;
+    list.stats.sum_error += error;
+    if ((uint32_t)error > list.stats.max_error) {
+        list.stats.max_error = error;
+    }
+    list.stats.last_step_time = now;
+}
+
+static void onTimer() {
+    uint32_t now = micros();
+    for (int i = 0; i < CH_NUM; ++i) {
+        if (g_lists[i].running) {
+            executeStep(Channel::get(i), g_lists[i], now);
+        }
+    }
+}
+
+#if defined (_VARIANT_ARDUINO_DUE_X_)
+
+static bool g_timerStarted;
+
+static void startTimer() {
+    if (g_timerStarted) {
+        return;
+    }
+
+    pmc_set_writeprotect(false);
+    pmc_enable_periph_clk((uint32_t)LIST_IRQ);
+    TC_Configure(LIST_TIMER, LIST_CHNL,
+        TC_CMR_TCCLKS_TIMER_CLOCK1 | // MCK/2
+        TC_CMR_WAVE |                // Waveform mode
+        TC_CMR_WAVSEL_UP_RC);        // Counter running up and reset when equals to RC
+    TC_SetRC(LIST_TIMER, LIST_CHNL, VARIANT_MCK / 2 / 1000000UL * LIST_TIMER_PERIOD);
+
+    LIST_TIMER->TC_CHANNEL[LIST_CHNL].TC_IER = TC_IER_CPCS;  // RC compare interrupt
+    LIST_TIMER->TC_CHANNEL[LIST_CHNL].TC_IDR = ~TC_IER_CPCS;
+    NVIC_EnableIRQ(LIST_IRQ);
+
+    TC_Start(LIST_TIMER, LIST_CHNL);
+    g_timerStarted = true;
+}
+
+static void stopTimer() {
+    for (int i = 0; i < CH_NUM; ++i) {
+        if (g_lists[i].running) {
+            return;
+        }
+    }
+
+    if (g_timerStarted) {
+        TC_Stop(LIST_TIMER, LIST_CHNL);
+        NVIC_DisableIRQ(LIST_IRQ);
+        g_timerStarted = false;
+    }
+}
+
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+
+static void finish(Channel &channel, ChannelList &list) {
+    list.active = false;
+
+    // make channel state consistent with the last executed step
+    channel.setVoltage(getVoltage(channel, list, list.step));
+    channel.setCurrent(getCurrent(channel, list, list.step));
+
+#if defined (_VARIANT_ARDUINO_DUE_X_)
+    stopTimer();
+#endif
+}
+
+void tick(unsigned long tick_usec) {
+#if !defined (_VARIANT_ARDUINO_DUE_X_)
+    onTimer();
+#endif
+
+    for (int i = 0; i < CH_NUM; ++i) {
+        Channel &channel = Channel::get(i);
+        ChannelList &list = g_lists[i];
+
+        if (!list.active) {
+            continue;
+        }
+
+        if (list.running && (!channel.isOutputEnabled() || channel.isTripped())) {
+            stop(channel);
+            continue;
+        }
+
+        if (!list.running) {
+            finish(channel, list);
+            continue;
+        }
+
+        uint16_t step = list.step;
+        if (step != list.synced_step) {
+            list.synced_step = step;
+
+            channel.updateVoltageLevel(getVoltage(channel, list, step));
+            channel.updateCurrentLevel(getCurrent(channel, list, step));
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void resetChannelList(Channel &channel) {
+    stop(channel);
+
+    ChannelList &list = g_lists[channel.index - 1];
+    list.voltage_length = 0;
+    list.current_length = 0;
+    list.dwell_length = 0;
+    list.count = 1;
+}
+
+static void setList(float *dest, uint16_t &dest_length, const float *list, uint16_t length) {
+    if (length > LIST_MAX_LENGTH) {
+        length = LIST_MAX_LENGTH;
+    }
+    memcpy(dest, list, length * sizeof(float));
+    dest_length = length;
+}
+
+void setVoltageList(Channel &channel, const float *list, uint16_t length) {
+    ChannelList &l = g_lists[channel.index - 1];
+    setList(l.voltage, l.voltage_length, list, length);
+}
+
+const float *getVoltageList(Channel &channel, uint16_t *length) {
+    ChannelList &l = g_lists[channel.index - 1];
+    *length = l.voltage_length;
+    return l.voltage;
+}
+
+void setCurrentList(Channel &channel, const float *list, uint16_t length) {
+    ChannelList &l = g_lists[channel.index - 1];
+    setList(l.current, l.current_length, list, length);
+}
+
+const float *getCurrentList(Channel &channel, uint16_t *length) {
+    ChannelList &l = g_lists[channel.index - 1];
+    *length = l.current_length;
+    return l.current;
+}
+
+void setDwellList(Channel &channel, const float *list, uint16_t length) {
+    ChannelList &l = g_lists[channel.index - 1];
+    setList(l.dwell, l.dwell_length, list, length);
+}
+
+const float *getDwellList(Channel &channel, uint16_t *length) {
+    ChannelList &l = g_lists[channel.index - 1];
+    *length = l.dwell_length;
+    return l.dwell;
+}
+
+void setListCount(Channel &channel, uint16_t count) {
+    g_lists[channel.index - 1].count = count;
+}
+
+uint16_t getListCount(Channel &channel) {
+    return g_lists[channel.index - 1].count;
+}
+
+bool start(Channel &channel, int16_t &err) {
+    ChannelList &list = g_lists[channel.index - 1];
+
+    if (list.running) {
+        stop(channel);
+    }
+
+    if (!channel.isOutputEnabled() || channel.isRemoteProgrammingEnabled()) {
+        err = SCPI_ERROR_EXECUTION_ERROR;
+        return false;
+    }
+
+    // list values are per channel, they can't drive the coupled output
+    if (coupling::getType() != coupling::TYPE_NONE) {
+        err = SCPI_ERROR_SETTINGS_CONFLICT;
+        return false;
+    }
+
+    ramp::stop(channel);
+
+    // all lists with more than one entry must be of the same length
+    uint16_t length = list.dwell_length;
+    if (length == 0) {
+        err = SCPI_ERROR_EXECUTION_ERROR;
+        return false;
+    }
+    if (list.voltage_length > 1 || list.current_length > 1) {
+        uint16_t other_length = list.voltage_length > 1 ? list.voltage_length : list.current_length;
+        if (length == 1) {
+            length = other_length;
+        }
+        if ((list.voltage_length > 1 && list.voltage_length != length) ||
+            (list.current_length > 1 && list.current_length != length) ||
+            (list.dwell_length > 1 && list.dwell_length != length)) {
+            err = SCPI_ERROR_LISTS_NOT_SAME_LENGTH;
+            return false;
+        }
+    }
+
+    float u_max = 0;
+    for (uint16_t step = 0; step < length; ++step) {
+        float voltage = getVoltage(channel, list, step);
+        float current = getCurrent(channel, list, step);
+
+        if (voltage > channel.getVoltageLimit()) {
+            err = SCPI_ERROR_VOLTAGE_LIMIT_EXCEEDED;
+            return false;
+        }
+
+        if (current > channel.getCurrentLimit()) {
+            err = SCPI_ERROR_CURRENT_LIMIT_EXCEEDED;
+            return false;
+        }
+
+        if (voltage * current > channel.getPowerLimit()) {
+            err = SCPI_ERROR_POWER_LIMIT_EXCEEDED;
+            return false;
+        }
+
+        if (voltage > u_max) {
+            u_max = voltage;
+        }
+
+        list.u_dac[step] = channel.getVoltageDacCode(voltage);
+        list.i_dac[step] = channel.getCurrentDacCode(current);
+        list.i_prot_adc[step] = channel.getCurrentProtectionThreshold(current);
+        list.dwell_us[step] = (uint32_t)round(list.dwell[getListValueIndex(list.dwell_length, step)] * 1000000L);
+    }
+    list.length = length;
+
+    // OVP level must not be below any of the voltages in the list
+    if (channel.prot_conf.u_level < u_max) {
+        channel.prot_conf.u_level = u_max;
+        channel.updateProtectionThresholds();
+    }
+
+    memset(&list.stats, 0, sizeof(list.stats));
+
+    list.step = 0;
+    list.synced_step = 0;
+    list.iteration = 0;
+
+    // first step is executed immediately, DAC is written directly as in executeStep,
+    // setVoltage/setCurrent would start the slew rate ramp which then fights with the list timer
+    channel.updateVoltageLevel(getVoltage(channel, list, 0));
+    channel.updateCurrentLevel(getCurrent(channel, list, 0));
+    channel.dac.set_voltage_code(list.u_dac[0]);
+    channel.dac.set_current_code(list.i_dac[0]);
+
+    uint32_t now = micros();
+    list.stats.start_time = now;
+    list.stats.last_step_time = now;
+    list.stats.num_steps = 1;
+
+    noInterrupts();
+    list.next_step_time = now + list.dwell_us[0];
+    list.running = true;
+    interrupts();
+
+    list.active = true;
+
+#if defined (_VARIANT_ARDUINO_DUE_X_)
+    startTimer();
+#endif
+
+    return true;
+}
+
+void stop(Channel &channel) {
+    ChannelList &list = g_lists[channel.index - 1];
+
+    noInterrupts();
+    list.running = false;
+    interrupts();
+
+    if (list.active) {
+        finish(channel, list);
+    }
+}
+
+bool isRunning(Channel &channel) {
+    return g_lists[channel.index - 1].running;
+}
+
+uint16_t getCurrentStep(Channel &channel) {
+    return g_lists[channel.index - 1].step;
+}
+
+const Statistics &getStatistics(Channel &channel) {
+    return g_lists[channel.index - 1].stats;
+}
+
+}
+}
+} // namespace eez::psu::list
+
+#if defined (_VARIANT_ARDUINO_DUE_X_)
+void TC4_Handler(void) {
+    TC_GetStatus(LIST_TIMER, LIST_CHNL);
+    eez::psu::list::onTimer();
+}
+#endif
@@ -0,0 +1,75 @@
+/*
+ * EEZ PSU Firmware
+ * Copyright (C) 2015-present, Envox d.o.o.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+ 
+#pragma once
+
+namespace eez {
+namespace psu {
+/// LIST sequencer.
+///
+/// Every channel has its own list of voltage, current and dwell values.
+/// When the list is started all entries are converted to the (calibrated) DAC codes,
+/// so the playback itself, driven by the hardware timer on Arduino Due or polled
+/// from the main loop on Arduino Mega, only writes precomputed codes to the DAC.
+namespace list {
+
+/// Statistics of the list execution, reported by DIAG:LIST?.
+struct Statistics {
+    /// Number of steps executed since the list was started.
+    uint32_t num_steps;
+    /// Max. and sum of the differences (in microseconds) between
+    /// the scheduled and the actual step start time.
+    uint32_t max_error;
+    uint32_t sum_error;
+    /// micros() when the list was started and when the last step was executed.
+    uint32_t start_time;
+    uint32_t last_step_time;
+};
+
+void tick(unsigned long tick_usec);
+
+/// Clear lists and stop the execution (*RST).
+void resetChannelList(Channel &channel);
+
+void setVoltageList(Channel &channel, const float *list, uint16_t length);
+const float *getVoltageList(Channel &channel, uint16_t *length);
+
+void setCurrentList(Channel &channel, const float *list, uint16_t length);
+const float *getCurrentList(Channel &channel, uint16_t *length);
+
+void setDwellList(Channel &channel, const float *list, uint16_t length);
+const float *getDwellList(Channel &channel, uint16_t *length);
+
+/// Set how many times the list is executed, 0 means infinity.
+void setListCount(Channel &channel, uint16_t count);
+uint16_t getListCount(Channel &channel);
+
+/// Check the lists, precompute DAC codes and start execution.
+/// Returns false and SCPI error code in err if lists can't be executed.
+bool start(Channel &channel, int16_t &err);
+void stop(Channel &channel);
+bool isRunning(Channel &channel);
+
+/// Index of the currently executed step.
+uint16_t getCurrentStep(Channel &channel);
+
+const Statistics &getStatistics(Channel &channel);
+
+}
+}
+} // namespace eez::psu::list
@@ -0,0 +1,91 @@
+/*
+ * EEZ PSU Firmware
+ * Copyright (C) 2015-present, Envox d.o.o.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+ 
+#include "psu.h"
+#include "long_operation.h"
+#include "scpi_regs.h"
+
+namespace eez {
+namespace psu {
+namespace long_operation {
+
+static Step g_step;
+static uint16_t g_numSteps;
+static bool g_opcPending;
+
+static void finish() {
+    g_step = 0;
+
+    if (g_opcPending) {
+        g_opcPending = false;
+        setEsrBits(ESR_OPC);
+    }
+}
+
+static void doStep() {
+    ++g_numSteps;
+    if (!g_step()) {
+        finish();
+    }
+}
+
+void start(Step step) {
+    waitForCompletion();
+
+    g_step = step;
+    g_numSteps = 0;
+}
+
+bool isBusy() {
+    return g_step != 0;
+}
+
+uint16_t getNumSteps() {
+    return g_numSteps;
+}
+
+void tick(unsigned long tick_usec) {
+    while (g_step) {
+        doStep();
+
+        if (micros() - tick_usec >= LONG_OPERATION_TICK_TIME) {
+            break;
+        }
+    }
+}
+
+bool setOpcWhenComplete() {
+    if (!g_step) {
+        return false;
+    }
+
+    g_opcPending = true;
+    return true;
+}
+
+void waitForCompletion() {
+    while (g_step) {
+        doStep();
+
+        psu::tickWhileWaiting();
+    }
+}
+
+}
+}
+} // namespace eez::psu::long_operation
@@ -0,0 +1,57 @@
+/*
+ * EEZ PSU Firmware
+ * Copyright (C) 2015-present, Envox d.o.o.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+ 
+#pragma once
+
+namespace eez {
+namespace psu {
+/// Cooperative execution of the long operations.
+///
+/// Operation which would block the main loop for too long (for example,
+/// writing many EEPROM pages) is split in steps, each doing a bounded amount
+/// of work. Steps are executed from the main loop, LONG_OPERATION_TICK_TIME
+/// per iteration, so the watchdog is pulsed and the outputs are measured and
+/// protected while the operation is in progress.
+namespace long_operation {
+
+/// Do the next step of the operation. Returns true if there is more work to do.
+typedef bool (*Step)();
+
+/// Start the operation. Operation already in progress is completed first.
+void start(Step step);
+
+/// Is there an operation in progress?
+bool isBusy();
+
+/// Number of steps done in the current (or the last) operation.
+uint16_t getNumSteps();
+
+/// Execute the steps of the operation in progress.
+void tick(unsigned long tick_usec);
+
+/// Set OPC bit in ESR when the operation is completed (*OPC).
+/// Returns false if there is no operation in progress.
+bool setOpcWhenComplete();
+
+/// Complete the operation in progress, while keeping the watchdog,
+/// measurement and protection alive (*WAI and *OPC?).
+void waitForCompletion();
+
+}
+}
+} // namespace eez::psu::long_operation
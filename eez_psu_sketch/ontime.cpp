@@ -90,10 +90,14 @@ void Counter::tick(unsigned long tick_usec) {
 	}
 
 	if (writeInterval.test(tick_usec)) {
-		persist_conf::writeTotalOnTime(getType(), getTotalTime());
+		write();
 	}
 }
 
+void Counter::write() {
+	persist_conf::writeTotalOnTime(getType(), getTotalTime());
+}
+
 unsigned long Counter::getTotalTime() {
 	return totalTime + getLastTime();
 }
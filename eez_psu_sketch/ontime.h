@@ -44,6 +44,8 @@ public:
 
 	void init();
 	void tick(unsigned long tick_usec);
+	/// Write the total time to EEPROM now.
+	void write();
 
 	unsigned long getTotalTime();
 	unsigned long getLastTime();
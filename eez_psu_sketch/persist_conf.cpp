@@ -20,6 +20,7 @@
 #include "eeprom.h"
 #include "event_queue.h"
 #include "profile.h"
+#include "long_operation.h"
 
 namespace eez {
 namespace psu {
@@ -32,22 +33,38 @@ static const uint16_t PERSIST_CONF_START_ADDRESS = eeprom::EEPROM_START_ADDRESS;
 enum PersistConfSection {
     PERSIST_CONF_BLOCK_DEVICE,
     PERSIST_CONF_BLOCK_CH_CAL,
+    PERSIST_CONF_BLOCK_PROFILE_DIRECTORY,
     PERSIST_CONF_BLOCK_FIRST_PROFILE,
 };
 
 ////////////////////////////////////////////////////////////////////////////////
 
-static const uint16_t DEV_CONF_VERSION = 0x0008L;
+static const uint16_t DEV_CONF_VERSION = 0x0009L;
 static const uint16_t CH_CAL_CONF_VERSION = 0x0003L;
-static const uint16_t PROFILE_VERSION = 0x0004L;
+static const uint16_t PROFILE_VERSION = 0x0005L;
+static const uint16_t PROFILE_DIRECTORY_VERSION = 0x0001L;
+static const uint16_t POWER_FAIL_RECORD_VERSION = 0x0001L;
 
 static const uint16_t PERSIST_CONF_DEVICE_ADDRESS = 1024;
 
 static const uint16_t PERSIST_CONF_CH_CAL_ADDRESS = 2048;
 static const uint16_t PERSIST_CONF_CH_CAL_BLOCK_SIZE = 512;
 
-static const uint16_t PERSIST_CONF_FIRST_PROFILE_ADDRESS = 4096;
-static const uint16_t PERSIST_CONF_PROFILE_BLOCK_SIZE = 1024;
+static const uint16_t PERSIST_CONF_PROFILE_DIRECTORY_ADDRESS = 4096;
+static const uint16_t PERSIST_CONF_PROFILE_DIRECTORY_SIZE = 2560;
+
+static const uint16_t PERSIST_CONF_FIRST_PROFILE_ADDRESS = PERSIST_CONF_PROFILE_DIRECTORY_ADDRESS + PERSIST_CONF_PROFILE_DIRECTORY_SIZE;
+static const uint16_t PERSIST_CONF_PROFILE_BLOCK_SIZE = 192;
+static const uint16_t PERSIST_CONF_PROFILE_PAGE_SIZE = 64;
+
+/// Profile name is kept in the profile directory, everything before it is stored in the profile block.
+static const uint16_t PROFILE_STORED_SIZE = offsetof(profile::Parameters, name);
+
+#ifdef EEZ_PSU_ARDUINO_MEGA
+static const int NUM_PROFILE_SHADOWS = 1; // only auto-saved profile 0, RAM is scarce
+#else
+static const int NUM_PROFILE_SHADOWS = NUM_PROFILE_LOCATIONS < 10 ? NUM_PROFILE_LOCATIONS : 10;
+#endif
 
 static const uint32_t ONTIME_MAGIC = 0xA7F31B3CL;
 
@@ -55,6 +72,113 @@ static const uint32_t ONTIME_MAGIC = 0xA7F31B3CL;
 
 DeviceConfiguration dev_conf;
 
+/// RAM copy of the profile image last read from or written to EEPROM.
+struct ProfileShadow {
+    bool valid;
+    uint8_t image[PROFILE_STORED_SIZE];
+};
+
+static ProfileShadow g_profileShadows[NUM_PROFILE_SHADOWS];
+
+/// Profile directory entry. There is one for every profile location,
+/// so the profile catalog is read without reading the profiles.
+struct ProfileDirectoryEntry {
+    BlockHeader header;
+    uint32_t profile_checksum; // checksum of the profile block described by this entry
+    bool is_valid;
+    char name[PROFILE_NAME_MAX_LENGTH + 1];
+};
+
+static_assert(PROFILE_STORED_SIZE <= PERSIST_CONF_PROFILE_BLOCK_SIZE, "Profile doesn't fit in the profile block");
+static_assert(NUM_PROFILE_LOCATIONS * sizeof(ProfileDirectoryEntry) <= PERSIST_CONF_PROFILE_DIRECTORY_SIZE, "Too many profile locations for the profile directory");
+static_assert(PERSIST_CONF_FIRST_PROFILE_ADDRESS + NUM_PROFILE_LOCATIONS * PERSIST_CONF_PROFILE_BLOCK_SIZE <= eeprom::EEPROM_EVENT_QUEUE_START_ADDRESS, "Too many profile locations");
+
+#ifndef EEZ_PSU_ARDUINO_MEGA
+// RAM copy of the whole profile directory, on Arduino Mega entries are read on demand
+static ProfileDirectoryEntry g_profileDirectory[NUM_PROFILE_LOCATIONS];
+static bool g_profileDirectoryLoaded;
+#endif
+
+/// Profile layout up to PROFILE_VERSION 4: 10 locations in 1024 bytes blocks
+/// starting at 4096, structures not packed and the name stored after is_valid.
+namespace v4 {
+
+static const uint16_t PROFILE_VERSION = 0x0004L;
+static const uint16_t PROFILE_ADDRESS = 4096;
+static const uint16_t PROFILE_BLOCK_SIZE = 1024;
+static const int NUM_LOCATIONS = 10;
+
+struct ChannelParameters {
+    unsigned flags; // same size and alignment as profile::ChannelFlags when not packed
+    float u_set;
+    float u_step;
+    float u_limit;
+    float u_delay;
+    float u_level;
+    float i_set;
+    float i_step;
+    float i_limit;
+    float i_delay;
+    float p_limit;
+    float p_delay;
+    float p_level;
+#ifdef EEZ_PSU_SIMULATOR
+    bool load_enabled;
+    float load;
+    float voltProgExt;
+#endif
+};
+
+struct ProtectionConfiguration {
+    int8_t sensor;
+    float delay;
+    float level;
+    bool state;
+};
+
+struct Parameters {
+    BlockHeader header;
+    bool is_valid;
+    char name[PROFILE_NAME_MAX_LENGTH + 1];
+    bool power_is_up;
+    ChannelParameters channels[CH_MAX];
+    ProtectionConfiguration temp_prot[temp_sensor::MAX_NUM_TEMP_SENSORS];
+};
+
+}
+
+/// Device configuration before the telemetry settings were added.
+namespace v8 {
+
+static const uint16_t DEV_CONF_VERSION = 0x0008L;
+
+struct DeviceConfiguration {
+    BlockHeader header;
+    char serialNumber[7 + 1];
+    char calibration_password[PASSWORD_MAX_LENGTH + 1];
+    DeviceFlags flags; // telemetryEnabled was reserved
+    uint8_t date_year;
+    uint8_t date_month;
+    uint8_t date_day;
+    uint8_t time_hour;
+    uint8_t time_minute;
+    uint8_t time_second;
+    int16_t time_zone;
+    int8_t profile_auto_recall_location;
+    int8_t touch_screen_cal_orientation;
+    int16_t touch_screen_cal_tlx;
+    int16_t touch_screen_cal_tly;
+    int16_t touch_screen_cal_brx;
+    int16_t touch_screen_cal_bry;
+    int16_t touch_screen_cal_trx;
+    int16_t touch_screen_cal_try;
+#ifdef EEZ_PSU_SIMULATOR
+    bool gui_opened;
+#endif // EEZ_PSU_SIMULATOR
+};
+
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 uint32_t calc_checksum(const BlockHeader *block, uint16_t size) {
@@ -78,6 +202,7 @@ uint16_t get_address(PersistConfSection section, Channel *channel = 0) {
     switch (section) {
     case PERSIST_CONF_BLOCK_DEVICE:  return PERSIST_CONF_DEVICE_ADDRESS;
     case PERSIST_CONF_BLOCK_CH_CAL:  return PERSIST_CONF_CH_CAL_ADDRESS + (channel->index - 1) * PERSIST_CONF_CH_CAL_BLOCK_SIZE;
+    case PERSIST_CONF_BLOCK_PROFILE_DIRECTORY: return PERSIST_CONF_PROFILE_DIRECTORY_ADDRESS;
     case PERSIST_CONF_BLOCK_FIRST_PROFILE: return PERSIST_CONF_FIRST_PROFILE_ADDRESS;
     }
     return -1;
@@ -87,6 +212,17 @@ uint16_t get_profile_address(int location) {
     return get_address(PERSIST_CONF_BLOCK_FIRST_PROFILE) + location * PERSIST_CONF_PROFILE_BLOCK_SIZE;
 }
 
+uint16_t get_profile_directory_entry_address(int location) {
+    return get_address(PERSIST_CONF_BLOCK_PROFILE_DIRECTORY) + location * sizeof(ProfileDirectoryEntry);
+}
+
+ProfileShadow *get_profile_shadow(int location) {
+    if (location >= 0 && location < NUM_PROFILE_SHADOWS) {
+        return &g_profileShadows[location];
+    }
+    return 0;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 void initDevice() {
@@ -118,6 +254,11 @@ void initDevice() {
 
 	dev_conf.flags.channelDisplayedValues = 0;
 
+    dev_conf.flags.telemetryEnabled = 0;
+    dev_conf.telemetry_ip_address = 0;
+    dev_conf.telemetry_port = TELEMETRY_DEFAULT_PORT;
+    dev_conf.telemetry_interval = TELEMETRY_DEFAULT_INTERVAL;
+
 #ifdef EEZ_PSU_SIMULATOR
     dev_conf.gui_opened = true;
     dev_conf.flags.ethernetEnabled = 1;
@@ -126,10 +267,48 @@ void initDevice() {
 #endif // EEZ_PSU_SIMULATOR
 }
 
+/// Convert the v8 device configuration, if there is one, new telemetry settings get the defaults.
+bool convertDevice() {
+    v8::DeviceConfiguration old;
+    eeprom::read((uint8_t *)&old, sizeof(old), get_address(PERSIST_CONF_BLOCK_DEVICE));
+    if (!check_block(&old.header, sizeof(old), v8::DEV_CONF_VERSION)) {
+        return false;
+    }
+
+    initDevice();
+
+    strcpy(dev_conf.serialNumber, old.serialNumber);
+    strcpy(dev_conf.calibration_password, old.calibration_password);
+    dev_conf.flags = old.flags;
+    dev_conf.flags.telemetryEnabled = 0;
+    dev_conf.date_year = old.date_year;
+    dev_conf.date_month = old.date_month;
+    dev_conf.date_day = old.date_day;
+    dev_conf.time_hour = old.time_hour;
+    dev_conf.time_minute = old.time_minute;
+    dev_conf.time_second = old.time_second;
+    dev_conf.time_zone = old.time_zone;
+    dev_conf.profile_auto_recall_location = old.profile_auto_recall_location;
+    dev_conf.touch_screen_cal_orientation = old.touch_screen_cal_orientation;
+    dev_conf.touch_screen_cal_tlx = old.touch_screen_cal_tlx;
+    dev_conf.touch_screen_cal_tly = old.touch_screen_cal_tly;
+    dev_conf.touch_screen_cal_brx = old.touch_screen_cal_brx;
+    dev_conf.touch_screen_cal_bry = old.touch_screen_cal_bry;
+    dev_conf.touch_screen_cal_trx = old.touch_screen_cal_trx;
+    dev_conf.touch_screen_cal_try = old.touch_screen_cal_try;
+#ifdef EEZ_PSU_SIMULATOR
+    dev_conf.gui_opened = old.gui_opened;
+#endif // EEZ_PSU_SIMULATOR
+
+    saveDevice();
+
+    return true;
+}
+
 void loadDevice() {
     if (eeprom::test_result == psu::TEST_OK) {
         eeprom::read((uint8_t *)&dev_conf, sizeof(DeviceConfiguration), get_address(PERSIST_CONF_BLOCK_DEVICE));
-        if (!check_block((BlockHeader *)&dev_conf, sizeof(DeviceConfiguration), DEV_CONF_VERSION)) {
+        if (!check_block((BlockHeader *)&dev_conf, sizeof(DeviceConfiguration), DEV_CONF_VERSION) && !convertDevice()) {
             initDevice();
         } else {
 			if (dev_conf.flags.channelDisplayedValues < 0 || dev_conf.flags.channelDisplayedValues > 2) {
@@ -272,7 +451,11 @@ bool isProfileAutoRecallEnabled() {
 bool setProfileAutoRecallLocation(int location) {
     dev_conf.profile_auto_recall_location = (int8_t)location;
     if (saveDevice()) {
-		event_queue::pushEvent(event_queue::EVENT_INFO_DEFAULE_PROFILE_CHANGED_TO_0 + location);
+		if (location <= event_queue::EVENT_INFO_DEFAULE_PROFILE_CHANGED_TO_9 - event_queue::EVENT_INFO_DEFAULE_PROFILE_CHANGED_TO_0) {
+			event_queue::pushEvent(event_queue::EVENT_INFO_DEFAULE_PROFILE_CHANGED_TO_0 + location);
+		} else {
+			event_queue::pushEvent(event_queue::EVENT_INFO_DEFAULE_PROFILE_CHANGED);
+		}
 		return true;
 	}
     return false;
@@ -292,6 +475,14 @@ void loadChannelCalibration(Channel *channel) {
         eeprom::read((uint8_t *)&channel->cal_conf, sizeof(Channel::CalibrationConfiguration), get_address(PERSIST_CONF_BLOCK_CH_CAL, channel));
         if (!check_block((BlockHeader *)&channel->cal_conf, sizeof(Channel::CalibrationConfiguration), CH_CAL_CONF_VERSION)) {
             channel->clearCalibrationConf();
+        } else {
+            // protection thresholds can't be precomputed for such calibration, treat it as missing
+            if (channel->cal_conf.flags.u_cal_params_exists && !Channel::isCalibrationValueMonotonic(channel->cal_conf.u)) {
+                channel->cal_conf.flags.u_cal_params_exists = 0;
+            }
+            if (channel->cal_conf.flags.i_cal_params_exists && !Channel::isCalibrationValueMonotonic(channel->cal_conf.i)) {
+                channel->cal_conf.flags.i_cal_params_exists = 0;
+            }
         }
     }
     else {
@@ -303,16 +494,298 @@ bool saveChannelCalibration(Channel *channel) {
     return save((BlockHeader *)&channel->cal_conf, sizeof(Channel::CalibrationConfiguration), get_address(PERSIST_CONF_BLOCK_CH_CAL, channel), CH_CAL_CONF_VERSION);
 }
 
+bool load_profile_directory_entry(int location, ProfileDirectoryEntry *entry) {
+    if (eeprom::test_result != psu::TEST_OK) {
+        return false;
+    }
+
+#ifdef EEZ_PSU_ARDUINO_MEGA
+    eeprom::read((uint8_t *)entry, sizeof(ProfileDirectoryEntry), get_profile_directory_entry_address(location));
+#else
+    if (!g_profileDirectoryLoaded) {
+        eeprom::read((uint8_t *)g_profileDirectory, sizeof(g_profileDirectory), get_profile_directory_entry_address(0));
+        g_profileDirectoryLoaded = true;
+    }
+    memcpy(entry, g_profileDirectory + location, sizeof(ProfileDirectoryEntry));
+#endif
+
+    return check_block(&entry->header, sizeof(ProfileDirectoryEntry), PROFILE_DIRECTORY_VERSION);
+}
+
+bool save_profile_directory_entry(int location, ProfileDirectoryEntry *entry) {
+    ProfileDirectoryEntry oldEntry;
+    if (load_profile_directory_entry(location, &oldEntry) &&
+        oldEntry.profile_checksum == entry->profile_checksum &&
+        oldEntry.is_valid == entry->is_valid &&
+        memcmp(oldEntry.name, entry->name, sizeof(entry->name)) == 0)
+    {
+        return true;
+    }
+
+    bool result = save(&entry->header, sizeof(ProfileDirectoryEntry), get_profile_directory_entry_address(location), PROFILE_DIRECTORY_VERSION);
+
+#ifndef EEZ_PSU_ARDUINO_MEGA
+    if (result) {
+        memcpy(g_profileDirectory + location, entry, sizeof(ProfileDirectoryEntry));
+    } else {
+        g_profileDirectoryLoaded = false;
+    }
+#endif
+
+    return result;
+}
+
+/// Describe the written profile in the profile directory, this completes the profile save.
+/// Profile block is overwritten in place, so if the save is interrupted before this,
+/// the profile checksum doesn't match the directory entry and the location is not loaded:
+/// the old profile is lost, but a partially written one is never recalled.
+bool save_profile_directory_entry(int location, const profile::Parameters *profile) {
+    ProfileDirectoryEntry entry;
+    memset(&entry, 0, sizeof(entry));
+    entry.profile_checksum = profile->header.checksum;
+    entry.is_valid = profile->is_valid;
+    strncpy(entry.name, profile->name, PROFILE_NAME_MAX_LENGTH);
+    return save_profile_directory_entry(location, &entry);
+}
+
 bool loadProfile(int location, profile::Parameters *profile) {
     if (eeprom::test_result == psu::TEST_OK) {
-        eeprom::read((uint8_t *)profile, sizeof(profile::Parameters), get_profile_address(location));
-        return check_block((BlockHeader *)profile, sizeof(profile::Parameters), PROFILE_VERSION);
+        // profile shadow image is consistent only when no profile is being saved
+        long_operation::waitForCompletion();
+
+        ProfileDirectoryEntry entry;
+        if (!load_profile_directory_entry(location, &entry)) {
+            return false;
+        }
+
+        ProfileShadow *shadow = get_profile_shadow(location);
+        if (shadow && shadow->valid) {
+            memcpy(profile, shadow->image, PROFILE_STORED_SIZE);
+        } else {
+            eeprom::read((uint8_t *)profile, PROFILE_STORED_SIZE, get_profile_address(location));
+            if (shadow) {
+                memcpy(shadow->image, profile, PROFILE_STORED_SIZE);
+                shadow->valid = true;
+            }
+        }
+
+        if (!check_block((BlockHeader *)profile, PROFILE_STORED_SIZE, PROFILE_VERSION) ||
+            profile->header.checksum != entry.profile_checksum)
+        {
+            return false;
+        }
+
+        profile->is_valid = entry.is_valid;
+        memcpy(profile->name, entry.name, sizeof(profile->name));
+        profile->name[PROFILE_NAME_MAX_LENGTH] = 0;
+
+        return true;
     }
     return false;
 }
 
+bool beginSaveProfile(int location, profile::Parameters *profile) {
+    ProfileShadow *shadow = get_profile_shadow(location);
+    if (!shadow || eeprom::test_result != psu::TEST_OK) {
+        return false;
+    }
+
+    profile->header.version = PROFILE_VERSION;
+    profile->header.checksum = calc_checksum((BlockHeader *)profile, PROFILE_STORED_SIZE);
+
+    if (!shadow->valid) {
+        eeprom::read(shadow->image, PROFILE_STORED_SIZE, get_profile_address(location));
+        shadow->valid = true;
+    }
+
+    return true;
+}
+
+bool saveProfilePage(int location, const profile::Parameters *profile, uint16_t &offset) {
+    ProfileShadow *shadow = get_profile_shadow(location);
+
+    // write only those EEPROM pages that differ from the last written image
+    const uint8_t *image = (const uint8_t *)profile;
+    for (; offset < PROFILE_STORED_SIZE; offset += PERSIST_CONF_PROFILE_PAGE_SIZE) {
+        uint16_t size = min((uint16_t)(PROFILE_STORED_SIZE - offset), PERSIST_CONF_PROFILE_PAGE_SIZE);
+        if (memcmp(image + offset, shadow->image + offset, size) != 0) {
+            if (!eeprom::write(image + offset, size, get_profile_address(location) + offset)) {
+                shadow->valid = false;
+                return false;
+            }
+            memcpy(shadow->image + offset, image + offset, size);
+            offset += PERSIST_CONF_PROFILE_PAGE_SIZE;
+            if (offset < PROFILE_STORED_SIZE) {
+                return true;
+            }
+            break;
+        }
+    }
+
+    offset = sizeof(profile::Parameters);
+
+    return save_profile_directory_entry(location, profile);
+}
+
 bool saveProfile(int location, profile::Parameters *profile) {
-    return save((BlockHeader *)profile, sizeof(profile::Parameters), get_profile_address(location), PROFILE_VERSION);
+    long_operation::waitForCompletion();
+
+    if (!beginSaveProfile(location, profile)) {
+        return save((BlockHeader *)profile, PROFILE_STORED_SIZE, get_profile_address(location), PROFILE_VERSION) &&
+            save_profile_directory_entry(location, profile);
+    }
+
+    uint16_t offset = 0;
+    while (offset < sizeof(profile::Parameters)) {
+        if (!saveProfilePage(location, profile, offset)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+#ifndef EEZ_PSU_ARDUINO_MEGA
+
+static void convertProfile(const v4::Parameters &old, profile::Parameters &profile) {
+    memset(&profile, 0, sizeof(profile));
+
+    profile.is_valid = old.is_valid;
+    memcpy(profile.name, old.name, sizeof(profile.name));
+    profile.name[PROFILE_NAME_MAX_LENGTH] = 0;
+    profile.power_is_up = old.power_is_up;
+
+    for (int i = 0; i < CH_MAX; ++i) {
+        const v4::ChannelParameters &oldChannel = old.channels[i];
+        profile::ChannelParameters &channel = profile.channels[i];
+
+        // flags are in the low bits, both Arduino Due and the simulator hosts are little endian
+        memcpy(&channel.flags, &oldChannel.flags, sizeof(channel.flags));
+        channel.u_set = oldChannel.u_set;
+        channel.u_step = oldChannel.u_step;
+        channel.u_limit = oldChannel.u_limit;
+        channel.u_delay = oldChannel.u_delay;
+        channel.u_level = oldChannel.u_level;
+        channel.i_set = oldChannel.i_set;
+        channel.i_step = oldChannel.i_step;
+        channel.i_limit = oldChannel.i_limit;
+        channel.i_delay = oldChannel.i_delay;
+        channel.p_limit = oldChannel.p_limit;
+        channel.p_delay = oldChannel.p_delay;
+        channel.p_level = oldChannel.p_level;
+#ifdef EEZ_PSU_SIMULATOR
+        channel.load_enabled = oldChannel.load_enabled;
+        channel.load = oldChannel.load;
+        channel.voltProgExt = oldChannel.voltProgExt;
+#endif
+    }
+
+    for (int i = 0; i < temp_sensor::MAX_NUM_TEMP_SENSORS; ++i) {
+        profile.temp_prot[i].sensor = old.temp_prot[i].sensor;
+        profile.temp_prot[i].delay = old.temp_prot[i].delay;
+        profile.temp_prot[i].level = old.temp_prot[i].level;
+        profile.temp_prot[i].state = old.temp_prot[i].state;
+    }
+}
+
+#endif
+
+void initProfiles() {
+    if (eeprom::test_result != psu::TEST_OK) {
+        return;
+    }
+
+    ProfileDirectoryEntry entry;
+    for (int location = 0; location < NUM_PROFILE_LOCATIONS; ++location) {
+        if (load_profile_directory_entry(location, &entry)) {
+            // profile directory exists
+            return;
+        }
+    }
+
+    // v4 profiles overlap the profile directory and the profile blocks,
+    // so all of them are read before anything is written
+    bool found = false;
+#ifndef EEZ_PSU_ARDUINO_MEGA
+    profile::Parameters profiles[v4::NUM_LOCATIONS];
+    bool converted[v4::NUM_LOCATIONS];
+#endif
+    for (int location = 0; location < v4::NUM_LOCATIONS; ++location) {
+        v4::Parameters old;
+        eeprom::read((uint8_t *)&old, sizeof(old), v4::PROFILE_ADDRESS + location * v4::PROFILE_BLOCK_SIZE);
+        bool valid = check_block(&old.header, sizeof(old), v4::PROFILE_VERSION);
+#ifndef EEZ_PSU_ARDUINO_MEGA
+        converted[location] = valid;
+        if (converted[location]) {
+            convertProfile(old, profiles[location]);
+        }
+#endif
+        found |= valid;
+    }
+
+    if (!found) {
+        return;
+    }
+
+#ifdef EEZ_PSU_ARDUINO_MEGA
+    // there is no RAM to hold all the old profiles
+    event_queue::pushEvent(event_queue::EVENT_WARNING_OLD_PROFILES_LOST);
+#else
+    // directory entries are written last, so the conversion is repeated on the next boot
+    // if it is interrupted before (profiles whose v4 blocks are already overwritten are lost)
+    bool result = true;
+    for (int location = 0; location < v4::NUM_LOCATIONS; ++location) {
+        if (converted[location]) {
+            result &= save(&profiles[location].header, PROFILE_STORED_SIZE, get_profile_address(location), PROFILE_VERSION);
+        }
+    }
+    for (int location = 0; location < v4::NUM_LOCATIONS; ++location) {
+        if (converted[location]) {
+            result &= save_profile_directory_entry(location, &profiles[location]);
+        }
+    }
+
+    event_queue::pushEvent(result ? event_queue::EVENT_INFO_OLD_PROFILES_CONVERTED : event_queue::EVENT_WARNING_OLD_PROFILES_LOST);
+#endif
+}
+
+bool isProfileValid(int location) {
+    ProfileDirectoryEntry entry;
+    return load_profile_directory_entry(location, &entry) && entry.is_valid;
+}
+
+bool getProfileName(int location, char *name, int count) {
+    ProfileDirectoryEntry entry;
+    if (load_profile_directory_entry(location, &entry) && entry.is_valid) {
+        strncpy(name, entry.name, count - 1);
+        name[count - 1] = 0;
+        return true;
+    }
+    name[0] = 0;
+    return false;
+}
+
+bool setProfileName(int location, const char *name, size_t nameLength) {
+    long_operation::waitForCompletion();
+
+    ProfileDirectoryEntry entry;
+    if (load_profile_directory_entry(location, &entry) && entry.is_valid) {
+        memset(entry.name, 0, sizeof(entry.name));
+        strncpy(entry.name, name, min(nameLength, (size_t)PROFILE_NAME_MAX_LENGTH));
+        return save_profile_directory_entry(location, &entry);
+    }
+    return false;
+}
+
+bool deleteProfile(int location) {
+    long_operation::waitForCompletion();
+
+    ProfileDirectoryEntry entry;
+    if (!load_profile_directory_entry(location, &entry)) {
+        memset(&entry, 0, sizeof(entry));
+    }
+    entry.is_valid = false;
+    return save_profile_directory_entry(location, &entry);
 }
 
 uint32_t readTotalOnTime(int type) {
@@ -352,6 +825,26 @@ bool writeTotalOnTime(int type, uint32_t time) {
 		eeprom::EEPROM_ONTIME_START_ADDRESS + type * eeprom::EEPROM_ONTIME_SIZE);
 }
 
+bool loadPowerFailRecord(PowerFailRecord *record) {
+    if (eeprom::test_result == psu::TEST_OK) {
+        eeprom::read((uint8_t *)record, sizeof(PowerFailRecord), eeprom::EEPROM_POWER_FAIL_START_ADDRESS);
+        return check_block((BlockHeader *)record, sizeof(PowerFailRecord), POWER_FAIL_RECORD_VERSION);
+    }
+    return false;
+}
+
+bool savePowerFailRecord(PowerFailRecord *record) {
+    return save((BlockHeader *)record, sizeof(PowerFailRecord), eeprom::EEPROM_POWER_FAIL_START_ADDRESS, POWER_FAIL_RECORD_VERSION);
+}
+
+void clearPowerFailRecord() {
+    if (eeprom::test_result == psu::TEST_OK) {
+        BlockHeader header;
+        memset(&header, 0, sizeof(BlockHeader));
+        eeprom::write((uint8_t *)&header, sizeof(BlockHeader), eeprom::EEPROM_POWER_FAIL_START_ADDRESS);
+    }
+}
+
 }
 }
 } // namespace eez::psu::persist_conf
\ No newline at end of file
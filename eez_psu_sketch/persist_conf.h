@@ -51,7 +51,7 @@ struct DeviceFlags {
     int dst : 1;
     int channelDisplayedValues : 3;
     int ethernetEnabled : 1;
-    int reserved1 : 1;
+    int telemetryEnabled : 1;
     int reserved2 : 1;
     int reserved3 : 1;
     int reserved4 : 1;
@@ -81,6 +81,9 @@ struct DeviceConfiguration {
     int16_t touch_screen_cal_bry;
     int16_t touch_screen_cal_trx;
     int16_t touch_screen_cal_try;
+    uint32_t telemetry_ip_address;
+    uint16_t telemetry_port;
+    uint16_t telemetry_interval;
 #ifdef EEZ_PSU_SIMULATOR
     bool gui_opened;
 #endif // EEZ_PSU_SIMULATOR
@@ -120,12 +123,52 @@ void toggleChannelDisplayedValues();
 void loadChannelCalibration(Channel *channel);
 bool saveChannelCalibration(Channel *channel);
 
+/// Convert the profiles stored by the firmware which used PROFILE_VERSION 4 layout,
+/// if the profile directory doesn't exist yet. On Arduino Mega old profiles are dropped
+/// (there is not enough RAM to convert them) and the warning event is pushed.
+/// Must be called once at boot, before any profile is loaded or saved.
+void initProfiles();
+
 bool loadProfile(int location, profile::Parameters *profile);
 bool saveProfile(int location, profile::Parameters *profile);
 
+/// Prepare the profile to be written in steps with saveProfilePage.
+/// Returns false if it is not possible, saveProfile should be used then.
+bool beginSaveProfile(int location, profile::Parameters *profile);
+/// Write the next EEPROM page, at or after the offset, which differs from the
+/// last written image and move the offset after it. Profile is saved when
+/// the offset reaches sizeof(profile::Parameters). Returns false on failure.
+bool saveProfilePage(int location, const profile::Parameters *profile, uint16_t &offset);
+
+/// Is the profile location used? Only the profile directory is read.
+bool isProfileValid(int location);
+/// Get the profile name from the profile directory.
+/// Returns false, and an empty name, if the location is not used.
+bool getProfileName(int location, char *name, int count);
+/// Change the profile name, only the profile directory entry is written.
+bool setProfileName(int location, const char *name, size_t nameLength);
+/// Mark the profile location as not used, only the profile directory entry is written.
+bool deleteProfile(int location);
+
 uint32_t readTotalOnTime(int type);
 bool writeTotalOnTime(int type, uint32_t time);
 
+/// Critical state written on power failure (see power_fail.h).
+/// It fits in the single EEPROM page, so it is written at once.
+struct PowerFailRecord {
+    BlockHeader header;
+    uint32_t onTime[1 + CH_MAX]; // indexed by ontime::ON_TIME_COUNTER_*
+    float u_set[CH_MAX];
+    float i_set[CH_MAX];
+    int16_t events[POWER_FAIL_MAX_EVENTS];
+    uint8_t numEvents;
+};
+
+bool loadPowerFailRecord(PowerFailRecord *record);
+bool savePowerFailRecord(PowerFailRecord *record);
+/// Invalidate the record, so the area is ready for the next power failure.
+void clearPowerFailRecord();
+
 }
 }
 } // namespace eez::psu::persist_conf
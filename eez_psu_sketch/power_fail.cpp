@@ -0,0 +1,124 @@
+/*
+ * EEZ PSU Firmware
+ * Copyright (C) 2015-present, Envox d.o.o.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+ 
+#include "psu.h"
+#include "power_fail.h"
+#include "persist_conf.h"
+#include "profile.h"
+#include "event_queue.h"
+
+namespace eez {
+namespace psu {
+namespace power_fail {
+
+static bool g_isRecordSaved;
+/// Error event of the power failure detected in the interrupt handler, 0 if none.
+static volatile int16_t g_powerFailEventId;
+
+void init() {
+    persist_conf::PowerFailRecord record;
+    if (!persist_conf::loadPowerFailRecord(&record)) {
+        return;
+    }
+
+    DebugTrace("Power fail record found");
+
+    // on-time counters
+    for (int i = 0; i < 1 + CH_MAX; ++i) {
+        if (record.onTime[i] > persist_conf::readTotalOnTime(i)) {
+            persist_conf::writeTotalOnTime(i, record.onTime[i]);
+        }
+    }
+
+    // setpoints, into the auto-saved profile as the deferred save would do it after power down
+    profile::Parameters profile;
+    if (persist_conf::loadProfile(0, &profile) && profile.is_valid) {
+        profile.power_is_up = false;
+        for (int i = 0; i < CH_NUM; ++i) {
+            if (profile.channels[i].flags.parameters_are_valid) {
+                profile.channels[i].u_set = record.u_set[i];
+                profile.channels[i].i_set = record.i_set[i];
+                profile.channels[i].flags.output_enabled = 0;
+            }
+        }
+        persist_conf::saveProfile(0, &profile);
+    }
+
+    // events
+    for (int i = 0; i < record.numEvents && i < POWER_FAIL_MAX_EVENTS; ++i) {
+        event_queue::pushEvent(record.events[i]);
+    }
+
+    persist_conf::clearPowerFailRecord();
+}
+
+void onPowerFail(int16_t eventId) {
+    if (g_isRecordSaved || g_powerFailEventId) {
+        return;
+    }
+
+    g_powerFailEventId = eventId;
+
+    for (int i = 0; i < CH_NUM; ++i) {
+        Channel::get(i).outputEnable(false);
+    }
+}
+
+static void saveRecord(int16_t eventId) {
+    persist_conf::PowerFailRecord record;
+    memset(&record, 0, sizeof(record));
+
+    record.onTime[g_powerOnTimeCounter.getType()] = g_powerOnTimeCounter.getTotalTime();
+
+    for (int i = 0; i < CH_NUM; ++i) {
+        Channel &channel = Channel::get(i);
+        record.onTime[channel.onTimeCounter.getType()] = channel.onTimeCounter.getTotalTime();
+        record.u_set[i] = channel.u.set;
+        record.i_set[i] = channel.i.set;
+    }
+
+    record.events[0] = eventId;
+    record.numEvents = 1 + event_queue::getPendingEvents(record.events + 1, POWER_FAIL_MAX_EVENTS - 1);
+
+    g_isRecordSaved = persist_conf::savePowerFailRecord(&record);
+}
+
+void tick(unsigned long tick_usec) {
+    noInterrupts();
+    int16_t eventId = g_powerFailEventId;
+    g_powerFailEventId = 0;
+    interrupts();
+
+    if (eventId) {
+        // EEPROM is written here, in the main loop, and not in the interrupt handler
+        saveRecord(eventId);
+        psu::generateError(eventId);
+        psu::powerDownBySensor();
+        return;
+    }
+
+    // power survived and the regular save is completed, record is not needed anymore
+    if (g_isRecordSaved && !profile::isSavePending()) {
+        persist_conf::clearPowerFailRecord();
+        g_isRecordSaved = false;
+    }
+}
+
+}
+}
+} // namespace eez::psu::power_fail
@@ -0,0 +1,46 @@
+/*
+ * EEZ PSU Firmware
+ * Copyright (C) 2015-present, Envox d.o.o.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+ 
+#pragma once
+
+namespace eez {
+namespace psu {
+/// Fast save of the critical state on power failure.
+///
+/// When PWRGOOD drops, outputs are switched off and then, in the next main loop tick,
+/// on-time counters, voltage and current setpoints and the not yet written events
+/// are written, before anything else, in a single
+/// EEPROM page which is kept cleared (invalid) during the normal operation.
+/// If the regular save (profile, events) completes while there is still power,
+/// the record is cleared again. Otherwise, the record is found and merged at the next boot.
+namespace power_fail {
+
+/// Merge the record left by the last power failure, if any.
+/// Must be called after event_queue::init and before on-time counters are initialized.
+void init();
+
+/// Called when PWRGOOD drops (usually from the interrupt handler), eventId is the error
+/// event caused by it. Only switches the outputs off, the record is saved, the error
+/// generated and PSU powered down from tick.
+void onPowerFail(int16_t eventId);
+
+void tick(unsigned long tick_usec);
+
+}
+}
+} // namespace eez::psu::power_fail
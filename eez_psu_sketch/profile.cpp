@@ -21,6 +21,7 @@
 #include "persist_conf.h"
 #include "datetime.h"
 #include "event_queue.h"
+#include "long_operation.h"
 
 namespace eez {
 namespace psu {
@@ -31,13 +32,41 @@ namespace profile {
 static bool g_save_enabled = true;
 static bool g_save_profile = false;
 
+static void fillProfile(int location, char *name, Parameters *profile);
+
+#if !defined(EEZ_PSU_ARDUINO_MEGA)
+// auto-saved profile is written one EEPROM page per step
+static Parameters g_autoSaveProfile;
+static uint16_t g_autoSaveOffset;
+
+static bool autoSaveStep() {
+    if (!persist_conf::saveProfilePage(0, &g_autoSaveProfile, g_autoSaveOffset)) {
+        return false;
+    }
+    return g_autoSaveOffset < sizeof(Parameters);
+}
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////
 
 void tick(unsigned long tick_usec) {
+#if defined(EEZ_PSU_ARDUINO_MEGA)
     if (g_save_profile) {
         saveAtLocation(0);
         g_save_profile = false;
     }
+#else
+    if (g_save_profile && !long_operation::isBusy()) {
+        g_save_profile = false;
+        fillProfile(0, 0, &g_autoSaveProfile);
+        if (persist_conf::beginSaveProfile(0, &g_autoSaveProfile)) {
+            g_autoSaveOffset = 0;
+            long_operation::start(autoSaveStep);
+        } else {
+            persist_conf::saveProfile(0, &g_autoSaveProfile);
+        }
+    }
+#endif
 }
 
 void recallChannelsFromProfile(Parameters *profile) {
@@ -74,6 +103,7 @@ void recallChannelsFromProfile(Parameters *profile) {
 #endif
 
 			channel.calibrationEnable(profile->channels[i].flags.cal_enabled && channel.isCalibrationExists() ? 1 : 0);
+			channel.updateProtectionThresholds();
 			channel.flags.outputEnabled = profile->channels[i].flags.output_enabled;
 			channel.flags.senseEnabled = profile->channels[i].flags.sense_enabled;
 
@@ -122,7 +152,11 @@ bool recall(int location) {
         if (persist_conf::loadProfile(location, &profile) && profile.is_valid) {
             if (persist_conf::saveProfile(0, &profile)) {
                 if (recallFromProfile(&profile)) {
-					event_queue::pushEvent(event_queue::EVENT_INFO_RECALL_FROM_PROFILE_0 + location);
+					if (location <= event_queue::EVENT_INFO_RECALL_FROM_PROFILE_9 - event_queue::EVENT_INFO_RECALL_FROM_PROFILE_0) {
+						event_queue::pushEvent(event_queue::EVENT_INFO_RECALL_FROM_PROFILE_0 + location);
+					} else {
+						event_queue::pushEvent(event_queue::EVENT_INFO_RECALL_FROM_PROFILE);
+					}
 					return true;
 				} else {
 					return false;
@@ -140,12 +174,13 @@ bool load(int location, Parameters *profile) {
     return false;
 }
 
-void getSaveName(const Parameters *profile, char *name) {
-	if (!profile->is_valid || strncmp_P(profile->name, AUTO_NAME_PREFIX, strlen(AUTO_NAME_PREFIX)) == 0) {
+void getSaveName(int location, char *name) {
+	char currentName[PROFILE_NAME_MAX_LENGTH + 1];
+	if (!persist_conf::getProfileName(location, currentName, sizeof(currentName)) || strncmp_P(currentName, AUTO_NAME_PREFIX, strlen(AUTO_NAME_PREFIX)) == 0) {
 		strcpy_P(name, AUTO_NAME_PREFIX);
 		datetime::getDateTimeAsString(name + strlen(AUTO_NAME_PREFIX));
 	} else {
-		strcpy(name, profile->name);
+		strcpy(name, currentName);
 	}
 }
 
@@ -160,100 +195,103 @@ void save() {
     g_save_profile = true;
 }
 
+bool isSavePending() {
+    return g_save_profile || long_operation::isBusy();
+}
+
 void saveImmediately() {
     saveAtLocation(0);
 }
 
-bool saveAtLocation(int location, char *name) {
-    if (location >= 0 && location < NUM_PROFILE_LOCATIONS) {
-        Parameters currentProfile;
-        if (!persist_conf::loadProfile(location, &currentProfile)) {
-            currentProfile.is_valid = false;
-        }
-
-        Parameters profile;
+static void fillProfile(int location, char *name, Parameters *profile) {
+    // clear padding and reserved bits so unchanged settings produce identical image
+    memset(profile, 0, sizeof(Parameters));
 
-        profile.is_valid = true;
+    profile->is_valid = true;
 
-        // name
-        memset(profile.name, 0, sizeof(profile.name));
-        if (location > 0) {
-			if (name) {
-				strcpy(profile.name, name);
-			} else {
-				getSaveName(&currentProfile, profile.name);
-			}
-        }
+    // name
+    if (location > 0) {
+		if (name) {
+			strcpy(profile->name, name);
+		} else {
+			getSaveName(location, profile->name);
+		}
+    }
 
-        noInterrupts();
+    noInterrupts();
 
-        profile.power_is_up = psu::isPowerUp();
+    profile->power_is_up = psu::isPowerUp();
 
-        for (int i = 0; i < CH_MAX; ++i) {
-			if (i < CH_NUM) {
-				Channel &channel = Channel::get(i);
+    for (int i = 0; i < CH_MAX; ++i) {
+		if (i < CH_NUM) {
+			Channel &channel = Channel::get(i);
 
-				profile.channels[i].flags.parameters_are_valid = 1;
+			profile->channels[i].flags.parameters_are_valid = 1;
 
-				profile.channels[i].flags.cal_enabled = channel.isCalibrationEnabled();
-				profile.channels[i].flags.output_enabled = channel.flags.outputEnabled;
-				profile.channels[i].flags.sense_enabled = Channel::get(i).flags.senseEnabled;
+			profile->channels[i].flags.cal_enabled = channel.isCalibrationEnabled();
+			profile->channels[i].flags.output_enabled = channel.flags.outputEnabled;
+			profile->channels[i].flags.sense_enabled = Channel::get(i).flags.senseEnabled;
 
-				if (Channel::get(i).getFeatures() & CH_FEATURE_RPROG) {
-					profile.channels[i].flags.rprog_enabled = Channel::get(i).flags.rprogEnabled;
-				} else {
-					profile.channels[i].flags.rprog_enabled = 0;
-				}
+			if (Channel::get(i).getFeatures() & CH_FEATURE_RPROG) {
+				profile->channels[i].flags.rprog_enabled = Channel::get(i).flags.rprogEnabled;
+			} else {
+				profile->channels[i].flags.rprog_enabled = 0;
+			}
 
-				if (Channel::get(i).getFeatures() & CH_FEATURE_LRIPPLE) {
-					profile.channels[i].flags.lripple_auto_enabled = Channel::get(i).flags.lrippleAutoEnabled;
-				} else {
-					profile.channels[i].flags.lripple_auto_enabled = 0;
-				}
+			if (Channel::get(i).getFeatures() & CH_FEATURE_LRIPPLE) {
+				profile->channels[i].flags.lripple_auto_enabled = Channel::get(i).flags.lrippleAutoEnabled;
+			} else {
+				profile->channels[i].flags.lripple_auto_enabled = 0;
+			}
 
-				profile.channels[i].flags.u_state = Channel::get(i).prot_conf.flags.u_state;
-				profile.channels[i].flags.i_state = Channel::get(i).prot_conf.flags.i_state;
-				profile.channels[i].flags.p_state = Channel::get(i).prot_conf.flags.p_state;
+			profile->channels[i].flags.u_state = Channel::get(i).prot_conf.flags.u_state;
+			profile->channels[i].flags.i_state = Channel::get(i).prot_conf.flags.i_state;
+			profile->channels[i].flags.p_state = Channel::get(i).prot_conf.flags.p_state;
 
-				profile.channels[i].u_set = Channel::get(i).u.set;
-				profile.channels[i].u_step = Channel::get(i).u.step;
-				profile.channels[i].u_limit = Channel::get(i).u.limit;
+			profile->channels[i].u_set = Channel::get(i).u.set;
+			profile->channels[i].u_step = Channel::get(i).u.step;
+			profile->channels[i].u_limit = Channel::get(i).u.limit;
 
-				profile.channels[i].i_set = Channel::get(i).i.set;
-				profile.channels[i].i_step = Channel::get(i).i.step;
-				profile.channels[i].i_limit = Channel::get(i).i.limit;
+			profile->channels[i].i_set = Channel::get(i).i.set;
+			profile->channels[i].i_step = Channel::get(i).i.step;
+			profile->channels[i].i_limit = Channel::get(i).i.limit;
 
-				profile.channels[i].p_limit = Channel::get(i).p_limit;
+			profile->channels[i].p_limit = Channel::get(i).p_limit;
 
-				profile.channels[i].u_delay = Channel::get(i).prot_conf.u_delay;
-				profile.channels[i].u_level = Channel::get(i).prot_conf.u_level;
-				profile.channels[i].i_delay = Channel::get(i).prot_conf.i_delay;
-				profile.channels[i].p_delay = Channel::get(i).prot_conf.p_delay;
-				profile.channels[i].p_level = Channel::get(i).prot_conf.p_level;
+			profile->channels[i].u_delay = Channel::get(i).prot_conf.u_delay;
+			profile->channels[i].u_level = Channel::get(i).prot_conf.u_level;
+			profile->channels[i].i_delay = Channel::get(i).prot_conf.i_delay;
+			profile->channels[i].p_delay = Channel::get(i).prot_conf.p_delay;
+			profile->channels[i].p_level = Channel::get(i).prot_conf.p_level;
 
 #ifdef EEZ_PSU_SIMULATOR
-				profile.channels[i].load_enabled = Channel::get(i).simulator.load_enabled;
-				profile.channels[i].load = Channel::get(i).simulator.load;
-				profile.channels[i].voltProgExt = Channel::get(i).simulator.voltProgExt;
+			profile->channels[i].load_enabled = Channel::get(i).simulator.load_enabled;
+			profile->channels[i].load = Channel::get(i).simulator.load;
+			profile->channels[i].voltProgExt = Channel::get(i).simulator.voltProgExt;
 #endif
-			} else {
-				profile.channels[i].flags.parameters_are_valid = 0;
-			}
-        }
+		} else {
+			profile->channels[i].flags.parameters_are_valid = 0;
+		}
+    }
 
-		for (int i = 0; i < temp_sensor::MAX_NUM_TEMP_SENSORS; ++i) {
-			if (i < temp_sensor::NUM_TEMP_SENSORS) {
-				memcpy(profile.temp_prot + i, &temperature::sensors[i].prot_conf, sizeof(temperature::ProtectionConfiguration));
-			} else {
-				profile.temp_prot[i].sensor = i;
-				profile.temp_prot[i].delay = OTP_MAIN_DEFAULT_DELAY;
-				profile.temp_prot[i].level = OTP_MAIN_DEFAULT_LEVEL;
-				profile.temp_prot[i].state = OTP_MAIN_DEFAULT_STATE;
-			}
+	for (int i = 0; i < temp_sensor::MAX_NUM_TEMP_SENSORS; ++i) {
+		if (i < temp_sensor::NUM_TEMP_SENSORS) {
+			memcpy(profile->temp_prot + i, &temperature::sensors[i].prot_conf, sizeof(temperature::ProtectionConfiguration));
+		} else {
+			profile->temp_prot[i].sensor = i;
+			profile->temp_prot[i].delay = OTP_MAIN_DEFAULT_DELAY;
+			profile->temp_prot[i].level = OTP_MAIN_DEFAULT_LEVEL;
+			profile->temp_prot[i].state = OTP_MAIN_DEFAULT_STATE;
 		}
+	}
 
-        interrupts();
+    interrupts();
+}
 
+bool saveAtLocation(int location, char *name) {
+    if (location >= 0 && location < NUM_PROFILE_LOCATIONS) {
+        Parameters profile;
+        fillProfile(location, name, &profile);
         return persist_conf::saveProfile(location, &profile);
     }
 
@@ -263,12 +301,10 @@ bool saveAtLocation(int location, char *name) {
 bool deleteLocation(int location) {
     bool result = false;
     if (location > 0 && location < NUM_PROFILE_LOCATIONS) {
-        Parameters profile;
-        profile.is_valid = false;
         if (location == persist_conf::getProfileAutoRecallLocation()) {
             persist_conf::setProfileAutoRecallLocation(0);
         }
-        result = persist_conf::saveProfile(location, &profile);
+        result = persist_conf::deleteProfile(location);
     }
     return result;
 }
@@ -284,32 +320,21 @@ bool deleteAll() {
 
 bool isValid(int location) {
     if (location >= 0 && location < NUM_PROFILE_LOCATIONS) {
-        Parameters profile;
-        if (persist_conf::loadProfile(location, &profile)) {
-            return profile.is_valid;
-        }
+        return persist_conf::isProfileValid(location);
     }
     return false;
 }
 
 bool setName(int location, const char *name, size_t name_len) {
     if (location > 0 && location < NUM_PROFILE_LOCATIONS) {
-        Parameters profile;
-        if (persist_conf::loadProfile(location, &profile) && profile.is_valid) {
-            memset(profile.name, 0, sizeof(profile.name));
-            strncpy(profile.name, name, name_len);
-            return persist_conf::saveProfile(location, &profile);
-        }
+        return persist_conf::setProfileName(location, name, name_len);
     }
     return false;
 }
 
 void getName(int location, char *name, int count) {
 	if (location >= 0 && location < NUM_PROFILE_LOCATIONS) {
-        Parameters profile;
-        if (persist_conf::loadProfile(location, &profile) && profile.is_valid) {
-            strncpy(name, profile.name, count - 1);
-			name[count - 1] = 0;
+        if (persist_conf::getProfileName(location, name, count)) {
             return;
         }
     }
@@ -25,6 +25,9 @@ namespace psu {
 /// PSU configuration profiles (save, recall, ...).
 namespace profile {
 
+// profile is stored packed, so more profile locations fit in EEPROM
+#pragma pack(push, 1)
+
 /// Channel binary flags stored in profile.
 struct ChannelFlags {
     unsigned output_enabled : 1;
@@ -71,12 +74,16 @@ struct ChannelParameters {
 struct Parameters {
     persist_conf::BlockHeader header;
     bool is_valid;
-    char name[PROFILE_NAME_MAX_LENGTH + 1];
     bool power_is_up;
     ChannelParameters channels[CH_MAX];
     temperature::ProtectionConfiguration temp_prot[temp_sensor::MAX_NUM_TEMP_SENSORS];
+    /// Name is not stored with the profile but in the profile directory (see persist_conf),
+    /// so it must stay the last member.
+    char name[PROFILE_NAME_MAX_LENGTH + 1];
 };
 
+#pragma pack(pop)
+
 void tick(unsigned long tick_usec);
 
 void recallChannelsFromProfile(Parameters *profile);
@@ -85,10 +92,12 @@ bool recall(int location);
 
 bool load(int location, Parameters *profile);
 
-void getSaveName(const Parameters *profile, char *name);
+void getSaveName(int location, char *name);
 
 bool enableSave(bool enable);
 void save();
+/// Is the profile save requested with save() still not written?
+bool isSavePending();
 void saveImmediately();
 bool saveAtLocation(int location, char *name = 0);
 
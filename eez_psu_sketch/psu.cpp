@@ -22,6 +22,7 @@
 #if OPTION_ETHERNET
 #include "ethernet.h"
 #endif
+#include "telemetry.h"
 
 #include "bp.h"
 #include "adc.h"
@@ -36,9 +37,15 @@
 #include "eeprom.h"
 #include "calibration.h"
 #include "profile.h"
+#include "list.h"
+#include "trigger.h"
+#include "coupling.h"
+#include "ramp.h"
 #if OPTION_DISPLAY
 #include "gui.h"
 #endif
+#include "long_operation.h"
+#include "power_fail.h"
 #if EEZ_PSU_SELECTED_REVISION == EEZ_PSU_REVISION_R3B4
 #include "watchdog.h"
 #include "fan.h"
@@ -94,8 +101,6 @@ void boot() {
 
     success &= eeprom::init();
 
-	g_powerOnTimeCounter.init();
-
     persist_conf::loadDevice(); // loads global configuration parameters
 
 #if OPTION_DISPLAY
@@ -106,6 +111,9 @@ void boot() {
 	success &= datetime::init();
 
 	event_queue::init();
+	power_fail::init();
+	g_powerOnTimeCounter.init();
+	trigger::init();
 
 #if OPTION_ETHERNET
     gui::showEthernetInit();
@@ -125,6 +133,8 @@ void boot() {
         persist_conf::loadChannelCalibration(&Channel::get(i));
     }
 
+    persist_conf::initProfiles();
+
     // auto recall profile or ...
     profile::Parameters profile;
     if (persist_conf::isProfileAutoRecallEnabled() && profile::load(persist_conf::getProfileAutoRecallLocation(), &profile)) {
@@ -291,6 +301,8 @@ void powerDown() {
 
     if (!g_power_is_up) return;
 
+    trigger::abort();
+
     for (int i = 0; i < CH_NUM; ++i) {
         Channel::get(i).onPowerDown();
     }
@@ -303,6 +315,12 @@ void powerDown() {
     g_power_is_up = false;
 	g_powerOnTimeCounter.stop();
 
+	// counters are not running in standby, so write them now
+	g_powerOnTimeCounter.write();
+    for (int i = 0; i < CH_NUM; ++i) {
+        Channel::get(i).onTimeCounter.write();
+    }
+
 	event_queue::pushEvent(event_queue::EVENT_INFO_POWER_DOWN);
 
 	sound::playPowerDown();
@@ -415,6 +433,17 @@ static bool psu_reset(bool power_on) {
         temp_prot.state = OTP_MAIN_DEFAULT_STATE;
     }
 
+    // INST:COUP:TRAC NONE
+    // OUTP:PAIR NONE
+    coupling::reset();
+
+    // ABOR
+    // TRIG:SOUR IMM
+    // TRIG:DEL 0
+    // [SOUR[n]]:VOLT:TRIG
+    // [SOUR[n]]:CURR:TRIG
+    trigger::reset();
+
     // CAL[:MODE] OFF
     calibration::stop();
 
@@ -437,21 +466,6 @@ bool reset() {
     return false;
 }
 
-static bool test_channels() {
-    if (!g_power_is_up) {
-        // test is skipped
-        return true;
-    }
-
-    bool result = true;
-
-    for (int i = 0; i < CH_NUM; ++i) {
-        result &= Channel::get(i).test();
-    }
-
-    return result;
-}
-
 static bool test_shield() {
     bool result = true;
 
@@ -468,30 +482,62 @@ static bool test_shield() {
     return result;
 }
 
-bool test() {
-    bool result = true;
+// *TST? is done in steps: the shield, each channel and the fan, so the channels
+// are measured and protected and the watchdog is pulsed between them
+#if EEZ_PSU_SELECTED_REVISION == EEZ_PSU_REVISION_R3B4
+static const int TEST_NUM_STEPS = 1 + CH_NUM + 1;
+#else
+static const int TEST_NUM_STEPS = 1 + CH_NUM;
+#endif
+
+static int g_testStep;
+static bool g_testResult;
 
+static bool testStep() {
+    if (g_testStep == 0) {
+        g_testResult &= test_shield();
+    } else if (g_testStep <= CH_NUM) {
+        // channels are not tested while the power is down
+        if (g_power_is_up) {
+            g_testResult &= Channel::get(g_testStep - 1).test();
+        }
+    }
 #if EEZ_PSU_SELECTED_REVISION == EEZ_PSU_REVISION_R3B4
-	fan::test_start();
+    else {
+        g_testResult &= fan::test();
+    }
 #endif
 
-    result &= test_shield();
-    result &= test_channels();
+    return ++g_testStep < TEST_NUM_STEPS;
+}
 
+bool test() {
 #if EEZ_PSU_SELECTED_REVISION == EEZ_PSU_REVISION_R3B4
-	result &= fan::test();
+	fan::test_start();
 #endif
 
-	if (!result) {
+    g_testStep = 0;
+    g_testResult = true;
+    long_operation::start(testStep);
+    long_operation::waitForCompletion();
+
+	if (!g_testResult) {
         sound::playBeep();
     }
 
-	return result;
+	return g_testResult;
 }
 
 void tick() {
 	unsigned long tick_usec = micros();
 
+	spi_queue::tick(tick_usec);
+	// before anything else, so the power fail record is written first
+	power_fail::tick(tick_usec);
+	list::tick(tick_usec);
+	ramp::tick(tick_usec);
+	trigger::tick(tick_usec);
+
 #if CONF_DEBUG
     debug::tick(tick_usec);
 #endif
@@ -509,14 +555,20 @@ void tick() {
         Channel::get(i).tick(tick_usec);
     }
 
+    coupling::tick(tick_usec);
+
+    updateStatusRegisters();
+
     serial::tick(tick_usec);
 
 #if OPTION_ETHERNET
 	ethernet::tick(tick_usec);
+	telemetry::tick(tick_usec);
 #endif
     
 	sound::tick(tick_usec);
     profile::tick(tick_usec);
+    long_operation::tick(tick_usec);
 
 #if OPTION_DISPLAY
     gui::tick(tick_usec);
@@ -529,6 +581,20 @@ void tick() {
 #endif
 }
 
+void tickWhileWaiting() {
+    unsigned long tick_usec = micros();
+
+    spi_queue::tick(tick_usec);
+
+#if EEZ_PSU_SELECTED_REVISION == EEZ_PSU_REVISION_R3B4
+    watchdog::tick(tick_usec);
+#endif
+
+    for (int i = 0; i < CH_NUM; ++i) {
+        Channel::get(i).tick(tick_usec);
+    }
+}
+
 void setEsrBits(int bit_mask) {
     SCPI_RegSetBits(&serial::scpi_context, SCPI_REG_ESR, bit_mask);
 #if OPTION_ETHERNET
@@ -540,10 +606,23 @@ void setEsrBits(int bit_mask) {
 
 
 void setQuesBits(int bit_mask, bool on) {
-    reg_set_ques_bit(&serial::scpi_context, bit_mask, on);
+    scpi::reg_set_ques_bit(bit_mask, on);
+}
+
+void setOperBits(int bit_mask, bool on) {
+    scpi::reg_set_oper_bit(bit_mask, on);
+}
+
+void updateStatusRegisters() {
+    scpi::reg_conditions_t conditions;
+    if (!scpi::reg_get_changed_conditions(conditions)) {
+        return;
+    }
+
+    scpi::reg_update_conditions(&serial::scpi_context, conditions);
 #if OPTION_ETHERNET
 	if (ethernet::test_result == TEST_OK) {
-        reg_set_ques_bit(&ethernet::scpi_context, bit_mask, on);
+        scpi::reg_update_conditions(&ethernet::scpi_context, conditions);
 	}
 #endif
 }
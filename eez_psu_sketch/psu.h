@@ -72,9 +72,14 @@ bool reset();
 bool test();
 
 void tick();
+/// Tick only what must go on while a command waits in a loop:
+/// keep measuring and protecting the outputs.
+void tickWhileWaiting();
 
 void setEsrBits(int bit_mask);
 void setQuesBits(int bit_mask, bool on);
+void setOperBits(int bit_mask, bool on);
+void updateStatusRegisters();
 
 void generateError(int16_t error);
 
@@ -105,6 +110,7 @@ extern bool g_insideInterruptHandler;
 
 #include "debug.h"
 #include "util.h"
+#include "spi_queue.h"
 #include "channel.h"
 
 #define CHANNEL_VALUE_PRECISION powf(10.0f, FLOAT_TO_STR_PREC)
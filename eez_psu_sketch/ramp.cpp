@@ -0,0 +1,390 @@
+/*
+ * EEZ PSU Firmware
+ * Copyright (C) 2015-present, Envox d.o.o.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+ 
+#include "psu.h"
+#include "ramp.h"
+#include "calibration.h"
+#include "scpi_regs.h"
+
+#if defined (_VARIANT_ARDUINO_DUE_X_)
+// use TC1 channel 2 (TC1 channel 0 is used by the buzzer and channel 1 by the LIST sequencer)
+#define RAMP_TIMER TC1
+#define RAMP_CHNL 2
+#define RAMP_IRQ TC5_IRQn
+#endif
+
+namespace eez {
+namespace psu {
+namespace ramp {
+
+struct Ramp {
+    float from;
+    float to;
+    uint16_t from_code;
+    uint16_t to_code;
+    // 64-bit, because the slowest ramps (e.g. 50 V at 0.01 V/s, or twice that in series coupling)
+    // are longer than 2^32 us (~71.6 minutes), i.e. longer than the micros() wrap-around
+    uint64_t duration;
+    uint64_t elapsed;
+    uint32_t last_time;
+
+    // used by the timer interrupt
+    volatile bool running;
+    volatile uint16_t code;
+};
+
+struct ChannelRamp {
+    float u_slew;
+    float i_slew;
+    float soft_start_delay;
+
+    Ramp u;
+    Ramp i;
+
+    // ramp started and not yet finished in the main loop
+    bool active;
+};
+
+static ChannelRamp g_ramps[CH_MAX];
+
+static bool g_opcPending;
+
+////////////////////////////////////////////////////////////////////////////////
+
+/// Compute and return the next DAC code of the ramp.
+static uint16_t getCode(Ramp &ramp, uint32_t now) {
+    // elapsed time is accumulated, so it doesn't wrap around together with micros()
+    ramp.elapsed += (uint32_t)(now - ramp.last_time);
+    ramp.last_time = now;
+
+    if (ramp.elapsed >= ramp.duration) {
+        ramp.running = false;
+        return ramp.to_code;
+    }
+
+    return (uint16_t)(ramp.from_code + ((int32_t)ramp.to_code - (int32_t)ramp.from_code) * ((float)ramp.elapsed / ramp.duration));
+}
+
+/// Write next intermediate codes to the DAC.
+/// Called from the timer interrupt handler on Arduino Due, otherwise from the main loop.
+static void onTimer() {
+    uint32_t now = micros();
+    for (int i = 0; i < CH_NUM; ++i) {
+        ChannelRamp &channelRamp = g_ramps[i];
+
+        if (channelRamp.u.running) {
+            uint16_t code = getCode(channelRamp.u, now);
+            if (code != channelRamp.u.code) {
+                channelRamp.u.code = code;
+                Channel::get(i).dac.set_voltage_code_from_interrupt(code);
+            }
+        }
+
+        if (channelRamp.i.running) {
+            uint16_t code = getCode(channelRamp.i, now);
+            if (code != channelRamp.i.code) {
+                channelRamp.i.code = code;
+                Channel::get(i).dac.set_current_code_from_interrupt(code);
+            }
+        }
+    }
+}
+
+#if defined (_VARIANT_ARDUINO_DUE_X_)
+
+static bool g_timerStarted;
+
+static void startTimer() {
+    if (g_timerStarted) {
+        return;
+    }
+
+    pmc_set_writeprotect(false);
+    pmc_enable_periph_clk((uint32_t)RAMP_IRQ);
+    TC_Configure(RAMP_TIMER, RAMP_CHNL,
+        TC_CMR_TCCLKS_TIMER_CLOCK1 | // MCK/2
+        TC_CMR_WAVE |                // Waveform mode
+        TC_CMR_WAVSEL_UP_RC);        // Counter running up and reset when equals to RC
+    TC_SetRC(RAMP_TIMER, RAMP_CHNL, VARIANT_MCK / 2 / 1000000UL * RAMP_TIMER_PERIOD);
+
+    RAMP_TIMER->TC_CHANNEL[RAMP_CHNL].TC_IER = TC_IER_CPCS;  // RC compare interrupt
+    RAMP_TIMER->TC_CHANNEL[RAMP_CHNL].TC_IDR = ~TC_IER_CPCS;
+    NVIC_EnableIRQ(RAMP_IRQ);
+
+    TC_Start(RAMP_TIMER, RAMP_CHNL);
+    g_timerStarted = true;
+}
+
+static void stopTimer() {
+    for (int i = 0; i < CH_NUM; ++i) {
+        if (g_ramps[i].active) {
+            return;
+        }
+    }
+
+    if (g_timerStarted) {
+        TC_Stop(RAMP_TIMER, RAMP_CHNL);
+        NVIC_DisableIRQ(RAMP_IRQ);
+        g_timerStarted = false;
+    }
+}
+
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool isAnyRunning() {
+    for (int i = 0; i < CH_NUM; ++i) {
+        if (g_ramps[i].active) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void finish(ChannelRamp &channelRamp) {
+    channelRamp.active = false;
+
+#if defined (_VARIANT_ARDUINO_DUE_X_)
+    stopTimer();
+#endif
+
+    if (g_opcPending && !isAnyRunning()) {
+        g_opcPending = false;
+        setEsrBits(ESR_OPC);
+    }
+}
+
+/// Current value of the (possibly running) ramp.
+static float getValue(Ramp &ramp, float value) {
+    if (!ramp.running) {
+        return value;
+    }
+
+    noInterrupts();
+    uint64_t elapsed = ramp.elapsed + (uint32_t)(micros() - ramp.last_time);
+    interrupts();
+
+    if (elapsed >= ramp.duration) {
+        return ramp.to;
+    }
+
+    return ramp.from + (ramp.to - ramp.from) * ((float)elapsed / ramp.duration);
+}
+
+static void start(ChannelRamp &channelRamp, Ramp &ramp, float from, uint16_t from_code, float to, uint16_t to_code, float duration) {
+    noInterrupts();
+    ramp.running = false;
+    interrupts();
+
+    ramp.from = from;
+    ramp.to = to;
+    ramp.from_code = from_code;
+    ramp.to_code = to_code;
+    ramp.duration = (uint64_t)(duration * 1000000.0f);
+    ramp.code = from_code;
+    ramp.elapsed = 0;
+    ramp.last_time = micros();
+
+    ramp.running = true;
+    channelRamp.active = true;
+
+#if defined (_VARIANT_ARDUINO_DUE_X_)
+    startTimer();
+#endif
+}
+
+static bool isRampAllowed(Channel &channel) {
+    return channel.isOutputEnabled() && !channel.isRemoteProgrammingEnabled() && !calibration::isEnabled();
+}
+
+static void cancel(Ramp &ramp) {
+    noInterrupts();
+    ramp.running = false;
+    interrupts();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void tick(unsigned long tick_usec) {
+#if !defined (_VARIANT_ARDUINO_DUE_X_)
+    onTimer();
+#endif
+
+    for (int i = 0; i < CH_NUM; ++i) {
+        ChannelRamp &channelRamp = g_ramps[i];
+        if (!channelRamp.active) {
+            continue;
+        }
+
+        Channel &channel = Channel::get(i);
+        if (!channel.isOutputEnabled() || channel.isTripped()) {
+            stop(channel);
+            continue;
+        }
+
+        if (!channelRamp.u.running && !channelRamp.i.running) {
+            finish(channelRamp);
+        }
+    }
+}
+
+void resetChannel(Channel &channel) {
+    stop(channel);
+
+    ChannelRamp &channelRamp = g_ramps[channel.index - 1];
+    channelRamp.u_slew = U_SLEW_MAX;
+    channelRamp.i_slew = I_SLEW_MAX;
+    channelRamp.soft_start_delay = 0;
+}
+
+void setVoltageSlew(Channel &channel, float slew) {
+    g_ramps[channel.index - 1].u_slew = slew;
+}
+
+float getVoltageSlew(Channel &channel) {
+    return g_ramps[channel.index - 1].u_slew;
+}
+
+void setCurrentSlew(Channel &channel, float slew) {
+    g_ramps[channel.index - 1].i_slew = slew;
+}
+
+float getCurrentSlew(Channel &channel) {
+    return g_ramps[channel.index - 1].i_slew;
+}
+
+void setSoftStartDelay(Channel &channel, float delay) {
+    g_ramps[channel.index - 1].soft_start_delay = delay;
+}
+
+float getSoftStartDelay(Channel &channel) {
+    return g_ramps[channel.index - 1].soft_start_delay;
+}
+
+bool startVoltage(Channel &channel, float from, float to) {
+    ChannelRamp &channelRamp = g_ramps[channel.index - 1];
+    if (channelRamp.u_slew >= U_SLEW_MAX || !isRampAllowed(channel)) {
+        cancel(channelRamp.u);
+        return false;
+    }
+
+    // continue from the current position if previous ramp is still running
+    from = getValue(channelRamp.u, from);
+    if (from == to) {
+        cancel(channelRamp.u);
+        return false;
+    }
+
+    uint16_t from_code = channelRamp.u.running ? channelRamp.u.code : channel.getVoltageDacCode(from);
+
+    start(channelRamp, channelRamp.u, from, from_code, to, channel.getVoltageDacCode(to), fabs(to - from) / channelRamp.u_slew);
+
+    return true;
+}
+
+bool startCurrent(Channel &channel, float from, float to) {
+    ChannelRamp &channelRamp = g_ramps[channel.index - 1];
+    if (channelRamp.i_slew >= I_SLEW_MAX || !isRampAllowed(channel)) {
+        cancel(channelRamp.i);
+        return false;
+    }
+
+    // continue from the current position if previous ramp is still running
+    from = getValue(channelRamp.i, from);
+    if (from == to) {
+        cancel(channelRamp.i);
+        return false;
+    }
+
+    uint16_t from_code = channelRamp.i.running ? channelRamp.i.code : channel.getCurrentDacCode(from);
+
+    start(channelRamp, channelRamp.i, from, from_code, to, channel.getCurrentDacCode(to), fabs(to - from) / channelRamp.i_slew);
+
+    return true;
+}
+
+void onOutputEnable(Channel &channel) {
+    ChannelRamp &channelRamp = g_ramps[channel.index - 1];
+
+    float duration;
+    if (channelRamp.soft_start_delay > 0) {
+        duration = channelRamp.soft_start_delay;
+    } else if (channelRamp.u_slew < U_SLEW_MAX) {
+        duration = channel.u.set / channelRamp.u_slew;
+    } else {
+        return;
+    }
+
+    if (channel.isRemoteProgrammingEnabled() || calibration::isEnabled() || channel.u.set <= 0) {
+        return;
+    }
+
+    uint16_t from_code = channel.getVoltageDacCode(0);
+    channel.dac.set_voltage_code(from_code);
+
+    start(channelRamp, channelRamp.u, 0, from_code, channel.u.set, channel.getVoltageDacCode(channel.u.set), duration);
+}
+
+void stop(Channel &channel) {
+    ChannelRamp &channelRamp = g_ramps[channel.index - 1];
+    if (!channelRamp.active) {
+        return;
+    }
+
+    noInterrupts();
+    bool u_running = channelRamp.u.running;
+    bool i_running = channelRamp.i.running;
+    channelRamp.u.running = false;
+    channelRamp.i.running = false;
+    interrupts();
+
+    // jump to the target
+    if (u_running) {
+        channel.dac.set_voltage_code(channelRamp.u.to_code);
+    }
+    if (i_running) {
+        channel.dac.set_current_code(channelRamp.i.to_code);
+    }
+
+    finish(channelRamp);
+}
+
+bool isRunning(Channel &channel) {
+    return g_ramps[channel.index - 1].active;
+}
+
+bool setOpcWhenComplete() {
+    if (!isAnyRunning()) {
+        return false;
+    }
+
+    g_opcPending = true;
+    return true;
+}
+
+}
+}
+} // namespace eez::psu::ramp
+
+#if defined (_VARIANT_ARDUINO_DUE_X_)
+void TC5_Handler(void) {
+    TC_GetStatus(RAMP_TIMER, RAMP_CHNL);
+    eez::psu::ramp::onTimer();
+}
+#endif
@@ -0,0 +1,77 @@
+/*
+ * EEZ PSU Firmware
+ * Copyright (C) 2015-present, Envox d.o.o.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+ 
+#pragma once
+
+namespace eez {
+namespace psu {
+/// Voltage and current ramp generator.
+///
+/// If the slew rate ([SOUR[n]]:VOLT:SLEW, [SOUR[n]]:CURR:SLEW) is set, a change of
+/// the voltage or current level doesn't write the target code to the DAC at once.
+/// Instead, intermediate DAC codes are computed from the elapsed time and written by
+/// the timer interrupt on Arduino Due (or from the main loop on Arduino Mega) until
+/// the target is reached. U_SET and I_SET are set to the target immediately,
+/// so the monitoring and protection stay active during the ramp.
+///
+/// Soft-start (OUTP:DEL:ON) ramps the voltage from 0 to U_SET when the output is enabled.
+namespace ramp {
+
+void tick(unsigned long tick_usec);
+
+/// Restore *RST defaults of the channel and stop its ramps.
+void resetChannel(Channel &channel);
+
+void setVoltageSlew(Channel &channel, float slew);
+float getVoltageSlew(Channel &channel);
+
+void setCurrentSlew(Channel &channel, float slew);
+float getCurrentSlew(Channel &channel);
+
+/// Set soft-start duration in seconds, 0 means that soft-start is not used.
+void setSoftStartDelay(Channel &channel, float delay);
+float getSoftStartDelay(Channel &channel);
+
+/// Called by Channel::setVoltage after U_SET is changed from the value from to the value to.
+/// Returns true if the ramp is started, otherwise caller should write the target code to the DAC.
+bool startVoltage(Channel &channel, float from, float to);
+
+/// Called by Channel::setCurrent after I_SET is changed from the value from to the value to.
+/// Returns true if the ramp is started, otherwise caller should write the target code to the DAC.
+bool startCurrent(Channel &channel, float from, float to);
+
+/// Called by Channel::outputEnable just before the output is turned on.
+/// If soft-start is used, DAC is set to 0 V and the ramp to U_SET is started.
+void onOutputEnable(Channel &channel);
+
+/// Stop the ramps of the channel and write the target codes to the DAC.
+void stop(Channel &channel);
+
+/// Is any ramp of the channel running?
+bool isRunning(Channel &channel);
+
+/// Is any ramp of any channel running?
+bool isAnyRunning();
+
+/// Set OPC bit in ESR when all the ramps are completed (*OPC).
+/// Returns false if there is no ramp running.
+bool setOpcWhenComplete();
+
+}
+}
+} // namespace eez::psu::ramp
@@ -20,6 +20,8 @@
 #include "scpi_psu.h"
 #include "scpi_appl.h"
 
+#include "coupling.h"
+
 namespace eez {
 namespace psu {
 namespace scpi {
@@ -62,27 +64,30 @@ scpi_result_t scpi_appl_Apply(scpi_t *context) {
         call_set_current = true;
     }
 
-	if (voltage > channel->getVoltageLimit()) {
+    float u_factor = coupling::getVoltageFactor(*channel);
+    float i_factor = coupling::getCurrentFactor(*channel);
+
+	if (voltage > channel->getVoltageLimit() * u_factor) {
         SCPI_ErrorPush(context, SCPI_ERROR_VOLTAGE_LIMIT_EXCEEDED);
         return SCPI_RES_ERR;
 	}
 
-	if (call_set_current && current > channel->getCurrentLimit()) {
+	if (call_set_current && current > channel->getCurrentLimit() * i_factor) {
         SCPI_ErrorPush(context, SCPI_ERROR_CURRENT_LIMIT_EXCEEDED);
         return SCPI_RES_ERR;
 	}
 
-    if (voltage * (call_set_current ? current : channel->i.set) > channel->getPowerLimit()) {
+    if (voltage * (call_set_current ? current : channel->i.set * i_factor) > channel->getPowerLimit() * u_factor * i_factor) {
         SCPI_ErrorPush(context, SCPI_ERROR_POWER_LIMIT_EXCEEDED);
         return SCPI_RES_ERR;
     }
 
     // set voltage
-    channel->setVoltage(voltage);
+    coupling::setVoltage(*channel, voltage);
 
     // set current
     if (call_set_current) {
-        channel->setCurrent(current);
+        coupling::setCurrent(*channel, current);
     }
 
     return SCPI_RES_OK;
@@ -94,6 +99,9 @@ scpi_result_t scpi_appl_ApplyQ(scpi_t * context) {
         return SCPI_RES_ERR;
     }
 
+    float u_factor = coupling::getVoltageFactor(*channel);
+    float i_factor = coupling::getCurrentFactor(*channel);
+
     char buffer[256] = { 0 };
 
     int32_t current_or_voltage;
@@ -104,23 +112,23 @@ scpi_result_t scpi_appl_ApplyQ(scpi_t * context) {
 
         // return both current and voltage
         sprintf_P(buffer, PSTR("CH%d:"), channel->index);
-        util::strcatVoltage(buffer, channel->u.max);
+        util::strcatVoltage(buffer, channel->u.max * u_factor);
         strcat(buffer, "/");
-        util::strcatCurrent(buffer, channel->i.max);
+        util::strcatCurrent(buffer, channel->i.max * i_factor);
         strcat(buffer, ", ");
 
-        util::strcatFloat(buffer, channel->u.set);
+        util::strcatFloat(buffer, channel->u.set * u_factor);
         strcat(buffer, ", ");
-        util::strcatFloat(buffer, channel->i.set);
+        util::strcatFloat(buffer, channel->i.set * i_factor);
     }
     else {
         if (current_or_voltage == 0) {
             // return only current
-            util::strcatFloat(buffer, channel->i.set);
+            util::strcatFloat(buffer, channel->i.set * i_factor);
         }
         else {
             // return only voltage
-            util::strcatFloat(buffer, channel->u.set);
+            util::strcatFloat(buffer, channel->u.set * u_factor);
         }
     }
 
@@ -21,6 +21,7 @@
 #include "scpi_cal.h"
 
 #include "calibration.h"
+#include "coupling.h"
 
 namespace eez {
 namespace psu {
@@ -155,6 +156,11 @@ scpi_result_t scpi_cal_Mode(scpi_t * context) {
         return SCPI_RES_ERR;
     }
 
+    if (enable && coupling::getType() != coupling::TYPE_NONE) {
+        SCPI_ErrorPush(context, SCPI_ERROR_SETTINGS_CONFLICT);
+        return SCPI_RES_ERR;
+    }
+
     if (enable) {
         calibration::start(channel);
     }
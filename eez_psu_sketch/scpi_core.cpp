@@ -21,6 +21,9 @@
 #include "scpi_core.h"
 
 #include "profile.h"
+#include "trigger.h"
+#include "ramp.h"
+#include "long_operation.h"
 
 namespace eez {
 namespace psu {
@@ -48,11 +51,24 @@ scpi_result_t scpi_core_IdnQ(scpi_t * context) {
     return SCPI_CoreIdnQ(context);
 }
 
+/**
+* Implement IEEE488.2 *OPC
+*
+* If trigger is initiated, OPC bit is set when the trigger is executed.
+* If long operation (like profile save) is in progress, OPC bit is set when it is completed.
+*
+* Return SCPI_RES_OK
+*/
 scpi_result_t scpi_core_Opc(scpi_t * context) {
+    if (trigger::setOpcWhenComplete() || ramp::setOpcWhenComplete() || long_operation::setOpcWhenComplete()) {
+        return SCPI_RES_OK;
+    }
     return SCPI_CoreOpc(context);
 }
 
 scpi_result_t scpi_core_OpcQ(scpi_t * context) {
+    trigger::waitForDelay();
+    waitForPendingOperations();
     return SCPI_CoreOpcQ(context);
 }
 
@@ -78,6 +94,10 @@ scpi_result_t scpi_core_Rcl(scpi_t * context) {
 }
 
 scpi_result_t scpi_core_Rst(scpi_t * context) {
+    // FORM ASC
+    scpi_psu_t *psu_context = (scpi_psu_t *)context->user_context;
+    psu_context->format = SCPI_PSU_FORMAT_ASCII;
+
     return SCPI_CoreRst(context);
 }
 
@@ -111,9 +131,27 @@ scpi_result_t scpi_core_SreQ(scpi_t * context) {
 }
 
 scpi_result_t scpi_core_StbQ(scpi_t * context) {
+    psu::updateStatusRegisters();
     return SCPI_CoreStbQ(context);
 }
 
+/**
+* Implement IEEE488.2 *TRG
+*
+* Generates the trigger if trigger source is BUS.
+*
+* Return SCPI_RES_OK
+*/
+scpi_result_t scpi_core_Trg(scpi_t * context) {
+    int16_t err;
+    if (!trigger::generateTrigger(true, err)) {
+        SCPI_ErrorPush(context, err);
+        return SCPI_RES_ERR;
+    }
+
+    return SCPI_RES_OK;
+}
+
 /**
 * Implement IEEE488.2 *TST?
 *
@@ -129,6 +167,8 @@ scpi_result_t scpi_core_TstQ(scpi_t * context) {
 }
 
 scpi_result_t scpi_core_Wai(scpi_t * context) {
+    trigger::waitForDelay();
+    waitForPendingOperations();
     return SCPI_CoreWai(context);
 }
 
@@ -32,6 +32,7 @@
     SCPI_COMMAND("*SRE",  scpi_core_Sre) \
     SCPI_COMMAND("*SRE?", scpi_core_SreQ) \
     SCPI_COMMAND("*STB?", scpi_core_StbQ) \
+    SCPI_COMMAND("*TRG",  scpi_core_Trg) \
     SCPI_COMMAND("*TST?", scpi_core_TstQ) \
     SCPI_COMMAND("*WAI",  scpi_core_Wai) \
 
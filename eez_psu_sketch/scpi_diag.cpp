@@ -20,8 +20,10 @@
 #include "scpi_psu.h"
 #include "scpi_diag.h"
 
+#include "adc.h"
 #include "calibration.h"
 #include "devices.h"
+#include "list.h"
 #include "temperature.h"
 #if EEZ_PSU_SELECTED_REVISION == EEZ_PSU_REVISION_R3B4
 #include "fan.h"
@@ -92,6 +94,15 @@ scpi_result_t scpi_diag_InformationADCQ(scpi_t * context) {
     util::strcatCurrent(buffer, channel->i.mon);
     SCPI_ResultText(context, buffer);
 
+    sprintf_P(buffer, PSTR("RATE=%u SPS"), (unsigned)AnalogDigitalConverter::spsToRate(channel->adc.plan.sps));
+    SCPI_ResultText(context, buffer);
+
+    sprintf_P(buffer, PSTR("AVERAGE=%d"), (int)channel->adc.plan.oversampling);
+    SCPI_ResultText(context, buffer);
+
+    sprintf_P(buffer, PSTR("SAMPLE_RATE=%u SPS"), (unsigned)channel->adc.getSampleRate());
+    SCPI_ResultText(context, buffer);
+
     return SCPI_RES_OK;
 }
 
@@ -186,6 +197,12 @@ scpi_result_t scpi_diag_InformationProtectionQ(scpi_t * context) {
         util::strcatFloat(buffer, channel->prot_conf.p_level);
         strcat_P(buffer, PSTR(" W"));
         SCPI_ResultText(context, buffer);
+
+        // precomputed thresholds and measured trip latency
+        sprintf_P(buffer, PSTR("CH%d u_level_adc=%d"), channel->index, (int)channel->prot_thresholds.u_adc); SCPI_ResultText(context, buffer);
+        sprintf_P(buffer, PSTR("CH%d i_level_adc=%d"), channel->index, (int)channel->prot_thresholds.i_adc); SCPI_ResultText(context, buffer);
+        sprintf_P(buffer, PSTR("CH%d trip_latency=%lu us"), channel->index, (unsigned long)channel->prot_latency.last); SCPI_ResultText(context, buffer);
+        sprintf_P(buffer, PSTR("CH%d trip_latency_max=%lu us"), channel->index, (unsigned long)channel->prot_latency.max); SCPI_ResultText(context, buffer);
     }
 
 	for (int i = 0; i < temp_sensor::NUM_TEMP_SENSORS; ++i) {
@@ -211,6 +228,34 @@ scpi_result_t scpi_diag_InformationProtectionQ(scpi_t * context) {
     return SCPI_RES_OK;
 }
 
+scpi_result_t scpi_diag_InformationListQ(scpi_t * context) {
+    char buffer[64] = { 0 };
+
+    for (int i = 0; i < CH_NUM; ++i) {
+        Channel *channel = &Channel::get(i);
+        const list::Statistics &stats = list::getStatistics(*channel);
+
+        sprintf_P(buffer, PSTR("CH%d state=%d"), channel->index, (int)list::isRunning(*channel)); SCPI_ResultText(context, buffer);
+        sprintf_P(buffer, PSTR("CH%d step=%u"), channel->index, (unsigned)list::getCurrentStep(*channel)); SCPI_ResultText(context, buffer);
+        sprintf_P(buffer, PSTR("CH%d steps=%lu"), channel->index, (unsigned long)stats.num_steps); SCPI_ResultText(context, buffer);
+
+        unsigned long avg_error = stats.num_steps > 1 ? stats.sum_error / (stats.num_steps - 1) : 0;
+        sprintf_P(buffer, PSTR("CH%d dwell_error_avg=%lu us"), channel->index, avg_error); SCPI_ResultText(context, buffer);
+        sprintf_P(buffer, PSTR("CH%d dwell_error_max=%lu us"), channel->index, (unsigned long)stats.max_error); SCPI_ResultText(context, buffer);
+
+        float step_rate = 0;
+        if (stats.num_steps > 1 && stats.last_step_time != stats.start_time) {
+            step_rate = (stats.num_steps - 1) * 1000000.0f / (stats.last_step_time - stats.start_time);
+        }
+        sprintf_P(buffer, PSTR("CH%d step_rate="), channel->index);
+        util::strcatFloat(buffer, step_rate);
+        strcat_P(buffer, PSTR(" Hz"));
+        SCPI_ResultText(context, buffer);
+    }
+
+    return SCPI_RES_OK;
+}
+
 scpi_result_t scpi_diag_InformationTestQ(scpi_t * context) {
     char buffer[128] = { 0 };
 
@@ -0,0 +1,61 @@
+/*
+ * EEZ PSU Firmware
+ * Copyright (C) 2015-present, Envox d.o.o.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+ 
+#include "psu.h"
+#include "scpi_psu.h"
+#include "scpi_form.h"
+
+namespace eez {
+namespace psu {
+namespace scpi {
+
+////////////////////////////////////////////////////////////////////////////////
+
+static scpi_choice_def_t format_choice[] = {
+    { "ASCii", SCPI_PSU_FORMAT_ASCII },
+    { "REAL", SCPI_PSU_FORMAT_REAL },
+    SCPI_CHOICE_LIST_END /* termination of option list */
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+scpi_result_t scpi_form_Data(scpi_t * context) {
+    int32_t format;
+    if (!SCPI_ParamChoice(context, format_choice, &format, true)) {
+        return SCPI_RES_ERR;
+    }
+
+    scpi_psu_t *psu_context = (scpi_psu_t *)context->user_context;
+    psu_context->format = (uint8_t)format;
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_form_DataQ(scpi_t * context) {
+    scpi_psu_t *psu_context = (scpi_psu_t *)context->user_context;
+
+    const char *text;
+    SCPI_ChoiceToName(format_choice, psu_context->format, &text);
+    SCPI_ResultMnemonic(context, text);
+
+    return SCPI_RES_OK;
+}
+
+}
+}
+} // namespace eez::psu::scpi
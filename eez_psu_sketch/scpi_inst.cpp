@@ -21,6 +21,7 @@
 #include "scpi_cal.h"
 
 #include "calibration.h"
+#include "coupling.h"
 
 namespace eez {
 namespace psu {
@@ -28,6 +29,14 @@ namespace scpi {
 
 ////////////////////////////////////////////////////////////////////////////////
 
+static scpi_choice_def_t tracking_choice[] = {
+    { "NONE", 0 },
+    { "ALL", 1 },
+    SCPI_CHOICE_LIST_END /* termination of option list */
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
 static void select_channel(scpi_t * context, uint8_t ch) {
     scpi_psu_t *psu_context = (scpi_psu_t *)context->user_context;
     psu_context->selected_channel_index = ch;
@@ -89,6 +98,38 @@ scpi_result_t scpi_inst_NSelectQ(scpi_t * context) {
     return SCPI_RES_OK;
 }
 
+scpi_result_t scpi_inst_CoupleTracking(scpi_t * context) {
+    int32_t tracking;
+    if (!SCPI_ParamChoice(context, tracking_choice, &tracking, true)) {
+        return SCPI_RES_ERR;
+    }
+
+    coupling::Type type;
+    if (tracking) {
+        type = coupling::TYPE_TRACKED;
+    } else if (coupling::getType() == coupling::TYPE_TRACKED) {
+        type = coupling::TYPE_NONE;
+    } else {
+        return SCPI_RES_OK;
+    }
+
+    int16_t err;
+    if (!coupling::setType(type, err)) {
+        SCPI_ErrorPush(context, err);
+        return SCPI_RES_ERR;
+    }
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_inst_CoupleTrackingQ(scpi_t * context) {
+    const char *text;
+    SCPI_ChoiceToName(tracking_choice, coupling::getType() == coupling::TYPE_TRACKED ? 1 : 0, &text);
+    SCPI_ResultMnemonic(context, text);
+
+    return SCPI_RES_OK;
+}
+
 }
 }
 } // namespace eez::psu::scpi
\ No newline at end of file
@@ -20,6 +20,7 @@
 #include "scpi_psu.h"
 #include "scpi_core.h"
 #include "temperature.h"
+#include "coupling.h"
 
 namespace eez {
 namespace psu {
@@ -27,6 +28,97 @@ namespace scpi {
 
 ////////////////////////////////////////////////////////////////////////////////
 
+/// Wait until every channel with the output enabled completes
+/// U_MON/I_MON cycle which is started after this function is called.
+/// Returns false on timeout, i.e. if the samples would be stale.
+static bool wait_for_new_samples(Channel **channels, int num_channels) {
+    uint32_t last_mon_time[CH_MAX];
+    uint8_t num_cycles[CH_MAX];
+    for (int i = 0; i < num_channels; ++i) {
+        last_mon_time[i] = channels[i]->mon_time;
+        num_cycles[i] = 0;
+    }
+
+    unsigned long start = millis();
+    while (millis() - start < MEAS_TIMEOUT_MS) {
+        bool done = true;
+        for (int i = 0; i < num_channels; ++i) {
+            if (channels[i]->mon_time != last_mon_time[i]) {
+                last_mon_time[i] = channels[i]->mon_time;
+                ++num_cycles[i];
+            }
+            // first completed cycle could be started before we are called
+            if (channels[i]->isOutputEnabled() && num_cycles[i] < 2) {
+                done = false;
+            }
+        }
+
+        if (done) {
+            return true;
+        }
+
+        psu::tickWhileWaiting();
+    }
+
+    return false;
+}
+
+/// Output voltage, current and power for each channel from the same sample set.
+/// Response starts with the time (in microseconds) of the oldest sample in the set.
+/// In FORMat REAL the response is definite length block of uint32 time followed
+/// by float32 values in the native (little endian) byte order.
+static scpi_result_t result_all(scpi_t * context, bool fetch) {
+    Channel *channels[CH_MAX];
+    int num_channels;
+    if (!param_channels(context, channels, num_channels)) {
+        return SCPI_RES_ERR;
+    }
+
+    if (!fetch && !wait_for_new_samples(channels, num_channels)) {
+        SCPI_ErrorPush(context, SCPI_ERROR_EXECUTION_ERROR);
+        return SCPI_RES_ERR;
+    }
+
+    // take all the values at once, before anything is sent,
+    // mon values are updated from the ADC interrupt
+    float values[3 * CH_MAX];
+    noInterrupts();
+    uint32_t time = micros();
+    for (int i = 0; i < num_channels; ++i) {
+        Channel &channel = *channels[i];
+        if (channel.isOutputEnabled() && (int32_t)(channel.mon_time - time) < 0) {
+            time = channel.mon_time;
+        }
+        values[3 * i] = coupling::getVoltageMon(channel);
+        values[3 * i + 1] = coupling::getCurrentMon(channel);
+    }
+    interrupts();
+
+    for (int i = 0; i < num_channels; ++i) {
+        values[3 * i + 2] = values[3 * i] * values[3 * i + 1];
+    }
+
+    scpi_psu_t *psu_context = (scpi_psu_t *)context->user_context;
+    if (psu_context->format == SCPI_PSU_FORMAT_REAL) {
+        uint8_t buffer[sizeof(time) + sizeof(values)];
+        memcpy(buffer, &time, sizeof(time));
+        memcpy(buffer + sizeof(time), values, 3 * num_channels * sizeof(float));
+        SCPI_ResultArbitraryBlock(context, buffer, sizeof(time) + 3 * num_channels * sizeof(float));
+        return SCPI_RES_OK;
+    }
+
+    SCPI_ResultUInt32(context, time);
+    for (int i = 0; i < 3 * num_channels; ++i) {
+        char buffer[32] = { 0 };
+        util::strcatFloat(buffer, values[i]);
+        SCPI_ResultCharacters(context, buffer, strlen(buffer));
+    }
+
+    return SCPI_RES_OK;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 scpi_result_t scpi_meas_CurrentQ(scpi_t * context) {
     Channel *channel = param_channel(context);
     if (!channel) {
@@ -34,7 +126,7 @@ scpi_result_t scpi_meas_CurrentQ(scpi_t * context) {
     }
 
     char buffer[256] = { 0 };
-    util::strcatFloat(buffer, channel->i.mon);
+    util::strcatFloat(buffer, coupling::getCurrentMon(*channel));
     SCPI_ResultCharacters(context, buffer, strlen(buffer));
 
     return SCPI_RES_OK;
@@ -47,7 +139,7 @@ scpi_result_t scpi_meas_PowerQ(scpi_t * context) {
     }
 
     char buffer[256] = { 0 };
-    util::strcatFloat(buffer, channel->u.mon * channel->i.mon);
+    util::strcatFloat(buffer, coupling::getVoltageMon(*channel) * coupling::getCurrentMon(*channel));
     SCPI_ResultCharacters(context, buffer, strlen(buffer));
 
     return SCPI_RES_OK;
@@ -60,7 +152,7 @@ scpi_result_t scpi_meas_VoltageQ(scpi_t * context) {
     }
 
     char buffer[256] = { 0 };
-    util::strcatFloat(buffer, channel->u.mon);
+    util::strcatFloat(buffer, coupling::getVoltageMon(*channel));
     SCPI_ResultCharacters(context, buffer, strlen(buffer));
 
     return SCPI_RES_OK;
@@ -79,6 +171,14 @@ scpi_result_t scpi_meas_TemperatureQ(scpi_t * context) {
     return SCPI_RES_OK;
 }
 
+scpi_result_t scpi_meas_AllQ(scpi_t * context) {
+    return result_all(context, false);
+}
+
+scpi_result_t scpi_meas_FetchAllQ(scpi_t * context) {
+    return result_all(context, true);
+}
+
 }
 }
 } // namespace eez::psu::scpi
\ No newline at end of file
@@ -23,4 +23,6 @@
     SCPI_COMMAND("MEASure[:SCALar]:CURRent[:DC]?", scpi_meas_CurrentQ) \
     SCPI_COMMAND("MEASure[:SCALar]:POWer[:DC]?", scpi_meas_PowerQ) \
     SCPI_COMMAND("MEASure[:SCALar]:TEMPerature[:THERmistor][:DC]?", scpi_meas_TemperatureQ) \
+    SCPI_COMMAND("MEASure[:SCALar]:ALL[:DC]?", scpi_meas_AllQ) \
+    SCPI_COMMAND("FETCh[:SCALar]:ALL[:DC]?", scpi_meas_FetchAllQ) \
 
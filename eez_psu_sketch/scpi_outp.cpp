@@ -21,6 +21,8 @@
 #include "scpi_outp.h"
 
 #include "calibration.h"
+#include "coupling.h"
+#include "ramp.h"
 
 namespace eez {
 namespace psu {
@@ -28,6 +30,45 @@ namespace scpi {
 
 ////////////////////////////////////////////////////////////////////////////////
 
+static scpi_choice_def_t pair_choice[] = {
+    { "NONE", coupling::TYPE_NONE },
+    { "PARallel", coupling::TYPE_PARALLEL },
+    { "SERies", coupling::TYPE_SERIES },
+    SCPI_CHOICE_LIST_END /* termination of option list */
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+scpi_result_t scpi_outp_DelayOn(scpi_t * context) {
+    float delay;
+    if (!get_duration_param(context, delay, 0, SOFT_START_MAX_DELAY, 0)) {
+        return SCPI_RES_ERR;
+    }
+
+    Channel *channel = param_channel(context);
+    if (!channel) {
+        return SCPI_RES_ERR;
+    }
+
+    if (coupling::getType() == coupling::TYPE_NONE) {
+        ramp::setSoftStartDelay(*channel, delay);
+    } else {
+        ramp::setSoftStartDelay(Channel::get(0), delay);
+        ramp::setSoftStartDelay(Channel::get(1), delay);
+    }
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_outp_DelayOnQ(scpi_t * context) {
+    Channel *channel = param_channel(context);
+    if (!channel) {
+        return SCPI_RES_ERR;
+    }
+
+    return result_float(context, ramp::getSoftStartDelay(*channel));
+}
+
 scpi_result_t scpi_outp_ModeQ(scpi_t *context) {
     Channel *channel = param_channel(context);
     if (!channel) {
@@ -45,7 +86,7 @@ scpi_result_t scpi_outp_ProtectionClear(scpi_t * context) {
         return SCPI_RES_ERR;
     }
 
-    channel->clearProtection();
+    coupling::clearProtection(*channel);
 
     return SCPI_RES_OK;
 }
@@ -63,7 +104,7 @@ scpi_result_t scpi_outp_State(scpi_t * context) {
 
     if (enable != channel->isOutputEnabled()) {
         if (enable) {
-            if (channel->isTripped()) {
+            if (coupling::isTripped(*channel)) {
                 SCPI_ErrorPush(context, SCPI_ERROR_CANNOT_EXECUTE_BEFORE_CLEARING_PROTECTION);
                 return SCPI_RES_OK;
             }
@@ -74,7 +115,7 @@ scpi_result_t scpi_outp_State(scpi_t * context) {
             }
         }
 
-        channel->outputEnable(enable);
+        coupling::outputEnable(*channel, enable);
     }
 
     return SCPI_RES_OK;
@@ -91,6 +132,38 @@ scpi_result_t scpi_outp_StateQ(scpi_t * context) {
     return SCPI_RES_OK;
 }
 
+scpi_result_t scpi_outp_Pair(scpi_t * context) {
+    int32_t type;
+    if (!SCPI_ParamChoice(context, pair_choice, &type, true)) {
+        return SCPI_RES_ERR;
+    }
+
+    if (type == coupling::TYPE_NONE && coupling::getType() == coupling::TYPE_TRACKED) {
+        return SCPI_RES_OK;
+    }
+
+    int16_t err;
+    if (!coupling::setType((coupling::Type)type, err)) {
+        SCPI_ErrorPush(context, err);
+        return SCPI_RES_ERR;
+    }
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_outp_PairQ(scpi_t * context) {
+    int32_t type = coupling::getType();
+    if (type == coupling::TYPE_TRACKED) {
+        type = coupling::TYPE_NONE;
+    }
+
+    const char *text;
+    SCPI_ChoiceToName(pair_choice, type, &text);
+    SCPI_ResultMnemonic(context, text);
+
+    return SCPI_RES_OK;
+}
+
 }
 }
 } // namespace eez::psu::scpi
\ No newline at end of file
@@ -19,7 +19,11 @@
 #pragma once
 
 #define SCPI_OUTP_COMMANDS \
+    SCPI_COMMAND("OUTPut:DELay:ON", scpi_outp_DelayOn) \
+    SCPI_COMMAND("OUTPut:DELay:ON?", scpi_outp_DelayOnQ) \
     SCPI_COMMAND("OUTPut:MODE?", scpi_outp_ModeQ) \
+    SCPI_COMMAND("OUTPut:PAIR", scpi_outp_Pair) \
+    SCPI_COMMAND("OUTPut:PAIR?", scpi_outp_PairQ) \
     SCPI_COMMAND("OUTPut:PROTection:CLEar", scpi_outp_ProtectionClear) \
     SCPI_COMMAND("OUTPut[:STATe]", scpi_outp_State) \
     SCPI_COMMAND("OUTPut[:STATe]?", scpi_outp_StateQ) \
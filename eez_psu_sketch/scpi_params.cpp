@@ -19,6 +19,7 @@
 #include "psu.h"
 #include "scpi_psu.h"
 #include "temp_sensor.h"
+#include "coupling.h"
 
 namespace eez {
 namespace psu {
@@ -75,6 +76,11 @@ bool check_channel(scpi_t *context, int32_t ch) {
         return false;
     }
 
+    if (coupling::isSlave(Channel::get(ch - 1))) {
+        SCPI_ErrorPush(context, SCPI_ERROR_SETTINGS_CONFLICT);
+        return false;
+    }
+
     return true;
 }
 
@@ -109,6 +115,69 @@ Channel *set_channel_from_command_number(scpi_t *context) {
     return &Channel::get(ch - 1);
 }
 
+/**
+* Get channels from the optional channel list parameter, e.g. (@1,2) or (@1:2).
+* If parameter is omitted, all channels are returned (coupled slave channel excluded).
+* @param channels array of at least CH_MAX elements
+* @param num_channels number of channels returned
+*/
+bool param_channels(scpi_t *context, Channel **channels, int &num_channels) {
+    num_channels = 0;
+
+    scpi_parameter_t param;
+    if (!SCPI_Parameter(context, &param, FALSE)) {
+        if (SCPI_ParamErrorOccurred(context)) {
+            return false;
+        }
+
+        for (int ch = 1; ch <= CH_NUM; ++ch) {
+            if (!coupling::isSlave(Channel::get(ch - 1))) {
+                if (!check_channel(context, ch)) return false;
+                channels[num_channels++] = &Channel::get(ch - 1);
+            }
+        }
+
+        return true;
+    }
+
+    for (int index = 0; ; ++index) {
+        scpi_bool_t is_range;
+        int32_t from;
+        int32_t to;
+        size_t dimensions;
+        scpi_expr_result_t res = SCPI_ExprChannelListEntry(context, &param, index, &is_range, &from, &to, 1, &dimensions);
+        if (res == SCPI_EXPR_NO_MORE) {
+            break;
+        }
+        if (res != SCPI_EXPR_OK) {
+            return false;
+        }
+        if (dimensions != 1) {
+            SCPI_ErrorPush(context, SCPI_ERROR_ILLEGAL_PARAMETER_VALUE);
+            return false;
+        }
+
+        if (!is_range) {
+            to = from;
+        }
+
+        int32_t step = from <= to ? 1 : -1;
+        for (int32_t ch = from; ; ch += step) {
+            if (!check_channel(context, ch)) return false;
+
+            if (num_channels == CH_MAX) {
+                SCPI_ErrorPush(context, SCPI_ERROR_TOO_MUCH_DATA);
+                return false;
+            }
+            channels[num_channels++] = &Channel::get(ch - 1);
+
+            if (ch == to) break;
+        }
+    }
+
+    return true;
+}
+
 bool param_temp_sensor(scpi_t *context, int32_t &sensor) {
     if (!SCPI_ParamChoice(context, temp_sensor_choice, &sensor, FALSE)) {
 #if OPTION_MAIN_TEMP_SENSOR
@@ -185,24 +254,26 @@ bool get_duration_param(scpi_t *context, float &value, float min, float max, flo
 }
 
 bool get_voltage_from_param(scpi_t *context, const scpi_number_t &param, float &value, const Channel *channel, const Channel::Value *cv) {
+    float factor = channel ? coupling::getVoltageFactor(*channel) : 1.0f;
+
     if (param.special) {
 		if (channel) {
 			if (param.tag == SCPI_NUM_MAX) {
-				value = channel->u.max;
+				value = channel->u.max * factor;
 			}
 			else if (param.tag == SCPI_NUM_MIN) {
-				value = channel->u.min;
+				value = channel->u.min * factor;
 			}
 			else if (param.tag == SCPI_NUM_DEF) {
-				value = channel->u.def;
+				value = channel->u.def * factor;
 			}
 			else if (param.tag == SCPI_NUM_UP && cv) {
-				value = cv->set + cv->step;
-				if (value > channel->u.max) value = channel->u.max;
+				value = cv->set * factor + cv->step;
+				if (value > channel->u.max * factor) value = channel->u.max * factor;
 			}
 			else if (param.tag == SCPI_NUM_DOWN && cv) {
-				value = cv->set - cv->step;
-				if (value < channel->u.min) value = channel->u.min;
+				value = cv->set * factor - cv->step;
+				if (value < channel->u.min * factor) value = channel->u.min * factor;
 			}
 			else {
 				SCPI_ErrorPush(context, SCPI_ERROR_ILLEGAL_PARAMETER_VALUE);
@@ -222,7 +293,7 @@ bool get_voltage_from_param(scpi_t *context, const scpi_number_t &param, float &
         value = (float)param.value;
 		
 		if (channel) {
-			if (value < channel->u.min || value > channel->u.max) {
+			if (value < channel->u.min * factor || value > channel->u.max * factor) {
 				SCPI_ErrorPush(context, SCPI_ERROR_DATA_OUT_OF_RANGE);
 				return false;
 			}
@@ -264,25 +335,32 @@ bool get_voltage_protection_level_from_param(scpi_t *context, const scpi_number_
 }
 
 bool get_current_from_param(scpi_t *context, const scpi_number_t &param, float &value, const Channel *channel, const Channel::Value *cv) {
+    float factor = channel ? coupling::getCurrentFactor(*channel) : 1.0f;
+
     if (param.special) {
-        if (param.tag == SCPI_NUM_MAX) {
-            value = channel->i.max;
-        }
-        else if (param.tag == SCPI_NUM_MIN) {
-            value = channel->i.min;
-        }
-        else if (param.tag == SCPI_NUM_DEF) {
-            value = channel->i.def;
-        }
-        else if (param.tag == SCPI_NUM_UP && cv) {
-            value = cv->set + cv->step;
-            if (value > channel->i.max) value = channel->i.max;
-        }
-        else if (param.tag == SCPI_NUM_DOWN && cv) {
-            value = cv->set - cv->step;
-            if (value < channel->i.min) value = channel->i.min;
-        }
-        else {
+        if (channel) {
+            if (param.tag == SCPI_NUM_MAX) {
+                value = channel->i.max * factor;
+            }
+            else if (param.tag == SCPI_NUM_MIN) {
+                value = channel->i.min * factor;
+            }
+            else if (param.tag == SCPI_NUM_DEF) {
+                value = channel->i.def * factor;
+            }
+            else if (param.tag == SCPI_NUM_UP && cv) {
+                value = cv->set * factor + cv->step;
+                if (value > channel->i.max * factor) value = channel->i.max * factor;
+            }
+            else if (param.tag == SCPI_NUM_DOWN && cv) {
+                value = cv->set * factor - cv->step;
+                if (value < channel->i.min * factor) value = channel->i.min * factor;
+            }
+            else {
+                SCPI_ErrorPush(context, SCPI_ERROR_ILLEGAL_PARAMETER_VALUE);
+                return false;
+            }
+        } else {
             SCPI_ErrorPush(context, SCPI_ERROR_ILLEGAL_PARAMETER_VALUE);
             return false;
         }
@@ -294,9 +372,12 @@ bool get_current_from_param(scpi_t *context, const scpi_number_t &param, float &
         }
 
         value = (float)param.value;
-        if (value < channel->i.min || value > channel->i.max) {
-            SCPI_ErrorPush(context, SCPI_ERROR_DATA_OUT_OF_RANGE);
-            return false;
+
+        if (channel) {
+            if (value < channel->i.min * factor || value > channel->i.max * factor) {
+                SCPI_ErrorPush(context, SCPI_ERROR_DATA_OUT_OF_RANGE);
+                return false;
+            }
         }
     }
 
@@ -426,16 +507,18 @@ bool get_power_limit_param(scpi_t *context, float &value, const Channel *channel
 }
 
 bool get_voltage_limit_from_param(scpi_t *context, const scpi_number_t &param, float &value, const Channel *channel, const Channel::Value *cv) {
+    float factor = channel ? coupling::getVoltageFactor(*channel) : 1.0f;
+
     if (param.special) {
 		if (channel) {
 			if (param.tag == SCPI_NUM_MAX) {
-				value = channel->getVoltageMaxLimit();
+				value = channel->getVoltageMaxLimit() * factor;
 			}
 			else if (param.tag == SCPI_NUM_MIN) {
-				value = channel->u.min;
+				value = channel->u.min * factor;
 			}
 			else if (param.tag == SCPI_NUM_DEF) {
-				value = channel->getVoltageMaxLimit();
+				value = channel->getVoltageMaxLimit() * factor;
 			}
 			else {
 				SCPI_ErrorPush(context, SCPI_ERROR_ILLEGAL_PARAMETER_VALUE);
@@ -455,7 +538,7 @@ bool get_voltage_limit_from_param(scpi_t *context, const scpi_number_t &param, f
         value = (float)param.value;
 		
 		if (channel) {
-			if (value < channel->u.min || value > channel->getVoltageMaxLimit()) {
+			if (value < channel->u.min * factor || value > channel->getVoltageMaxLimit() * factor) {
 				SCPI_ErrorPush(context, SCPI_ERROR_DATA_OUT_OF_RANGE);
 				return false;
 			}
@@ -466,15 +549,22 @@ bool get_voltage_limit_from_param(scpi_t *context, const scpi_number_t &param, f
 }
 
 bool get_current_limit_from_param(scpi_t *context, const scpi_number_t &param, float &value, const Channel *channel, const Channel::Value *cv) {
+    float factor = channel ? coupling::getCurrentFactor(*channel) : 1.0f;
+
     if (param.special) {
-        if (param.tag == SCPI_NUM_MAX) {
-            value = channel->getMaxCurrentLimit();
-        }
-        else if (param.tag == SCPI_NUM_MIN) {
-            value = channel->i.min;
-        }
-        else if (param.tag == SCPI_NUM_DEF) {
-            value = channel->getMaxCurrentLimit();
+        if (channel) {
+            if (param.tag == SCPI_NUM_MAX) {
+                value = channel->getMaxCurrentLimit() * factor;
+            }
+            else if (param.tag == SCPI_NUM_MIN) {
+                value = channel->i.min * factor;
+            }
+            else if (param.tag == SCPI_NUM_DEF) {
+                value = channel->getMaxCurrentLimit() * factor;
+            }
+        } else {
+            SCPI_ErrorPush(context, SCPI_ERROR_ILLEGAL_PARAMETER_VALUE);
+            return false;
         }
     }
     else {
@@ -484,9 +574,12 @@ bool get_current_limit_from_param(scpi_t *context, const scpi_number_t &param, f
         }
 
         value = (float)param.value;
-        if (value < channel->i.min || value > channel->getMaxCurrentLimit()) {
-            SCPI_ErrorPush(context, SCPI_ERROR_DATA_OUT_OF_RANGE);
-            return false;
+
+        if (channel) {
+            if (value < channel->i.min * factor || value > channel->getMaxCurrentLimit() * factor) {
+                SCPI_ErrorPush(context, SCPI_ERROR_DATA_OUT_OF_RANGE);
+                return false;
+            }
         }
     }
 
@@ -494,15 +587,22 @@ bool get_current_limit_from_param(scpi_t *context, const scpi_number_t &param, f
 }
 
 bool get_power_limit_from_param(scpi_t *context, const scpi_number_t &param, float &value, const Channel *channel, const Channel::Value *cv) {
+    float factor = channel ? coupling::getPowerFactor(*channel) : 1.0f;
+
     if (param.special) {
-        if (param.tag == SCPI_NUM_MAX) {
-            value = channel->getPowerMaxLimit();
-        }
-        else if (param.tag == SCPI_NUM_MIN) {
-            value = 0;
-        }
-        else if (param.tag == SCPI_NUM_DEF) {
-            value = channel->getPowerMaxLimit();
+        if (channel) {
+            if (param.tag == SCPI_NUM_MAX) {
+                value = channel->getPowerMaxLimit() * factor;
+            }
+            else if (param.tag == SCPI_NUM_MIN) {
+                value = 0;
+            }
+            else if (param.tag == SCPI_NUM_DEF) {
+                value = channel->getPowerMaxLimit() * factor;
+            }
+        } else {
+            SCPI_ErrorPush(context, SCPI_ERROR_ILLEGAL_PARAMETER_VALUE);
+            return false;
         }
     }
     else {
@@ -512,9 +612,12 @@ bool get_power_limit_from_param(scpi_t *context, const scpi_number_t &param, flo
         }
 
         value = (float)param.value;
-        if (value < 0 || value > channel->getPowerMaxLimit()) {
-            SCPI_ErrorPush(context, SCPI_ERROR_DATA_OUT_OF_RANGE);
-            return false;
+
+        if (channel) {
+            if (value < 0 || value > channel->getPowerMaxLimit() * factor) {
+                SCPI_ErrorPush(context, SCPI_ERROR_DATA_OUT_OF_RANGE);
+                return false;
+            }
         }
     }
 
@@ -522,7 +625,8 @@ bool get_power_limit_from_param(scpi_t *context, const scpi_number_t &param, flo
 }
 
 scpi_result_t result_float(scpi_t * context, float value) {
-    char buffer[32] = { 0 };
+    // large enough for FLT_MAX printed in fixed point notation
+    char buffer[64] = { 0 };
     util::strcatFloat(buffer, value);
     SCPI_ResultCharacters(context, buffer, strlen(buffer));
     return SCPI_RES_OK;
@@ -24,16 +24,21 @@
 #include "scpi_core.h"
 #include "scpi_debug.h"
 #include "scpi_diag.h"
+#include "scpi_form.h"
 #include "scpi_inst.h"
 #include "scpi_meas.h"
 #include "scpi_mem.h"
 #include "scpi_outp.h"
+#include "scpi_sense.h"
 #include "scpi_sour.h"
 #include "scpi_stat.h"
 #include "scpi_syst.h"
+#include "scpi_trig.h"
 
 #include "sound.h"
 #include "datetime.h"
+#include "ramp.h"
+#include "long_operation.h"
 
 #ifdef EEZ_PSU_SIMULATOR 
 #include "scpi_simu.h"
@@ -51,14 +56,17 @@ namespace scpi {
     SCPI_CORE_COMMANDS \
     SCPI_DEBUG_COMMANDS \
     SCPI_DIAG_COMMANDS \
+    SCPI_FORM_COMMANDS \
     SCPI_INST_COMMANDS \
     SCPI_MEAS_COMMANDS \
     SCPI_MEM_COMMANDS \
     SCPI_OUTP_COMMANDS \
+    SCPI_SENS_COMMANDS \
     SCPI_SIMU_COMMANDS \
     SCPI_SOUR_COMMANDS \
     SCPI_STAT_COMMANDS \
     SCPI_SYST_COMMANDS \
+    SCPI_TRIG_COMMANDS \
 
 #define SCPI_COMMAND(P, C) scpi_result_t C(scpi_t * context);
 SCPI_COMMANDS
@@ -93,7 +101,7 @@ void init(scpi_t &scpi_context,
     scpi_interface_t *interface,
     char *input_buffer,
     size_t input_buffer_length,
-    int16_t *error_queue_data,
+    scpi_error_info_t *error_queue_data,
     int16_t error_queue_size)
 {
     SCPI_Init(&scpi_context, scpi_commands, interface, scpi_units_def,
@@ -101,6 +109,8 @@ void init(scpi_t &scpi_context,
         input_buffer, input_buffer_length, error_queue_data, error_queue_size);
 
     scpi_context.user_context = &scpi_psu_context;
+
+    reg_preset_transitions(&scpi_context);
 }
 
 void input(scpi_t &scpi_context, char ch) {
@@ -122,19 +132,23 @@ void input(scpi_t &scpi_context, char ch) {
     }
 }
 
-void printError(int_fast16_t err) {
-    sound::playBeep();
-
-    char errorOutputBuffer[256];
+void waitForPendingOperations() {
+    // not the whole main loop, this is called from inside the SCPI command
+    while (ramp::isAnyRunning() || long_operation::isBusy()) {
+        psu::tickWhileWaiting();
 
-    char datetime_buffer[20] = { 0 };
-    if (datetime::getDateTimeAsString(datetime_buffer)) {
-        sprintf_P(errorOutputBuffer, PSTR("**ERROR [%s]: %d,\"%s\"\r\n"), datetime_buffer, (int16_t)err, SCPI_ErrorTranslate(err));
-    } else {
-        sprintf_P(errorOutputBuffer, PSTR("**ERROR: %d,\"%s\"\r\n"), (int16_t)err, SCPI_ErrorTranslate(err));
+        unsigned long tick_usec = micros();
+        ramp::tick(tick_usec);
+        long_operation::tick(tick_usec);
     }
+}
+
+void onError(int_fast16_t err) {
+    sound::playErrorBeep((int16_t)err);
+}
 
-    Serial.println(errorOutputBuffer);
+uint32_t getErrorTime() {
+    return millis();
 }
 
 }
@@ -20,16 +20,25 @@
 
 #include "scpi_regs.h"
 #include "scpi_params.h"
+#include "event_queue.h"
 
 namespace eez {
 namespace psu {
 /// SCPI commands.
 namespace scpi {
 
+/// Data format of the query responses (FORMat[:DATA]).
+enum scpi_psu_format_t {
+    SCPI_PSU_FORMAT_ASCII,
+    SCPI_PSU_FORMAT_REAL
+};
+
 /// EEZ PSU specific SCPI parser context data.
 struct scpi_psu_t {
     scpi_reg_val_t *registers;
     uint8_t selected_channel_index;
+    uint8_t format;
+    event_queue::EventFilter event_filter; // SYSTem:EVENt:FILTer
 };
 
 void init(scpi_t &scpi_context,
@@ -37,12 +46,21 @@ void init(scpi_t &scpi_context,
     scpi_interface_t *interface,
     char *input_buffer,
     size_t input_buffer_length,
-    int16_t *error_queue_data,
+    scpi_error_info_t *error_queue_data,
     int16_t error_queue_size);
 
 void input(scpi_t &scpi_context, char ch);
 
-void printError(int_fast16_t err);
+/// Wait until the ramps and the long operation in progress are completed (*WAI and *OPC?).
+/// Only channels (measurement, protection), ramps and the long operation are ticked
+/// meanwhile (see psu::tickWhileWaiting), the rest of the main loop waits.
+void waitForPendingOperations();
+
+/// Called for every new entry in the error queue. The queue stores only the code,
+/// repeat count and getErrorTime(), the text is formatted when SYST:ERR? reads it.
+void onError(int_fast16_t err);
+/// Time stored with the error queue entry, in milliseconds (see millis()).
+uint32_t getErrorTime();
 }
 }
 } // namespace eez::psu::scpi
@@ -23,30 +23,9 @@ namespace eez {
 namespace psu {
 namespace scpi {
 
-/**
-* Update register value
-* @param context
-* @param name - register name
-*/
-static void psu_reg_update(scpi_t * context, scpi_psu_reg_name_t name) {
-    reg_set(context, name, reg_get(context, name));
-}
-
-/**
-* Update IEEE 488.2 register according to value and its mask register
-* @param context
-* @param val value of register
-* @param mask name of mask register (enable register)
-* @param bits bits to clear or set in STB
-*/
-static void psu_reg_update_ieee488_reg(scpi_t * context, scpi_reg_val_t val, scpi_psu_reg_name_t mask, scpi_reg_name_t ieee488RegName, scpi_reg_val_t bits) {
-    if (val & reg_get(context, mask)) {
-        SCPI_RegSetBits(context, ieee488RegName, bits);
-    }
-    else {
-        SCPI_RegClearBits(context, ieee488RegName, bits);
-    }
-}
+/// Pending condition bits, accessed only with interrupts disabled.
+static reg_conditions_t g_conditions;
+static bool g_conditionsChanged;
 
 /**
 * Set PSU register bits
@@ -67,37 +46,76 @@ void psu_reg_clear_bits(scpi_t * context, scpi_psu_reg_name_t name, scpi_reg_val
 }
 
 /**
-* Update PSU register according to value and its mask register
+* Get event bits for condition register transitions passed by the transition filters
 * @param context
-* @param val value of register
-* @param mask name of mask register (enable register)
-* @param bits bits to clear or set in STB
+* @param oldVal previous value of condition register
+* @param newVal new value of condition register
+* @param ptr name of positive transition filter register
+* @param ntr name of negative transition filter register
+* @return event bits
 */
-static void psu_reg_update_psu_reg(scpi_t * context, scpi_reg_val_t val, scpi_psu_reg_name_t mask, scpi_psu_reg_name_t psuRegName, scpi_reg_val_t bits) {
-    if (val & reg_get(context, mask)) {
-        psu_reg_set_bits(context, psuRegName, bits);
+static scpi_reg_val_t psu_reg_get_transition_bits(scpi_t * context, scpi_reg_val_t oldVal, scpi_reg_val_t newVal, scpi_psu_reg_name_t ptr, scpi_psu_reg_name_t ntr) {
+    return (newVal & ~oldVal & reg_get(context, ptr)) | (oldVal & ~newVal & reg_get(context, ntr));
+}
+
+/**
+* Update IEEE 488.2 event register on condition register transition
+* @param context
+* @param oldVal previous value of condition register
+* @param newVal new value of condition register
+* @param ptr name of positive transition filter register
+* @param ntr name of negative transition filter register
+* @param ieee488RegName name of event register
+*/
+static void psu_reg_update_ieee488_event(scpi_t * context, scpi_reg_val_t oldVal, scpi_reg_val_t newVal, scpi_psu_reg_name_t ptr, scpi_psu_reg_name_t ntr, scpi_reg_name_t ieee488RegName) {
+    scpi_reg_val_t bits = psu_reg_get_transition_bits(context, oldVal, newVal, ptr, ntr);
+    if (bits) {
+        SCPI_RegSetBits(context, ieee488RegName, bits);
     }
-    else {
-        psu_reg_clear_bits(context, psuRegName, bits);
+}
+
+/**
+* Update PSU event register on condition register transition
+* @param context
+* @param oldVal previous value of condition register
+* @param newVal new value of condition register
+* @param ptr name of positive transition filter register
+* @param ntr name of negative transition filter register
+* @param psuRegName name of event register
+*/
+static void psu_reg_update_event(scpi_t * context, scpi_reg_val_t oldVal, scpi_reg_val_t newVal, scpi_psu_reg_name_t ptr, scpi_psu_reg_name_t ntr, scpi_psu_reg_name_t psuRegName) {
+    scpi_reg_val_t bits = psu_reg_get_transition_bits(context, oldVal, newVal, ptr, ntr);
+    if (bits) {
+        psu_reg_set_bits(context, psuRegName, bits);
     }
-    psu_reg_update(context, psuRegName);
 }
 
 /**
-* Update PSU register according to value
+* Update summary bits in the condition register of the parent status group
 * @param context
-* @param val value of register
+* @param event name of event register
 * @param mask name of mask register (enable register)
-* @param bits bits to clear or set in STB
+* @param psuRegName name of parent condition register
+* @param bits summary bits
 */
-static void psu_reg_update_psu_reg(scpi_t * context, scpi_reg_val_t val, scpi_psu_reg_name_t psuRegName, scpi_reg_val_t bits) {
-    if (val) {
-        psu_reg_set_bits(context, psuRegName, bits);
+static void psu_reg_update_summary(scpi_t * context, scpi_psu_reg_name_t event, scpi_psu_reg_name_t mask, scpi_psu_reg_name_t psuRegName, scpi_reg_val_t bits) {
+    scpi_reg_val_t val = reg_get(context, psuRegName);
+    scpi_reg_val_t newVal = reg_get(context, event) & reg_get(context, mask) ? val | bits : val & ~bits;
+    if (newVal != val) {
+        reg_set(context, psuRegName, newVal);
     }
-    else {
-        psu_reg_clear_bits(context, psuRegName, bits);
+}
+
+/**
+* Set condition register, events are generated only if value is changed
+* @param context
+* @param name name of condition register
+* @param val new value
+*/
+static void psu_reg_set_cond(scpi_t * context, scpi_psu_reg_name_t name, scpi_reg_val_t val) {
+    if (reg_get(context, name) != val) {
+        reg_set(context, name, val);
     }
-    psu_reg_update(context, psuRegName);
 }
 
 /**
@@ -128,67 +146,64 @@ void reg_set(scpi_t * context, scpi_psu_reg_name_t name, scpi_reg_val_t val) {
     }
 
     /* set register value */
+    scpi_reg_val_t oldVal = psu_context->registers[name];
     psu_context->registers[name] = val;
 
     switch (name) {
+    case SCPI_PSU_REG_QUES_COND:
+        psu_reg_update_ieee488_event(context, oldVal, val, SCPI_PSU_REG_QUES_PTR, SCPI_PSU_REG_QUES_NTR, SCPI_REG_QUES);
+        break;
+
+    case SCPI_PSU_REG_OPER_COND:
+        psu_reg_update_ieee488_event(context, oldVal, val, SCPI_PSU_REG_OPER_PTR, SCPI_PSU_REG_OPER_NTR, SCPI_REG_OPER);
+        break;
+
     case SCPI_PSU_REG_QUES_INST_COND:
-        psu_reg_update_psu_reg(context, val, SCPI_PSU_REG_QUES_COND, QUES_ISUM);
+        psu_reg_update_event(context, oldVal, val, SCPI_PSU_REG_QUES_INST_PTR, SCPI_PSU_REG_QUES_INST_NTR, SCPI_PSU_REG_QUES_INST_EVENT);
         break;
     case SCPI_PSU_REG_QUES_INST_EVENT:
-        psu_reg_update_ieee488_reg(context, val, SCPI_PSU_REG_QUES_INST_ENABLE, SCPI_REG_QUES, QUES_ISUM);
-        break;
     case SCPI_PSU_REG_QUES_INST_ENABLE:
-        psu_reg_update(context, SCPI_PSU_REG_QUES_INST_EVENT);
+        psu_reg_update_summary(context, SCPI_PSU_REG_QUES_INST_EVENT, SCPI_PSU_REG_QUES_INST_ENABLE, SCPI_PSU_REG_QUES_COND, QUES_ISUM);
         break;
 
     case SCPI_PSU_REG_OPER_INST_COND:
-        psu_reg_update_psu_reg(context, val, SCPI_PSU_REG_OPER_COND, OPER_ISUM);
+        psu_reg_update_event(context, oldVal, val, SCPI_PSU_REG_OPER_INST_PTR, SCPI_PSU_REG_OPER_INST_NTR, SCPI_PSU_REG_OPER_INST_EVENT);
         break;
     case SCPI_PSU_REG_OPER_INST_EVENT:
-        psu_reg_update_ieee488_reg(context, val, SCPI_PSU_REG_OPER_INST_ENABLE, SCPI_REG_OPER, OPER_ISUM);
-        break;
     case SCPI_PSU_REG_OPER_INST_ENABLE:
-        psu_reg_update(context, SCPI_PSU_REG_OPER_INST_EVENT);
+        psu_reg_update_summary(context, SCPI_PSU_REG_OPER_INST_EVENT, SCPI_PSU_REG_OPER_INST_ENABLE, SCPI_PSU_REG_OPER_COND, OPER_ISUM);
         break;
 
     case SCPI_PSU_CH_REG_QUES_INST_ISUM_COND1:
-        psu_reg_update_psu_reg(context, val, SCPI_PSU_REG_QUES_INST_COND, QUES_ISUM1);
+        psu_reg_update_event(context, oldVal, val, SCPI_PSU_CH_REG_QUES_INST_ISUM_PTR1, SCPI_PSU_CH_REG_QUES_INST_ISUM_NTR1, SCPI_PSU_CH_REG_QUES_INST_ISUM_EVENT1);
         break;
     case SCPI_PSU_CH_REG_QUES_INST_ISUM_EVENT1:
-        psu_reg_update_psu_reg(context, val, SCPI_PSU_CH_REG_QUES_INST_ISUM_ENABLE1, SCPI_PSU_REG_QUES_INST_EVENT, QUES_ISUM1);
-        break;
     case SCPI_PSU_CH_REG_QUES_INST_ISUM_ENABLE1:
-        psu_reg_update(context, SCPI_PSU_CH_REG_QUES_INST_ISUM_EVENT1);
+        psu_reg_update_summary(context, SCPI_PSU_CH_REG_QUES_INST_ISUM_EVENT1, SCPI_PSU_CH_REG_QUES_INST_ISUM_ENABLE1, SCPI_PSU_REG_QUES_INST_COND, QUES_ISUM1);
         break;
 
     case SCPI_PSU_CH_REG_OPER_INST_ISUM_COND1:
-        psu_reg_update_psu_reg(context, val, SCPI_PSU_REG_OPER_INST_COND, OPER_ISUM1);
+        psu_reg_update_event(context, oldVal, val, SCPI_PSU_CH_REG_OPER_INST_ISUM_PTR1, SCPI_PSU_CH_REG_OPER_INST_ISUM_NTR1, SCPI_PSU_CH_REG_OPER_INST_ISUM_EVENT1);
         break;
     case SCPI_PSU_CH_REG_OPER_INST_ISUM_EVENT1:
-        psu_reg_update_psu_reg(context, val, SCPI_PSU_CH_REG_OPER_INST_ISUM_ENABLE1, SCPI_PSU_REG_OPER_INST_EVENT, OPER_ISUM1);
-        break;
     case SCPI_PSU_CH_REG_OPER_INST_ISUM_ENABLE1:
-        psu_reg_update(context, SCPI_PSU_CH_REG_OPER_INST_ISUM_EVENT1);
+        psu_reg_update_summary(context, SCPI_PSU_CH_REG_OPER_INST_ISUM_EVENT1, SCPI_PSU_CH_REG_OPER_INST_ISUM_ENABLE1, SCPI_PSU_REG_OPER_INST_COND, OPER_ISUM1);
         break;
 
     case SCPI_PSU_CH_REG_QUES_INST_ISUM_COND2:
-        psu_reg_update_psu_reg(context, val, SCPI_PSU_REG_QUES_INST_COND, QUES_ISUM2);
+        psu_reg_update_event(context, oldVal, val, SCPI_PSU_CH_REG_QUES_INST_ISUM_PTR2, SCPI_PSU_CH_REG_QUES_INST_ISUM_NTR2, SCPI_PSU_CH_REG_QUES_INST_ISUM_EVENT2);
         break;
     case SCPI_PSU_CH_REG_QUES_INST_ISUM_EVENT2:
-        psu_reg_update_psu_reg(context, val, SCPI_PSU_CH_REG_QUES_INST_ISUM_ENABLE2, SCPI_PSU_REG_QUES_INST_EVENT, QUES_ISUM2);
-        break;
     case SCPI_PSU_CH_REG_QUES_INST_ISUM_ENABLE2:
-        psu_reg_update(context, SCPI_PSU_CH_REG_QUES_INST_ISUM_EVENT2);
+        psu_reg_update_summary(context, SCPI_PSU_CH_REG_QUES_INST_ISUM_EVENT2, SCPI_PSU_CH_REG_QUES_INST_ISUM_ENABLE2, SCPI_PSU_REG_QUES_INST_COND, QUES_ISUM2);
         break;
 
     case SCPI_PSU_CH_REG_OPER_INST_ISUM_COND2:
-        psu_reg_update_psu_reg(context, val, SCPI_PSU_REG_OPER_INST_COND, OPER_ISUM2);
+        psu_reg_update_event(context, oldVal, val, SCPI_PSU_CH_REG_OPER_INST_ISUM_PTR2, SCPI_PSU_CH_REG_OPER_INST_ISUM_NTR2, SCPI_PSU_CH_REG_OPER_INST_ISUM_EVENT2);
         break;
     case SCPI_PSU_CH_REG_OPER_INST_ISUM_EVENT2:
-        psu_reg_update_psu_reg(context, val, SCPI_PSU_CH_REG_OPER_INST_ISUM_ENABLE2, SCPI_PSU_REG_OPER_INST_EVENT, OPER_ISUM2);
-        break;
     case SCPI_PSU_CH_REG_OPER_INST_ISUM_ENABLE2:
-        psu_reg_update(context, SCPI_PSU_CH_REG_OPER_INST_ISUM_EVENT2);
+        psu_reg_update_summary(context, SCPI_PSU_CH_REG_OPER_INST_ISUM_EVENT2, SCPI_PSU_CH_REG_OPER_INST_ISUM_ENABLE2, SCPI_PSU_REG_OPER_INST_COND, OPER_ISUM2);
         break;
 
     default:
@@ -205,62 +220,96 @@ int reg_get_ques_isum_bit_mask_for_channel_protection_value(Channel *channel, Ch
     return QUES_ISUM_OPP;
 }
 
-void reg_set_ques_bit(scpi_t *context, int bit_mask, bool on) {
-    scpi_reg_val_t val = reg_get(context, SCPI_PSU_REG_QUES_COND);
-    if (on) {
-        if (!(val & bit_mask)) {
-            reg_set(context, SCPI_PSU_REG_QUES_COND, val | bit_mask);
-
-            // set event on raising condition
-            val = SCPI_RegGet(context, SCPI_REG_QUES);
-            SCPI_RegSet(context, SCPI_REG_QUES, val | bit_mask);
-        }
-    }
-    else {
-        if (val & bit_mask) {
-            reg_set(context, SCPI_PSU_REG_QUES_COND, val & ~bit_mask);
-        }
+/**
+* Set or clear pending condition bits. Safe to call from the interrupt handler,
+* registers of SCPI contexts are updated later from the main loop.
+* @param cond pending condition bits
+* @param bit_mask bits to set or clear
+* @param on set if true, clear if false
+*/
+static void reg_set_cond_bits(scpi_reg_val_t &cond, int bit_mask, bool on) {
+    noInterrupts();
+    scpi_reg_val_t newCond = on ? cond | bit_mask : cond & ~bit_mask;
+    if (newCond != cond) {
+        cond = newCond;
+        g_conditionsChanged = true;
     }
+    interrupts();
 }
 
-void reg_set_ques_isum_bit(scpi_t *context, Channel *channel, int bit_mask, bool on) {
-    scpi_psu_reg_name_t reg_name = channel->index == 1 ? SCPI_PSU_CH_REG_QUES_INST_ISUM_COND1 : SCPI_PSU_CH_REG_QUES_INST_ISUM_COND2;
-    scpi_reg_val_t val = reg_get(context, reg_name);
-    if (on) {
-        if (!(val & bit_mask)) {
-            reg_set(context, reg_name, val | bit_mask);
-
-            // set event on raising condition
-            reg_name = channel->index == 1 ? SCPI_PSU_CH_REG_QUES_INST_ISUM_EVENT1 : SCPI_PSU_CH_REG_QUES_INST_ISUM_EVENT2;
-            val = reg_get(context, reg_name);
-            reg_set(context, reg_name, val | bit_mask);
-        }
-    }
-    else {
-        if (val & bit_mask) {
-            reg_set(context, reg_name, val & ~bit_mask);
-        }
-    }
+void reg_set_ques_bit(int bit_mask, bool on) {
+    reg_set_cond_bits(g_conditions.ques, bit_mask, on);
+}
+
+void reg_set_oper_bit(int bit_mask, bool on) {
+    reg_set_cond_bits(g_conditions.oper, bit_mask, on);
+}
+
+void reg_set_ques_isum_bit(Channel *channel, int bit_mask, bool on) {
+    reg_set_cond_bits(g_conditions.ques_isum[channel->index == 1 ? 0 : 1], bit_mask, on);
+}
+
+void reg_set_oper_isum_bit(Channel *channel, int bit_mask, bool on) {
+    reg_set_cond_bits(g_conditions.oper_isum[channel->index == 1 ? 0 : 1], bit_mask, on);
 }
 
-void reg_set_oper_isum_bit(scpi_t *context, Channel *channel, int bit_mask, bool on) {
-    scpi_psu_reg_name_t reg_name = channel->index == 1 ? SCPI_PSU_CH_REG_OPER_INST_ISUM_COND1 : SCPI_PSU_CH_REG_OPER_INST_ISUM_COND2;
-    scpi_reg_val_t val = reg_get(context, reg_name);
-    if (on) {
-        if (!(val & bit_mask)) {
-            reg_set(context, reg_name, val | bit_mask);
-
-            // set event on raising condition
-            reg_name = channel->index == 1 ? SCPI_PSU_CH_REG_OPER_INST_ISUM_EVENT1 : SCPI_PSU_CH_REG_OPER_INST_ISUM_EVENT2;
-            val = reg_get(context, reg_name);
-            reg_set(context, reg_name, val | bit_mask);
-        }
+/**
+* Get snapshot of all pending condition bits, taken at once so it is consistent across channels.
+* @param conditions snapshot
+* @return true if any condition bit is changed since the last call
+*/
+bool reg_get_changed_conditions(reg_conditions_t &conditions) {
+    noInterrupts();
+    bool changed = g_conditionsChanged;
+    if (changed) {
+        conditions = g_conditions;
+        g_conditionsChanged = false;
     }
-    else {
-        if (val & bit_mask) {
-            reg_set(context, reg_name, val & ~bit_mask);
-        }
+    interrupts();
+    return changed;
+}
+
+/**
+* Propagate condition bits through all status groups of SCPI context.
+* Channel registers are updated first, so summary bits are settled
+* before the top level condition registers are changed.
+* @param context
+* @param conditions snapshot taken with reg_get_changed_conditions
+*/
+void reg_update_conditions(scpi_t *context, const reg_conditions_t &conditions) {
+    psu_reg_set_cond(context, SCPI_PSU_CH_REG_QUES_INST_ISUM_COND1, conditions.ques_isum[0]);
+    psu_reg_set_cond(context, SCPI_PSU_CH_REG_OPER_INST_ISUM_COND1, conditions.oper_isum[0]);
+    psu_reg_set_cond(context, SCPI_PSU_CH_REG_QUES_INST_ISUM_COND2, conditions.ques_isum[1]);
+    psu_reg_set_cond(context, SCPI_PSU_CH_REG_OPER_INST_ISUM_COND2, conditions.oper_isum[1]);
+
+    psu_reg_set_cond(context, SCPI_PSU_REG_QUES_COND,
+        (reg_get(context, SCPI_PSU_REG_QUES_COND) & QUES_ISUM) | (conditions.ques & ~QUES_ISUM));
+    psu_reg_set_cond(context, SCPI_PSU_REG_OPER_COND,
+        (reg_get(context, SCPI_PSU_REG_OPER_COND) & OPER_ISUM) | (conditions.oper & ~OPER_ISUM));
+}
+
+/**
+* Set transition filters to the preset values: event is generated on positive transition only.
+* @param context
+*/
+void reg_preset_transitions(scpi_t *context) {
+    static const scpi_psu_reg_name_t ptr[] = {
+        SCPI_PSU_REG_QUES_PTR, SCPI_PSU_REG_OPER_PTR,
+        SCPI_PSU_REG_QUES_INST_PTR, SCPI_PSU_REG_OPER_INST_PTR,
+        SCPI_PSU_CH_REG_QUES_INST_ISUM_PTR1, SCPI_PSU_CH_REG_OPER_INST_ISUM_PTR1,
+        SCPI_PSU_CH_REG_QUES_INST_ISUM_PTR2, SCPI_PSU_CH_REG_OPER_INST_ISUM_PTR2
+    };
+
+    for (unsigned i = 0; i < sizeof(ptr) / sizeof(ptr[0]); ++i) {
+        // NTR register follows PTR register
+        reg_set(context, ptr[i], 0x7FFF);
+        reg_set(context, (scpi_psu_reg_name_t)(ptr[i] + 1), 0);
     }
+
+    // propagate current conditions to the new context
+    noInterrupts();
+    g_conditionsChanged = true;
+    interrupts();
 }
 
 }
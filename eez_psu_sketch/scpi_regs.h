@@ -79,44 +79,74 @@ namespace scpi {
 //
 enum scpi_psu_reg_name_t {
     SCPI_PSU_REG_QUES_COND,
+    SCPI_PSU_REG_QUES_PTR,
+    SCPI_PSU_REG_QUES_NTR,
+
     SCPI_PSU_REG_OPER_COND,
+    SCPI_PSU_REG_OPER_PTR,
+    SCPI_PSU_REG_OPER_NTR,
 
     SCPI_PSU_REG_QUES_INST_COND,
+    SCPI_PSU_REG_QUES_INST_PTR,
+    SCPI_PSU_REG_QUES_INST_NTR,
     SCPI_PSU_REG_QUES_INST_EVENT,
     SCPI_PSU_REG_QUES_INST_ENABLE,
 
     SCPI_PSU_REG_OPER_INST_COND,
+    SCPI_PSU_REG_OPER_INST_PTR,
+    SCPI_PSU_REG_OPER_INST_NTR,
     SCPI_PSU_REG_OPER_INST_EVENT,
     SCPI_PSU_REG_OPER_INST_ENABLE,
 
     SCPI_PSU_CH_REG_QUES_INST_ISUM_COND1,
+    SCPI_PSU_CH_REG_QUES_INST_ISUM_PTR1,
+    SCPI_PSU_CH_REG_QUES_INST_ISUM_NTR1,
     SCPI_PSU_CH_REG_QUES_INST_ISUM_EVENT1,
     SCPI_PSU_CH_REG_QUES_INST_ISUM_ENABLE1,
 
     SCPI_PSU_CH_REG_OPER_INST_ISUM_COND1,
+    SCPI_PSU_CH_REG_OPER_INST_ISUM_PTR1,
+    SCPI_PSU_CH_REG_OPER_INST_ISUM_NTR1,
     SCPI_PSU_CH_REG_OPER_INST_ISUM_EVENT1,
     SCPI_PSU_CH_REG_OPER_INST_ISUM_ENABLE1,
 
     SCPI_PSU_CH_REG_QUES_INST_ISUM_COND2,
+    SCPI_PSU_CH_REG_QUES_INST_ISUM_PTR2,
+    SCPI_PSU_CH_REG_QUES_INST_ISUM_NTR2,
     SCPI_PSU_CH_REG_QUES_INST_ISUM_EVENT2,
     SCPI_PSU_CH_REG_QUES_INST_ISUM_ENABLE2,
 
     SCPI_PSU_CH_REG_OPER_INST_ISUM_COND2,
+    SCPI_PSU_CH_REG_OPER_INST_ISUM_PTR2,
+    SCPI_PSU_CH_REG_OPER_INST_ISUM_NTR2,
     SCPI_PSU_CH_REG_OPER_INST_ISUM_EVENT2,
     SCPI_PSU_CH_REG_OPER_INST_ISUM_ENABLE2,
 
     SCPI_PSU_REG_COUNT,
 };
 
+/// Condition bits reported by the firmware, not yet propagated to SCPI contexts.
+struct reg_conditions_t {
+    scpi_reg_val_t ques;
+    scpi_reg_val_t oper;
+    scpi_reg_val_t ques_isum[2];
+    scpi_reg_val_t oper_isum[2];
+};
+
 scpi_reg_val_t reg_get(scpi_t * context, scpi_psu_reg_name_t name);
 void reg_set(scpi_t * context, scpi_psu_reg_name_t name, scpi_reg_val_t val);
 
 int reg_get_ques_isum_bit_mask_for_channel_protection_value(Channel *channel, Channel::ProtectionValue &cpv);
 
-void reg_set_ques_bit(scpi_t *context, int bit_mask, bool on);
-void reg_set_ques_isum_bit(scpi_t * context, Channel *channel, int bit_mask, bool on);
+void reg_set_ques_bit(int bit_mask, bool on);
+void reg_set_oper_bit(int bit_mask, bool on);
+void reg_set_ques_isum_bit(Channel *channel, int bit_mask, bool on);
+void reg_set_oper_isum_bit(Channel *channel, int bit_mask, bool on);
+
+bool reg_get_changed_conditions(reg_conditions_t &conditions);
+void reg_update_conditions(scpi_t *context, const reg_conditions_t &conditions);
 
-void reg_set_oper_isum_bit(scpi_t * context, Channel *channel, int bit_mask, bool on);
+void reg_preset_transitions(scpi_t *context);
 
 }
 }
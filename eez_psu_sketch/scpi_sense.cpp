@@ -0,0 +1,184 @@
+/*
+ * EEZ PSU Firmware
+ * Copyright (C) 2015-present, Envox d.o.o.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+ 
+#include "psu.h"
+#include "scpi_psu.h"
+#include "scpi_sense.h"
+
+#include "adc.h"
+
+namespace eez {
+namespace psu {
+namespace scpi {
+
+////////////////////////////////////////////////////////////////////////////////
+
+static bool get_int_param(scpi_t *context, int32_t &value, int32_t min, int32_t max, int32_t def) {
+    scpi_number_t param;
+    if (!SCPI_ParamNumber(context, scpi_special_numbers_def, &param, true)) {
+        return false;
+    }
+
+    if (param.special) {
+        if (param.tag == SCPI_NUM_MAX) {
+            value = max;
+        }
+        else if (param.tag == SCPI_NUM_MIN) {
+            value = min;
+        }
+        else if (param.tag == SCPI_NUM_DEF) {
+            value = def;
+        }
+        else {
+            SCPI_ErrorPush(context, SCPI_ERROR_ILLEGAL_PARAMETER_VALUE);
+            return false;
+        }
+    }
+    else {
+        if (param.unit != SCPI_UNIT_NONE) {
+            SCPI_ErrorPush(context, SCPI_ERROR_INVALID_SUFFIX);
+            return false;
+        }
+
+        value = (int32_t)param.value;
+        if (value < min || value > max) {
+            SCPI_ErrorPush(context, SCPI_ERROR_DATA_OUT_OF_RANGE);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+scpi_result_t scpi_sense_AdcRate(scpi_t * context) {
+    Channel *channel = set_channel_from_command_number(context);
+    if (!channel) {
+        return SCPI_RES_ERR;
+    }
+
+    scpi_number_t param;
+    if (!SCPI_ParamNumber(context, scpi_special_numbers_def, &param, true)) {
+        return SCPI_RES_ERR;
+    }
+
+    uint8_t sps;
+    if (param.special) {
+        if (param.tag == SCPI_NUM_MAX) {
+            sps = AnalogDigitalConverter::ADC_SPS_MAX;
+        }
+        else if (param.tag == SCPI_NUM_MIN) {
+            sps = 0;
+        }
+        else if (param.tag == SCPI_NUM_DEF) {
+            sps = ADC_SPS;
+        }
+        else {
+            SCPI_ErrorPush(context, SCPI_ERROR_ILLEGAL_PARAMETER_VALUE);
+            return SCPI_RES_ERR;
+        }
+    }
+    else {
+        if (param.unit != SCPI_UNIT_NONE && param.unit != SCPI_UNIT_HERTZ) {
+            SCPI_ErrorPush(context, SCPI_ERROR_INVALID_SUFFIX);
+            return SCPI_RES_ERR;
+        }
+
+        if (param.value < AnalogDigitalConverter::spsToRate(0) ||
+            param.value > AnalogDigitalConverter::spsToRate(AnalogDigitalConverter::ADC_SPS_MAX)) {
+            SCPI_ErrorPush(context, SCPI_ERROR_DATA_OUT_OF_RANGE);
+            return SCPI_RES_ERR;
+        }
+
+        sps = AnalogDigitalConverter::rateToSps((float)param.value);
+    }
+
+    channel->adc.plan.sps = sps;
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_sense_AdcRateQ(scpi_t * context) {
+    Channel *channel = set_channel_from_command_number(context);
+    if (!channel) {
+        return SCPI_RES_ERR;
+    }
+
+    SCPI_ResultInt(context, AnalogDigitalConverter::spsToRate(channel->adc.plan.sps));
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_sense_AverageCount(scpi_t * context) {
+    Channel *channel = set_channel_from_command_number(context);
+    if (!channel) {
+        return SCPI_RES_ERR;
+    }
+
+    int32_t count;
+    if (!get_int_param(context, count, 1, ADC_MAX_OVERSAMPLING, 1)) {
+        return SCPI_RES_ERR;
+    }
+
+    channel->adc.plan.oversampling = (uint8_t)count;
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_sense_AverageCountQ(scpi_t * context) {
+    Channel *channel = set_channel_from_command_number(context);
+    if (!channel) {
+        return SCPI_RES_ERR;
+    }
+
+    SCPI_ResultInt(context, channel->adc.plan.oversampling);
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_sense_ReadbackRatio(scpi_t * context) {
+    Channel *channel = set_channel_from_command_number(context);
+    if (!channel) {
+        return SCPI_RES_ERR;
+    }
+
+    int32_t ratio;
+    if (!get_int_param(context, ratio, 0, ADC_MAX_READBACK_RATIO, 0)) {
+        return SCPI_RES_ERR;
+    }
+
+    channel->adc.plan.readback_ratio = (uint8_t)ratio;
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_sense_ReadbackRatioQ(scpi_t * context) {
+    Channel *channel = set_channel_from_command_number(context);
+    if (!channel) {
+        return SCPI_RES_ERR;
+    }
+
+    SCPI_ResultInt(context, channel->adc.plan.readback_ratio);
+
+    return SCPI_RES_OK;
+}
+
+}
+}
+} // namespace eez::psu::scpi
@@ -21,11 +21,19 @@
 #include "scpi_sour.h"
 
 #include "profile.h"
+#include "list.h"
+#include "trigger.h"
+#include "coupling.h"
+#include "ramp.h"
 
 #define I_STATE 1
 #define P_STATE 2
 #define U_STATE 3
 
+#define LIST_VOLTAGE 1
+#define LIST_CURRENT 2
+#define LIST_DWELL 3
+
 namespace eez {
 namespace psu {
 namespace scpi {
@@ -115,13 +123,113 @@ static scpi_result_t get_source_value(scpi_t * context, float value, float def)
     return result_float(context, value);
 }
 
-scpi_result_t set_delay(scpi_t *context, float &delay_var, float min, float max, float def) {
+static void set_channel_slew(Channel &channel, bool voltage, float slew) {
+    if (voltage) {
+        ramp::setVoltageSlew(channel, slew);
+    } else {
+        ramp::setCurrentSlew(channel, slew);
+    }
+}
+
+static scpi_result_t set_slew(scpi_t *context, bool voltage) {
+    Channel *channel = set_channel_from_command_number(context);
+    if (!channel) {
+        return SCPI_RES_ERR;
+    }
+
+    float min = voltage ? U_SLEW_MIN : I_SLEW_MIN;
+    float max = voltage ? U_SLEW_MAX : I_SLEW_MAX;
+
+    scpi_number_t param;
+    if (!SCPI_ParamNumber(context, scpi_special_numbers_def, &param, true)) {
+        return SCPI_RES_ERR;
+    }
+
+    float slew;
+    if (param.special) {
+        if (param.tag == SCPI_NUM_MAX || param.tag == SCPI_NUM_DEF) {
+            slew = max;
+        }
+        else if (param.tag == SCPI_NUM_MIN) {
+            slew = min;
+        }
+        else {
+            SCPI_ErrorPush(context, SCPI_ERROR_ILLEGAL_PARAMETER_VALUE);
+            return SCPI_RES_ERR;
+        }
+    }
+    else {
+        if (param.unit != SCPI_UNIT_NONE) {
+            SCPI_ErrorPush(context, SCPI_ERROR_INVALID_SUFFIX);
+            return SCPI_RES_ERR;
+        }
+
+        slew = (float)param.value;
+        if (slew < min || slew > max) {
+            SCPI_ErrorPush(context, SCPI_ERROR_DATA_OUT_OF_RANGE);
+            return SCPI_RES_ERR;
+        }
+    }
+
+    if (coupling::getType() == coupling::TYPE_NONE) {
+        set_channel_slew(*channel, voltage, slew);
+    } else {
+        // slew rate of the combined output is split between the coupled channels
+        if (slew < max) {
+            slew /= voltage ? coupling::getVoltageFactor(*channel) : coupling::getCurrentFactor(*channel);
+        }
+        set_channel_slew(Channel::get(0), voltage, slew);
+        set_channel_slew(Channel::get(1), voltage, slew);
+    }
+
+    return SCPI_RES_OK;
+}
+
+static scpi_result_t get_slew(scpi_t *context, bool voltage) {
+    Channel *channel = set_channel_from_command_number(context);
+    if (!channel) {
+        return SCPI_RES_ERR;
+    }
+
+    float min = voltage ? U_SLEW_MIN : I_SLEW_MIN;
+    float max = voltage ? U_SLEW_MAX : I_SLEW_MAX;
+
+    float slew = voltage ? ramp::getVoltageSlew(*channel) : ramp::getCurrentSlew(*channel);
+    if (slew < max) {
+        slew *= voltage ? coupling::getVoltageFactor(*channel) : coupling::getCurrentFactor(*channel);
+    }
+
+    return get_source_value(context, slew, min, max, max);
+}
+
+/// Triggered levels of the coupled channels are always staged together.
+static void set_triggered_voltage(Channel *channel, float voltage) {
+    if (coupling::getType() == coupling::TYPE_NONE) {
+        trigger::setVoltage(*channel, voltage);
+    } else {
+        trigger::setVoltage(Channel::get(0), voltage);
+        trigger::setVoltage(Channel::get(1), voltage);
+    }
+}
+
+static void set_triggered_current(Channel *channel, float current) {
+    if (coupling::getType() == coupling::TYPE_NONE) {
+        trigger::setCurrent(*channel, current);
+    } else {
+        trigger::setCurrent(Channel::get(0), current);
+        trigger::setCurrent(Channel::get(1), current);
+    }
+}
+
+scpi_result_t set_delay(scpi_t *context, Channel *channel, float &delay_var, float min, float max, float def) {
     float delay;
     if (!get_duration_param(context, delay, min, max, def)) {
         return SCPI_RES_ERR;
     }
 
     delay_var = delay;
+    channel->updateProtectionThresholds();
+    coupling::updateProtection(*channel);
     profile::save();
 
     return SCPI_RES_OK;
@@ -145,6 +253,7 @@ scpi_result_t set_state(scpi_t *context, Channel *channel, int type) {
     default:      channel->prot_conf.flags.u_state = state; break;
 	}
 
+    coupling::updateProtection(*channel);
     profile::save();
 
 	return SCPI_RES_OK;
@@ -183,17 +292,20 @@ scpi_result_t scpi_source_Current(scpi_t * context) {
         return SCPI_RES_ERR;
     }
 
-	if (current > channel->getCurrentLimit()) {
+    float u_factor = coupling::getVoltageFactor(*channel);
+    float i_factor = coupling::getCurrentFactor(*channel);
+
+	if (current > channel->getCurrentLimit() * i_factor) {
         SCPI_ErrorPush(context, SCPI_ERROR_CURRENT_LIMIT_EXCEEDED);
         return SCPI_RES_ERR;
 	}
 
-    if (current * channel->u.set > channel->getPowerLimit()) {
+    if (current * channel->u.set * u_factor > channel->getPowerLimit() * u_factor * i_factor) {
         SCPI_ErrorPush(context, SCPI_ERROR_POWER_LIMIT_EXCEEDED);
         return SCPI_RES_ERR;
     }
 
-    channel->setCurrent(current);
+    coupling::setCurrent(*channel, current);
 
     return SCPI_RES_OK;
 }
@@ -204,7 +316,10 @@ scpi_result_t scpi_source_CurrentQ(scpi_t * context) {
         return SCPI_RES_ERR;
     }
 
-    return get_source_value(context, channel->i.set, channel->i.min, channel->i.max, channel->i.def);
+    float factor = coupling::getCurrentFactor(*channel);
+
+    return get_source_value(context, channel->i.set * factor,
+        channel->i.min * factor, channel->i.max * factor, channel->i.def * factor);
 }
 
 scpi_result_t scpi_source_Voltage(scpi_t * context) {
@@ -227,17 +342,20 @@ scpi_result_t scpi_source_Voltage(scpi_t * context) {
         return SCPI_RES_ERR;
 	}
 
-	if (voltage > channel->getVoltageLimit()) {
+    float u_factor = coupling::getVoltageFactor(*channel);
+    float i_factor = coupling::getCurrentFactor(*channel);
+
+	if (voltage > channel->getVoltageLimit() * u_factor) {
         SCPI_ErrorPush(context, SCPI_ERROR_VOLTAGE_LIMIT_EXCEEDED);
         return SCPI_RES_ERR;
 	}
 
-	if (voltage * channel->i.set > channel->getPowerLimit()) {
+	if (voltage * channel->i.set * i_factor > channel->getPowerLimit() * u_factor * i_factor) {
         SCPI_ErrorPush(context, SCPI_ERROR_POWER_LIMIT_EXCEEDED);
         return SCPI_RES_ERR;
     }
 
-    channel->setVoltage(voltage);
+    coupling::setVoltage(*channel, voltage);
 
     return SCPI_RES_OK;
 }
@@ -248,14 +366,128 @@ scpi_result_t scpi_source_VoltageQ(scpi_t * context) {
         return SCPI_RES_ERR;
     }
 
+    float factor = coupling::getVoltageFactor(*channel);
+
 	float u;
 	if (channel->isRemoteProgrammingEnabled()) {
-		u = channel->u.mon_dac;
+		u = coupling::getVoltageMonDac(*channel);
 	} else {
-		u = channel->u.set;
+		u = channel->u.set * factor;
 	}
 
-    return get_source_value(context, u, channel->u.min, channel->u.max, channel->u.def);
+    return get_source_value(context, u, channel->u.min * factor, channel->u.max * factor, channel->u.def * factor);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+scpi_result_t scpi_source_CurrentSlew(scpi_t * context) {
+    return set_slew(context, false);
+}
+
+scpi_result_t scpi_source_CurrentSlewQ(scpi_t * context) {
+    return get_slew(context, false);
+}
+
+scpi_result_t scpi_source_VoltageSlew(scpi_t * context) {
+    return set_slew(context, true);
+}
+
+scpi_result_t scpi_source_VoltageSlewQ(scpi_t * context) {
+    return get_slew(context, true);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+scpi_result_t scpi_source_CurrentTriggered(scpi_t * context) {
+    Channel *channel = set_channel_from_command_number(context);
+    if (!channel) {
+        return SCPI_RES_ERR;
+    }
+
+    float current;
+    if (!get_current_param(context, current, channel, &channel->i)) {
+        return SCPI_RES_ERR;
+    }
+
+    if (trigger::isInitiated()) {
+        SCPI_ErrorPush(context, SCPI_ERROR_EXECUTION_ERROR);
+        return SCPI_RES_ERR;
+    }
+
+    float u_factor = coupling::getVoltageFactor(*channel);
+    float i_factor = coupling::getCurrentFactor(*channel);
+
+	if (current > channel->getCurrentLimit() * i_factor) {
+        SCPI_ErrorPush(context, SCPI_ERROR_CURRENT_LIMIT_EXCEEDED);
+        return SCPI_RES_ERR;
+	}
+
+    if (current * trigger::getVoltage(*channel) * u_factor > channel->getPowerLimit() * u_factor * i_factor) {
+        SCPI_ErrorPush(context, SCPI_ERROR_POWER_LIMIT_EXCEEDED);
+        return SCPI_RES_ERR;
+    }
+
+    set_triggered_current(channel, current / i_factor);
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_source_CurrentTriggeredQ(scpi_t * context) {
+    Channel *channel = set_channel_from_command_number(context);
+    if (!channel) {
+        return SCPI_RES_ERR;
+    }
+
+    float factor = coupling::getCurrentFactor(*channel);
+
+    return get_source_value(context, trigger::getCurrent(*channel) * factor,
+        channel->i.min * factor, channel->i.max * factor, channel->i.def * factor);
+}
+
+scpi_result_t scpi_source_VoltageTriggered(scpi_t * context) {
+    Channel *channel = set_channel_from_command_number(context);
+    if (!channel) {
+        return SCPI_RES_ERR;
+    }
+
+    float voltage;
+    if (!get_voltage_param(context, voltage, channel, &channel->u)) {
+        return SCPI_RES_ERR;
+    }
+
+	if (trigger::isInitiated() || channel->isRemoteProgrammingEnabled()) {
+        SCPI_ErrorPush(context, SCPI_ERROR_EXECUTION_ERROR);
+        return SCPI_RES_ERR;
+	}
+
+    float u_factor = coupling::getVoltageFactor(*channel);
+    float i_factor = coupling::getCurrentFactor(*channel);
+
+	if (voltage > channel->getVoltageLimit() * u_factor) {
+        SCPI_ErrorPush(context, SCPI_ERROR_VOLTAGE_LIMIT_EXCEEDED);
+        return SCPI_RES_ERR;
+	}
+
+	if (voltage * trigger::getCurrent(*channel) * i_factor > channel->getPowerLimit() * u_factor * i_factor) {
+        SCPI_ErrorPush(context, SCPI_ERROR_POWER_LIMIT_EXCEEDED);
+        return SCPI_RES_ERR;
+    }
+
+    set_triggered_voltage(channel, voltage / u_factor);
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_source_VoltageTriggeredQ(scpi_t * context) {
+    Channel *channel = set_channel_from_command_number(context);
+    if (!channel) {
+        return SCPI_RES_ERR;
+    }
+
+    float factor = coupling::getVoltageFactor(*channel);
+
+    return get_source_value(context, trigger::getVoltage(*channel) * factor,
+        channel->u.min * factor, channel->u.max * factor, channel->u.def * factor);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -304,7 +536,7 @@ scpi_result_t scpi_source_CurrentProtectionDelay(scpi_t * context) {
         return SCPI_RES_ERR;
     }
 
-    return set_delay(context, channel->prot_conf.i_delay,
+    return set_delay(context, channel, channel->prot_conf.i_delay,
         channel->OCP_MIN_DELAY, channel->OCP_MAX_DELAY, channel->OCP_DEFAULT_DELAY);
 }
 
@@ -350,12 +582,16 @@ scpi_result_t scpi_source_PowerProtectionLevel(scpi_t * context) {
         return SCPI_RES_ERR;
 	}
 
+    float factor = coupling::getPowerFactor(*channel);
+
 	float power;
-	if (!get_power_param(context, power, channel->OPP_MIN_LEVEL, channel->OPP_MAX_LEVEL, channel->OPP_DEFAULT_LEVEL)) {
+	if (!get_power_param(context, power, channel->OPP_MIN_LEVEL * factor, channel->OPP_MAX_LEVEL * factor, channel->OPP_DEFAULT_LEVEL * factor)) {
 		return SCPI_RES_ERR;
 	}
 
-    channel->prot_conf.p_level = power;
+    channel->prot_conf.p_level = power / factor;
+    channel->updateProtectionThresholds();
+    coupling::updateProtection(*channel);
     profile::save();
 
 	return SCPI_RES_OK;
@@ -367,8 +603,10 @@ scpi_result_t scpi_source_PowerProtectionLevelQ(scpi_t * context) {
         return SCPI_RES_ERR;
     }
     
-    return get_source_value(context, channel->prot_conf.p_level,
-        channel->OPP_MIN_LEVEL, channel->OPP_MAX_LEVEL, channel->OPP_DEFAULT_LEVEL);
+    float factor = coupling::getPowerFactor(*channel);
+
+    return get_source_value(context, channel->prot_conf.p_level * factor,
+        channel->OPP_MIN_LEVEL * factor, channel->OPP_MAX_LEVEL * factor, channel->OPP_DEFAULT_LEVEL * factor);
 }
 
 scpi_result_t scpi_source_PowerProtectionDelay(scpi_t * context) {
@@ -377,7 +615,7 @@ scpi_result_t scpi_source_PowerProtectionDelay(scpi_t * context) {
         return SCPI_RES_ERR;
     }
 
-    return set_delay(context, channel->prot_conf.p_delay,
+    return set_delay(context, channel, channel->prot_conf.p_delay,
         channel->OCP_MIN_DELAY, channel->OCP_MAX_DELAY, channel->OPP_DEFAULT_DELAY);
 }
 
@@ -423,12 +661,16 @@ scpi_result_t scpi_source_VoltageProtectionLevel(scpi_t * context) {
         return SCPI_RES_ERR;
 	}
 
+    float factor = coupling::getVoltageFactor(*channel);
+
     float voltage;
-    if (!get_voltage_protection_level_param(context, voltage, channel->u.set, channel->u.max, channel->u.max)) {
+    if (!get_voltage_protection_level_param(context, voltage, channel->u.set * factor, channel->u.max * factor, channel->u.max * factor)) {
         return SCPI_RES_ERR;
     }
 
-    channel->prot_conf.u_level = voltage;
+    channel->prot_conf.u_level = voltage / factor;
+    channel->updateProtectionThresholds();
+    coupling::updateProtection(*channel);
     profile::save();
 
 	return SCPI_RES_OK;
@@ -440,8 +682,10 @@ scpi_result_t scpi_source_VoltageProtectionLevelQ(scpi_t * context) {
         return SCPI_RES_ERR;
     }
     
-    return get_source_value(context, channel->prot_conf.u_level,
-        channel->u.set, channel->u.max, channel->u.max);
+    float factor = coupling::getVoltageFactor(*channel);
+
+    return get_source_value(context, channel->prot_conf.u_level * factor,
+        channel->u.set * factor, channel->u.max * factor, channel->u.max * factor);
 }
 
 scpi_result_t scpi_source_VoltageProtectionDelay(scpi_t * context) {
@@ -450,7 +694,7 @@ scpi_result_t scpi_source_VoltageProtectionDelay(scpi_t * context) {
         return SCPI_RES_ERR;
     }
 
-    return set_delay(context, channel->prot_conf.u_delay,
+    return set_delay(context, channel, channel->prot_conf.u_delay,
         channel->OVP_MIN_DELAY, channel->OVP_MAX_DELAY, channel->OVP_DEFAULT_DELAY);
 }
 
@@ -652,7 +896,7 @@ scpi_result_t scpi_source_CurrentLimit(scpi_t * context) {
         return SCPI_RES_ERR;
     }
 
-    channel->setCurrentLimit(limit);
+    coupling::setCurrentLimit(*channel, limit);
 
     return SCPI_RES_OK;
 }
@@ -663,7 +907,10 @@ scpi_result_t scpi_source_CurrentLimitQ(scpi_t * context) {
         return SCPI_RES_ERR;
     }
 
-    return get_source_value(context, channel->getCurrentLimit(), 0, channel->getMaxCurrentLimit(), channel->getMaxCurrentLimit());
+    float factor = coupling::getCurrentFactor(*channel);
+
+    return get_source_value(context, channel->getCurrentLimit() * factor, 0,
+        channel->getMaxCurrentLimit() * factor, channel->getMaxCurrentLimit() * factor);
 }
 
 scpi_result_t scpi_source_VoltageLimit(scpi_t * context) {
@@ -677,7 +924,7 @@ scpi_result_t scpi_source_VoltageLimit(scpi_t * context) {
         return SCPI_RES_ERR;
     }
 
-    channel->setVoltageLimit(limit);
+    coupling::setVoltageLimit(*channel, limit);
 
     return SCPI_RES_OK;
 }
@@ -688,7 +935,10 @@ scpi_result_t scpi_source_VoltageLimitQ(scpi_t * context) {
         return SCPI_RES_ERR;
     }
 
-    return get_source_value(context, channel->getVoltageLimit(), 0, channel->getVoltageMaxLimit(), channel->getVoltageMaxLimit());
+    float factor = coupling::getVoltageFactor(*channel);
+
+    return get_source_value(context, channel->getVoltageLimit() * factor, 0,
+        channel->getVoltageMaxLimit() * factor, channel->getVoltageMaxLimit() * factor);
 }
 
 scpi_result_t scpi_source_PowerLimit(scpi_t * context) {
@@ -702,7 +952,7 @@ scpi_result_t scpi_source_PowerLimit(scpi_t * context) {
         return SCPI_RES_ERR;
     }
 
-    channel->setPowerLimit(limit);
+    coupling::setPowerLimit(*channel, limit);
 
     return SCPI_RES_OK;
 }
@@ -713,7 +963,245 @@ scpi_result_t scpi_source_PowerLimitQ(scpi_t * context) {
         return SCPI_RES_ERR;
     }
 
-    return get_source_value(context, channel->getPowerLimit(), 0, channel->getPowerMaxLimit(), channel->getPowerMaxLimit());
+    float factor = coupling::getPowerFactor(*channel);
+
+    return get_source_value(context, channel->getPowerLimit() * factor, 0,
+        channel->getPowerMaxLimit() * factor, channel->getPowerMaxLimit() * factor);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+static scpi_result_t set_list(scpi_t *context, int type) {
+    Channel *channel = set_channel_from_command_number(context);
+    if (!channel) {
+        return SCPI_RES_ERR;
+    }
+
+    if (list::isRunning(*channel)) {
+        SCPI_ErrorPush(context, SCPI_ERROR_EXECUTION_ERROR);
+        return SCPI_RES_ERR;
+    }
+
+    float values[LIST_MAX_LENGTH];
+    uint16_t length = 0;
+
+    scpi_number_t param;
+    while (SCPI_ParamNumber(context, scpi_special_numbers_def, &param, length == 0)) {
+        if (length == LIST_MAX_LENGTH) {
+            SCPI_ErrorPush(context, SCPI_ERROR_TOO_MUCH_DATA);
+            return SCPI_RES_ERR;
+        }
+
+        float value;
+        if (type == LIST_VOLTAGE) {
+            if (!get_voltage_from_param(context, param, value, channel, &channel->u)) {
+                return SCPI_RES_ERR;
+            }
+        }
+        else if (type == LIST_CURRENT) {
+            if (!get_current_from_param(context, param, value, channel, &channel->i)) {
+                return SCPI_RES_ERR;
+            }
+        }
+        else {
+            if (!get_duration_from_param(context, param, value, LIST_MIN_DWELL, LIST_MAX_DWELL, LIST_DEF_DWELL)) {
+                return SCPI_RES_ERR;
+            }
+        }
+
+        values[length++] = value;
+    }
+
+    if (SCPI_ParamErrorOccurred(context)) {
+        return SCPI_RES_ERR;
+    }
+
+    if (type == LIST_VOLTAGE) {
+        list::setVoltageList(*channel, values, length);
+    }
+    else if (type == LIST_CURRENT) {
+        list::setCurrentList(*channel, values, length);
+    }
+    else {
+        list::setDwellList(*channel, values, length);
+    }
+
+    return SCPI_RES_OK;
+}
+
+static scpi_result_t get_list(scpi_t *context, int type) {
+    Channel *channel = set_channel_from_command_number(context);
+    if (!channel) {
+        return SCPI_RES_ERR;
+    }
+
+    const float *values;
+    uint16_t length;
+    if (type == LIST_VOLTAGE) {
+        values = list::getVoltageList(*channel, &length);
+    }
+    else if (type == LIST_CURRENT) {
+        values = list::getCurrentList(*channel, &length);
+    }
+    else {
+        values = list::getDwellList(*channel, &length);
+    }
+
+    if (length == 0) {
+        // empty voltage or current list means the immediate level is used for all the steps,
+        // dwell list must be set before the list can be started
+        if (type == LIST_VOLTAGE) {
+            result_float(context, channel->u.set);
+        }
+        else if (type == LIST_CURRENT) {
+            result_float(context, channel->i.set);
+        }
+        else {
+            SCPI_ErrorPush(context, SCPI_ERROR_EXECUTION_ERROR);
+            return SCPI_RES_ERR;
+        }
+        return SCPI_RES_OK;
+    }
+
+    for (uint16_t i = 0; i < length; ++i) {
+        result_float(context, values[i]);
+    }
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_source_ListVoltage(scpi_t * context) {
+    return set_list(context, LIST_VOLTAGE);
+}
+
+scpi_result_t scpi_source_ListVoltageQ(scpi_t * context) {
+    return get_list(context, LIST_VOLTAGE);
+}
+
+scpi_result_t scpi_source_ListCurrent(scpi_t * context) {
+    return set_list(context, LIST_CURRENT);
+}
+
+scpi_result_t scpi_source_ListCurrentQ(scpi_t * context) {
+    return get_list(context, LIST_CURRENT);
+}
+
+scpi_result_t scpi_source_ListDwell(scpi_t * context) {
+    return set_list(context, LIST_DWELL);
+}
+
+scpi_result_t scpi_source_ListDwellQ(scpi_t * context) {
+    return get_list(context, LIST_DWELL);
+}
+
+scpi_result_t scpi_source_ListCount(scpi_t * context) {
+    Channel *channel = set_channel_from_command_number(context);
+    if (!channel) {
+        return SCPI_RES_ERR;
+    }
+
+    scpi_number_t param;
+    if (!SCPI_ParamNumber(context, scpi_special_numbers_def, &param, true)) {
+        return SCPI_RES_ERR;
+    }
+
+    uint16_t count;
+    if (param.special) {
+        if (param.tag == SCPI_NUM_INF) {
+            count = 0;
+        }
+        else if (param.tag == SCPI_NUM_MIN || param.tag == SCPI_NUM_DEF) {
+            count = 1;
+        }
+        else if (param.tag == SCPI_NUM_MAX) {
+            count = 65535;
+        }
+        else {
+            SCPI_ErrorPush(context, SCPI_ERROR_ILLEGAL_PARAMETER_VALUE);
+            return SCPI_RES_ERR;
+        }
+    }
+    else {
+        if (param.unit != SCPI_UNIT_NONE) {
+            SCPI_ErrorPush(context, SCPI_ERROR_INVALID_SUFFIX);
+            return SCPI_RES_ERR;
+        }
+
+        if (param.value < 1 || param.value > 65535) {
+            SCPI_ErrorPush(context, SCPI_ERROR_DATA_OUT_OF_RANGE);
+            return SCPI_RES_ERR;
+        }
+
+        count = (uint16_t)param.value;
+    }
+
+    list::setListCount(*channel, count);
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_source_ListCountQ(scpi_t * context) {
+    Channel *channel = set_channel_from_command_number(context);
+    if (!channel) {
+        return SCPI_RES_ERR;
+    }
+
+    uint16_t count = list::getListCount(*channel);
+    if (count == 0) {
+        SCPI_ResultText(context, "INF");
+    }
+    else {
+        SCPI_ResultInt(context, count);
+    }
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_source_ListState(scpi_t * context) {
+    Channel *channel = set_channel_from_command_number(context);
+    if (!channel) {
+        return SCPI_RES_ERR;
+    }
+
+    bool state;
+    if (!SCPI_ParamBool(context, &state, TRUE)) {
+        return SCPI_RES_ERR;
+    }
+
+    if (state) {
+        int16_t err;
+        if (!list::start(*channel, err)) {
+            SCPI_ErrorPush(context, err);
+            return SCPI_RES_ERR;
+        }
+    }
+    else {
+        list::stop(*channel);
+    }
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_source_ListStateQ(scpi_t * context) {
+    Channel *channel = set_channel_from_command_number(context);
+    if (!channel) {
+        return SCPI_RES_ERR;
+    }
+
+    SCPI_ResultBool(context, list::isRunning(*channel));
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_source_ListStepQ(scpi_t * context) {
+    Channel *channel = set_channel_from_command_number(context);
+    if (!channel) {
+        return SCPI_RES_ERR;
+    }
+
+    SCPI_ResultInt(context, list::getCurrentStep(*channel));
+
+    return SCPI_RES_OK;
 }
 
 }
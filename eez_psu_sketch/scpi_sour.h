@@ -23,6 +23,14 @@
     SCPI_COMMAND("[SOURce#]:CURRent[:LEVel][:IMMediate][:AMPLitude]?", scpi_source_CurrentQ) \
     SCPI_COMMAND("[SOURce#]:VOLTage[:LEVel][:IMMediate][:AMPLitude]", scpi_source_Voltage) \
     SCPI_COMMAND("[SOURce#]:VOLTage[:LEVel][:IMMediate][:AMPLitude]?", scpi_source_VoltageQ) \
+    SCPI_COMMAND("[SOURce#]:CURRent[:LEVel]:TRIGgered[:AMPLitude]", scpi_source_CurrentTriggered) \
+    SCPI_COMMAND("[SOURce#]:CURRent[:LEVel]:TRIGgered[:AMPLitude]?", scpi_source_CurrentTriggeredQ) \
+    SCPI_COMMAND("[SOURce#]:VOLTage[:LEVel]:TRIGgered[:AMPLitude]", scpi_source_VoltageTriggered) \
+    SCPI_COMMAND("[SOURce#]:VOLTage[:LEVel]:TRIGgered[:AMPLitude]?", scpi_source_VoltageTriggeredQ) \
+    SCPI_COMMAND("[SOURce#]:CURRent:SLEW[:IMMediate]", scpi_source_CurrentSlew) \
+    SCPI_COMMAND("[SOURce#]:CURRent:SLEW[:IMMediate]?", scpi_source_CurrentSlewQ) \
+    SCPI_COMMAND("[SOURce#]:VOLTage:SLEW[:IMMediate]", scpi_source_VoltageSlew) \
+    SCPI_COMMAND("[SOURce#]:VOLTage:SLEW[:IMMediate]?", scpi_source_VoltageSlewQ) \
     SCPI_COMMAND("[SOURce#]:CURRent[:LEVel][:IMMediate]:STEP[:INCRement]", scpi_source_CurrentStep) \
     SCPI_COMMAND("[SOURce#]:CURRent[:LEVel][:IMMediate]:STEP[:INCRement]?", scpi_source_CurrentStepQ) \
     SCPI_COMMAND("[SOURce#]:VOLTage[:LEVel][:IMMediate]:STEP[:INCRement]", scpi_source_VoltageStep) \
@@ -60,4 +68,15 @@
     SCPI_COMMAND("[SOURce#]:VOLTage:LIMit[:POSitive][:IMMediate][:AMPLitude]?", scpi_source_VoltageLimitQ) \
     SCPI_COMMAND("[SOURce#]:POWer:LIMit", scpi_source_PowerLimit) \
     SCPI_COMMAND("[SOURce#]:POWer:LIMit?", scpi_source_PowerLimitQ) \
+    SCPI_COMMAND("[SOURce#]:LIST:VOLTage[:LEVel]", scpi_source_ListVoltage) \
+    SCPI_COMMAND("[SOURce#]:LIST:VOLTage[:LEVel]?", scpi_source_ListVoltageQ) \
+    SCPI_COMMAND("[SOURce#]:LIST:CURRent[:LEVel]", scpi_source_ListCurrent) \
+    SCPI_COMMAND("[SOURce#]:LIST:CURRent[:LEVel]?", scpi_source_ListCurrentQ) \
+    SCPI_COMMAND("[SOURce#]:LIST:DWELl", scpi_source_ListDwell) \
+    SCPI_COMMAND("[SOURce#]:LIST:DWELl?", scpi_source_ListDwellQ) \
+    SCPI_COMMAND("[SOURce#]:LIST:COUNt", scpi_source_ListCount) \
+    SCPI_COMMAND("[SOURce#]:LIST:COUNt?", scpi_source_ListCountQ) \
+    SCPI_COMMAND("[SOURce#]:LIST:STATe", scpi_source_ListState) \
+    SCPI_COMMAND("[SOURce#]:LIST:STATe?", scpi_source_ListStateQ) \
+    SCPI_COMMAND("[SOURce#]:LIST:STEP?", scpi_source_ListStepQ) \
 
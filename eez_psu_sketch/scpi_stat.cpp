@@ -26,7 +26,39 @@ namespace scpi {
 
 ////////////////////////////////////////////////////////////////////////////////
 
+static scpi_result_t set_psu_reg(scpi_t * context, scpi_psu_reg_name_t name) {
+    int32_t newVal;
+    if (SCPI_ParamInt32(context, &newVal, TRUE)) {
+        reg_set(context, name, (scpi_reg_val_t)newVal);
+        return SCPI_RES_OK;
+    }
+    return SCPI_RES_ERR;
+}
+
+static scpi_result_t get_psu_reg(scpi_t * context, scpi_psu_reg_name_t name) {
+    /* return value */
+    SCPI_ResultInt32(context, reg_get(context, name));
+
+    return SCPI_RES_OK;
+}
+
+static bool get_isum_reg(scpi_t * context, scpi_psu_reg_name_t reg1, scpi_psu_reg_name_t reg2, scpi_psu_reg_name_t &reg) {
+    scpi_psu_t *psu_context = (scpi_psu_t *)context->user_context;
+
+    int32_t ch;
+    SCPI_CommandNumbers(context, &ch, 1, psu_context->selected_channel_index);
+    if (ch < 1 || ch > min(CH_NUM, 2)) {
+        SCPI_ErrorPush(context, SCPI_ERROR_HEADER_SUFFIX_OUTOFRANGE);
+        return false;
+    }
+
+    reg = ch == 1 ? reg1 : reg2;
+    return true;
+}
+
 scpi_result_t scpi_stat_QuestionableEventQ(scpi_t * context) {
+    psu::updateStatusRegisters();
+
     /* return value */
     SCPI_ResultInt32(context, SCPI_RegGet(context, SCPI_REG_QUES));
 
@@ -37,6 +69,8 @@ scpi_result_t scpi_stat_QuestionableEventQ(scpi_t * context) {
 }
 
 scpi_result_t scpi_stat_QuestionableConditionQ(scpi_t * context) {
+    psu::updateStatusRegisters();
+
     /* return value */
     SCPI_ResultInt32(context, reg_get(context, SCPI_PSU_REG_QUES_COND));
 
@@ -59,8 +93,26 @@ scpi_result_t scpi_stat_QuestionableEnableQ(scpi_t * context) {
     return SCPI_RES_OK;
 }
 
+scpi_result_t scpi_stat_QuestionablePtr(scpi_t * context) {
+    return set_psu_reg(context, SCPI_PSU_REG_QUES_PTR);
+}
+
+scpi_result_t scpi_stat_QuestionablePtrQ(scpi_t * context) {
+    return get_psu_reg(context, SCPI_PSU_REG_QUES_PTR);
+}
+
+scpi_result_t scpi_stat_QuestionableNtr(scpi_t * context) {
+    return set_psu_reg(context, SCPI_PSU_REG_QUES_NTR);
+}
+
+scpi_result_t scpi_stat_QuestionableNtrQ(scpi_t * context) {
+    return get_psu_reg(context, SCPI_PSU_REG_QUES_NTR);
+}
+
 
 scpi_result_t scpi_stat_OperationEventQ(scpi_t * context) {
+    psu::updateStatusRegisters();
+
     /* return value */
     SCPI_ResultInt32(context, SCPI_RegGet(context, SCPI_REG_OPER));
 
@@ -71,6 +123,8 @@ scpi_result_t scpi_stat_OperationEventQ(scpi_t * context) {
 }
 
 scpi_result_t scpi_stat_OperationConditionQ(scpi_t * context) {
+    psu::updateStatusRegisters();
+
     /* return value */
     SCPI_ResultInt32(context, reg_get(context, SCPI_PSU_REG_OPER_COND));
 
@@ -93,7 +147,25 @@ scpi_result_t scpi_stat_OperationEnableQ(scpi_t * context) {
     return SCPI_RES_OK;
 }
 
+scpi_result_t scpi_stat_OperationPtr(scpi_t * context) {
+    return set_psu_reg(context, SCPI_PSU_REG_OPER_PTR);
+}
+
+scpi_result_t scpi_stat_OperationPtrQ(scpi_t * context) {
+    return get_psu_reg(context, SCPI_PSU_REG_OPER_PTR);
+}
+
+scpi_result_t scpi_stat_OperationNtr(scpi_t * context) {
+    return set_psu_reg(context, SCPI_PSU_REG_OPER_NTR);
+}
+
+scpi_result_t scpi_stat_OperationNtrQ(scpi_t * context) {
+    return get_psu_reg(context, SCPI_PSU_REG_OPER_NTR);
+}
+
 scpi_result_t scpi_stat_QuestionableInstrumentEventQ(scpi_t * context) {
+    psu::updateStatusRegisters();
+
     /* return value */
     SCPI_ResultInt32(context, reg_get(context, SCPI_PSU_REG_QUES_INST_EVENT));
 
@@ -104,6 +176,8 @@ scpi_result_t scpi_stat_QuestionableInstrumentEventQ(scpi_t * context) {
 }
 
 scpi_result_t scpi_stat_QuestionableInstrumentConditionQ(scpi_t * context) {
+    psu::updateStatusRegisters();
+
     /* return value */
     SCPI_ResultInt32(context, reg_get(context, SCPI_PSU_REG_QUES_INST_COND));
 
@@ -126,7 +200,25 @@ scpi_result_t scpi_stat_QuestionableInstrumentEnableQ(scpi_t * context) {
     return SCPI_RES_OK;
 }
 
+scpi_result_t scpi_stat_QuestionableInstrumentPtr(scpi_t * context) {
+    return set_psu_reg(context, SCPI_PSU_REG_QUES_INST_PTR);
+}
+
+scpi_result_t scpi_stat_QuestionableInstrumentPtrQ(scpi_t * context) {
+    return get_psu_reg(context, SCPI_PSU_REG_QUES_INST_PTR);
+}
+
+scpi_result_t scpi_stat_QuestionableInstrumentNtr(scpi_t * context) {
+    return set_psu_reg(context, SCPI_PSU_REG_QUES_INST_NTR);
+}
+
+scpi_result_t scpi_stat_QuestionableInstrumentNtrQ(scpi_t * context) {
+    return get_psu_reg(context, SCPI_PSU_REG_QUES_INST_NTR);
+}
+
 scpi_result_t scpi_stat_OperationInstrumentEventQ(scpi_t * context) {
+    psu::updateStatusRegisters();
+
     /* return value */
     SCPI_ResultInt32(context, reg_get(context, SCPI_PSU_REG_OPER_INST_EVENT));
 
@@ -137,6 +229,8 @@ scpi_result_t scpi_stat_OperationInstrumentEventQ(scpi_t * context) {
 }
 
 scpi_result_t scpi_stat_OperationInstrumentConditionQ(scpi_t * context) {
+    psu::updateStatusRegisters();
+
     /* return value */
     SCPI_ResultInt32(context, reg_get(context, SCPI_PSU_REG_OPER_INST_COND));
 
@@ -159,6 +253,22 @@ scpi_result_t scpi_stat_OperationInstrumentEnableQ(scpi_t * context) {
     return SCPI_RES_OK;
 }
 
+scpi_result_t scpi_stat_OperationInstrumentPtr(scpi_t * context) {
+    return set_psu_reg(context, SCPI_PSU_REG_OPER_INST_PTR);
+}
+
+scpi_result_t scpi_stat_OperationInstrumentPtrQ(scpi_t * context) {
+    return get_psu_reg(context, SCPI_PSU_REG_OPER_INST_PTR);
+}
+
+scpi_result_t scpi_stat_OperationInstrumentNtr(scpi_t * context) {
+    return set_psu_reg(context, SCPI_PSU_REG_OPER_INST_NTR);
+}
+
+scpi_result_t scpi_stat_OperationInstrumentNtrQ(scpi_t * context) {
+    return get_psu_reg(context, SCPI_PSU_REG_OPER_INST_NTR);
+}
+
 scpi_result_t scpi_stat_QuestionableInstrumentISummaryEventQ(scpi_t * context) {
     scpi_psu_t *psu_context = (scpi_psu_t *)context->user_context;
 
@@ -171,6 +281,8 @@ scpi_result_t scpi_stat_QuestionableInstrumentISummaryEventQ(scpi_t * context) {
 
     scpi_psu_reg_name_t isumReg = ch == 1 ? SCPI_PSU_CH_REG_QUES_INST_ISUM_EVENT1 : SCPI_PSU_CH_REG_QUES_INST_ISUM_EVENT2;
 
+    psu::updateStatusRegisters();
+
     /* return value */
     SCPI_ResultInt32(context, reg_get(context, isumReg));
 
@@ -192,6 +304,8 @@ scpi_result_t scpi_stat_QuestionableInstrumentISummaryConditionQ(scpi_t * contex
 
     scpi_psu_reg_name_t isumReg = ch == 1 ? SCPI_PSU_CH_REG_QUES_INST_ISUM_COND1 : SCPI_PSU_CH_REG_QUES_INST_ISUM_COND2;
 
+    psu::updateStatusRegisters();
+
     /* return value */
     SCPI_ResultInt32(context, reg_get(context, isumReg));
 
@@ -236,6 +350,38 @@ scpi_result_t scpi_stat_QuestionableInstrumentISummaryEnableQ(scpi_t * context)
     return SCPI_RES_OK;
 }
 
+scpi_result_t scpi_stat_QuestionableInstrumentISummaryPtr(scpi_t * context) {
+    scpi_psu_reg_name_t reg;
+    if (!get_isum_reg(context, SCPI_PSU_CH_REG_QUES_INST_ISUM_PTR1, SCPI_PSU_CH_REG_QUES_INST_ISUM_PTR2, reg)) {
+        return SCPI_RES_OK;
+    }
+    return set_psu_reg(context, reg);
+}
+
+scpi_result_t scpi_stat_QuestionableInstrumentISummaryPtrQ(scpi_t * context) {
+    scpi_psu_reg_name_t reg;
+    if (!get_isum_reg(context, SCPI_PSU_CH_REG_QUES_INST_ISUM_PTR1, SCPI_PSU_CH_REG_QUES_INST_ISUM_PTR2, reg)) {
+        return SCPI_RES_OK;
+    }
+    return get_psu_reg(context, reg);
+}
+
+scpi_result_t scpi_stat_QuestionableInstrumentISummaryNtr(scpi_t * context) {
+    scpi_psu_reg_name_t reg;
+    if (!get_isum_reg(context, SCPI_PSU_CH_REG_QUES_INST_ISUM_NTR1, SCPI_PSU_CH_REG_QUES_INST_ISUM_NTR2, reg)) {
+        return SCPI_RES_OK;
+    }
+    return set_psu_reg(context, reg);
+}
+
+scpi_result_t scpi_stat_QuestionableInstrumentISummaryNtrQ(scpi_t * context) {
+    scpi_psu_reg_name_t reg;
+    if (!get_isum_reg(context, SCPI_PSU_CH_REG_QUES_INST_ISUM_NTR1, SCPI_PSU_CH_REG_QUES_INST_ISUM_NTR2, reg)) {
+        return SCPI_RES_OK;
+    }
+    return get_psu_reg(context, reg);
+}
+
 scpi_result_t scpi_stat_OperationInstrumentISummaryEventQ(scpi_t * context) {
     scpi_psu_t *psu_context = (scpi_psu_t *)context->user_context;
 
@@ -248,6 +394,8 @@ scpi_result_t scpi_stat_OperationInstrumentISummaryEventQ(scpi_t * context) {
 
     scpi_psu_reg_name_t isumReg = ch == 1 ? SCPI_PSU_CH_REG_OPER_INST_ISUM_EVENT1 : SCPI_PSU_CH_REG_OPER_INST_ISUM_EVENT2;
 
+    psu::updateStatusRegisters();
+
     /* return value */
     SCPI_ResultInt32(context, reg_get(context, isumReg));
 
@@ -269,6 +417,8 @@ scpi_result_t scpi_stat_OperationInstrumentISummaryConditionQ(scpi_t * context)
 
     scpi_psu_reg_name_t isumReg = ch == 1 ? SCPI_PSU_CH_REG_OPER_INST_ISUM_COND1 : SCPI_PSU_CH_REG_OPER_INST_ISUM_COND2;
 
+    psu::updateStatusRegisters();
+
     /* return value */
     SCPI_ResultInt32(context, reg_get(context, isumReg));
 
@@ -313,6 +463,38 @@ scpi_result_t scpi_stat_OperationInstrumentISummaryEnableQ(scpi_t * context) {
     return SCPI_RES_OK;
 }
 
+scpi_result_t scpi_stat_OperationInstrumentISummaryPtr(scpi_t * context) {
+    scpi_psu_reg_name_t reg;
+    if (!get_isum_reg(context, SCPI_PSU_CH_REG_OPER_INST_ISUM_PTR1, SCPI_PSU_CH_REG_OPER_INST_ISUM_PTR2, reg)) {
+        return SCPI_RES_OK;
+    }
+    return set_psu_reg(context, reg);
+}
+
+scpi_result_t scpi_stat_OperationInstrumentISummaryPtrQ(scpi_t * context) {
+    scpi_psu_reg_name_t reg;
+    if (!get_isum_reg(context, SCPI_PSU_CH_REG_OPER_INST_ISUM_PTR1, SCPI_PSU_CH_REG_OPER_INST_ISUM_PTR2, reg)) {
+        return SCPI_RES_OK;
+    }
+    return get_psu_reg(context, reg);
+}
+
+scpi_result_t scpi_stat_OperationInstrumentISummaryNtr(scpi_t * context) {
+    scpi_psu_reg_name_t reg;
+    if (!get_isum_reg(context, SCPI_PSU_CH_REG_OPER_INST_ISUM_NTR1, SCPI_PSU_CH_REG_OPER_INST_ISUM_NTR2, reg)) {
+        return SCPI_RES_OK;
+    }
+    return set_psu_reg(context, reg);
+}
+
+scpi_result_t scpi_stat_OperationInstrumentISummaryNtrQ(scpi_t * context) {
+    scpi_psu_reg_name_t reg;
+    if (!get_isum_reg(context, SCPI_PSU_CH_REG_OPER_INST_ISUM_NTR1, SCPI_PSU_CH_REG_OPER_INST_ISUM_NTR2, reg)) {
+        return SCPI_RES_OK;
+    }
+    return get_psu_reg(context, reg);
+}
+
 scpi_result_t scpi_stat_Preset(scpi_t * context) {
     scpi_psu_t *psu_context = (scpi_psu_t *)context->user_context;
 
@@ -329,6 +511,8 @@ scpi_result_t scpi_stat_Preset(scpi_t * context) {
     reg_set(context, SCPI_PSU_CH_REG_QUES_INST_ISUM_ENABLE2, 0);
     reg_set(context, SCPI_PSU_CH_REG_OPER_INST_ISUM_ENABLE2, 0);
 
+    reg_preset_transitions(context);
+
     return SCPI_RES_OK;
 }
 
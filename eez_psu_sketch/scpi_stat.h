@@ -23,25 +23,49 @@
     SCPI_COMMAND("STATus:QUEStionable:CONDition?", scpi_stat_QuestionableConditionQ) \
     SCPI_COMMAND("STATus:QUEStionable:ENABle", scpi_stat_QuestionableEnable) \
     SCPI_COMMAND("STATus:QUEStionable:ENABle?", scpi_stat_QuestionableEnableQ) \
+    SCPI_COMMAND("STATus:QUEStionable:PTRansition", scpi_stat_QuestionablePtr) \
+    SCPI_COMMAND("STATus:QUEStionable:PTRansition?", scpi_stat_QuestionablePtrQ) \
+    SCPI_COMMAND("STATus:QUEStionable:NTRansition", scpi_stat_QuestionableNtr) \
+    SCPI_COMMAND("STATus:QUEStionable:NTRansition?", scpi_stat_QuestionableNtrQ) \
     SCPI_COMMAND("STATus:OPERation[:EVENt]?", scpi_stat_OperationEventQ) \
     SCPI_COMMAND("STATus:OPERation:CONDition?", scpi_stat_OperationConditionQ) \
     SCPI_COMMAND("STATus:OPERation:ENABle", scpi_stat_OperationEnable) \
     SCPI_COMMAND("STATus:OPERation:ENABle?", scpi_stat_OperationEnableQ) \
+    SCPI_COMMAND("STATus:OPERation:PTRansition", scpi_stat_OperationPtr) \
+    SCPI_COMMAND("STATus:OPERation:PTRansition?", scpi_stat_OperationPtrQ) \
+    SCPI_COMMAND("STATus:OPERation:NTRansition", scpi_stat_OperationNtr) \
+    SCPI_COMMAND("STATus:OPERation:NTRansition?", scpi_stat_OperationNtrQ) \
     SCPI_COMMAND("STATus:QUEStionable:INSTrument[:EVENt]?", scpi_stat_QuestionableInstrumentEventQ) \
     SCPI_COMMAND("STATus:QUEStionable:INSTrument:CONDition?", scpi_stat_QuestionableInstrumentConditionQ) \
     SCPI_COMMAND("STATus:QUEStionable:INSTrument:ENABle", scpi_stat_QuestionableInstrumentEnable) \
     SCPI_COMMAND("STATus:QUEStionable:INSTrument:ENABle?", scpi_stat_QuestionableInstrumentEnableQ) \
+    SCPI_COMMAND("STATus:QUEStionable:INSTrument:PTRansition", scpi_stat_QuestionableInstrumentPtr) \
+    SCPI_COMMAND("STATus:QUEStionable:INSTrument:PTRansition?", scpi_stat_QuestionableInstrumentPtrQ) \
+    SCPI_COMMAND("STATus:QUEStionable:INSTrument:NTRansition", scpi_stat_QuestionableInstrumentNtr) \
+    SCPI_COMMAND("STATus:QUEStionable:INSTrument:NTRansition?", scpi_stat_QuestionableInstrumentNtrQ) \
     SCPI_COMMAND("STATus:OPERation:INSTrument[:EVENt]?", scpi_stat_OperationInstrumentEventQ) \
     SCPI_COMMAND("STATus:OPERation:INSTrument:CONDition?", scpi_stat_OperationInstrumentConditionQ) \
     SCPI_COMMAND("STATus:OPERation:INSTrument:ENABle", scpi_stat_OperationInstrumentEnable) \
     SCPI_COMMAND("STATus:OPERation:INSTrument:ENABle?", scpi_stat_OperationInstrumentEnableQ) \
+    SCPI_COMMAND("STATus:OPERation:INSTrument:PTRansition", scpi_stat_OperationInstrumentPtr) \
+    SCPI_COMMAND("STATus:OPERation:INSTrument:PTRansition?", scpi_stat_OperationInstrumentPtrQ) \
+    SCPI_COMMAND("STATus:OPERation:INSTrument:NTRansition", scpi_stat_OperationInstrumentNtr) \
+    SCPI_COMMAND("STATus:OPERation:INSTrument:NTRansition?", scpi_stat_OperationInstrumentNtrQ) \
     SCPI_COMMAND("STATus:QUEStionable:INSTrument:ISUMmary#[:EVENt]?", scpi_stat_QuestionableInstrumentISummaryEventQ) \
     SCPI_COMMAND("STATus:QUEStionable:INSTrument:ISUMmary#:CONDition?", scpi_stat_QuestionableInstrumentISummaryConditionQ) \
     SCPI_COMMAND("STATus:QUEStionable:INSTrument:ISUMmary#:ENABle", scpi_stat_QuestionableInstrumentISummaryEnable) \
     SCPI_COMMAND("STATus:QUEStionable:INSTrument:ISUMmary#:ENABle?", scpi_stat_QuestionableInstrumentISummaryEnableQ) \
+    SCPI_COMMAND("STATus:QUEStionable:INSTrument:ISUMmary#:PTRansition", scpi_stat_QuestionableInstrumentISummaryPtr) \
+    SCPI_COMMAND("STATus:QUEStionable:INSTrument:ISUMmary#:PTRansition?", scpi_stat_QuestionableInstrumentISummaryPtrQ) \
+    SCPI_COMMAND("STATus:QUEStionable:INSTrument:ISUMmary#:NTRansition", scpi_stat_QuestionableInstrumentISummaryNtr) \
+    SCPI_COMMAND("STATus:QUEStionable:INSTrument:ISUMmary#:NTRansition?", scpi_stat_QuestionableInstrumentISummaryNtrQ) \
     SCPI_COMMAND("STATus:OPERation:INSTrument:ISUMmary#[:EVENt]?", scpi_stat_OperationInstrumentISummaryEventQ) \
     SCPI_COMMAND("STATus:OPERation:INSTrument:ISUMmary#:CONDition?", scpi_stat_OperationInstrumentISummaryConditionQ) \
     SCPI_COMMAND("STATus:OPERation:INSTrument:ISUMmary#:ENABle", scpi_stat_OperationInstrumentISummaryEnable) \
     SCPI_COMMAND("STATus:OPERation:INSTrument:ISUMmary#:ENABle?", scpi_stat_OperationInstrumentISummaryEnableQ) \
+    SCPI_COMMAND("STATus:OPERation:INSTrument:ISUMmary#:PTRansition", scpi_stat_OperationInstrumentISummaryPtr) \
+    SCPI_COMMAND("STATus:OPERation:INSTrument:ISUMmary#:PTRansition?", scpi_stat_OperationInstrumentISummaryPtrQ) \
+    SCPI_COMMAND("STATus:OPERation:INSTrument:ISUMmary#:NTRansition", scpi_stat_OperationInstrumentISummaryNtr) \
+    SCPI_COMMAND("STATus:OPERation:INSTrument:ISUMmary#:NTRansition?", scpi_stat_OperationInstrumentISummaryNtrQ) \
     SCPI_COMMAND("STATus:PREset", scpi_stat_Preset) \
 
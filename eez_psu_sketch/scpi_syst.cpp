@@ -21,8 +21,10 @@
 #include "scpi_syst.h"
 
 #include "datetime.h"
+#include "event_queue.h"
 #include "sound.h"
 #include "profile.h"
+#include "telemetry.h"
 
 namespace eez {
 namespace psu {
@@ -38,14 +40,297 @@ scpi_result_t scpi_syst_CapabilityQ(scpi_t * context) {
     return SCPI_RES_OK;
 }
 
+static void event_time_to_string(uint32_t time, char *buffer) {
+    int year, month, day, hour, minute, second;
+    datetime::breakTime(time, year, month, day, hour, minute, second);
+    sprintf_P(buffer, PSTR("%d-%02d-%02d %02d:%02d:%02d"), year, month, day, hour, minute, second);
+}
+
+/// Error queue stores only the code, repeat count and getErrorTime() of each entry,
+/// the text is formatted here, when the error is read, as "<text>[;repeated N times][;YYYY-MM-DD hh:mm:ss]".
 scpi_result_t scpi_syst_ErrorNextQ(scpi_t * context) {
-    return SCPI_SystemErrorNextQ(context);
+    scpi_error_info_t info;
+    SCPI_ErrorPopInfo(context, &info);
+
+    char text[96];
+    strncpy(text, SCPI_ErrorTranslate(info.code), sizeof(text) - 48);
+    text[sizeof(text) - 48] = 0;
+    size_t len = strlen(text);
+
+    if (info.repeat > 1) {
+        len += sprintf_P(text + len, PSTR(";repeated %u times"), (unsigned)info.repeat);
+    }
+
+    uint8_t year, month, day, hour, minute, second;
+    if (info.code != 0 && datetime::getDateTime(year, month, day, hour, minute, second)) {
+        // go back from the current date and time by the age of the error
+        uint32_t time = datetime::makeTime(2000 + year, month, day, hour, minute, second) - (getErrorTime() - info.time) / 1000;
+        text[len++] = ';';
+        event_time_to_string(time, text + len);
+    }
+
+    SCPI_ResultInt32(context, info.code);
+    SCPI_ResultText(context, text);
+
+    return SCPI_RES_OK;
 }
 
 scpi_result_t scpi_syst_ErrorCountQ(scpi_t * context) {
     return SCPI_SystemErrorCountQ(context);
 }
 
+/// Returns total number of errors, number of errors collapsed into the same previous
+/// error in the queue, number of errors lost due to full queue and then pairs of
+/// error code and number of occurrences, all counted since the last *CLS.
+scpi_result_t scpi_syst_ErrorStatisticsQ(scpi_t * context) {
+    scpi_error_stat_t &stat = context->error_stat;
+
+    SCPI_ResultUInt32(context, stat.total);
+    SCPI_ResultUInt32(context, stat.collapsed);
+    SCPI_ResultUInt32(context, stat.lost);
+
+    for (int i = 0; i < SCPI_ERROR_STAT_CODES && stat.counts[i] > 0; ++i) {
+        SCPI_ResultInt(context, stat.codes[i]);
+        SCPI_ResultUInt32(context, stat.counts[i]);
+    }
+
+    return SCPI_RES_OK;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+static scpi_choice_def_t event_type_choice[] = {
+    { "ALL", event_queue::EVENT_TYPE_NONE },
+    { "INFO", event_queue::EVENT_TYPE_INFO },
+    { "WARNing", event_queue::EVENT_TYPE_WARNING },
+    { "ERRor", event_queue::EVENT_TYPE_ERROR },
+    SCPI_CHOICE_LIST_END /* termination of option list */
+};
+
+static scpi_choice_def_t event_channel_choice[] = {
+    { "ALL", 0 },
+    { "CH1", 1 },
+    { "CH2", 2 },
+    SCPI_CHOICE_LIST_END /* termination of option list */
+};
+
+/// Date and time parameter in the "YYYY-MM-DD hh:mm:ss" format, empty string for no limit (0).
+static bool get_event_time_param(scpi_t *context, uint32_t &time, scpi_bool_t mandatory) {
+    const char *text;
+    size_t text_len;
+    if (!SCPI_ParamCharacters(context, &text, &text_len, mandatory)) {
+        if (mandatory || SCPI_ParamErrorOccurred(context)) {
+            return false;
+        }
+        text_len = 0;
+    }
+
+    if (text_len == 0) {
+        time = 0;
+        return true;
+    }
+
+    char buffer[24];
+    if (text_len >= sizeof(buffer)) {
+        SCPI_ErrorPush(context, SCPI_ERROR_ILLEGAL_PARAMETER_VALUE);
+        return false;
+    }
+    memcpy(buffer, text, text_len);
+    buffer[text_len] = 0;
+
+    int year, month, day, hour = 0, minute = 0, second = 0;
+    if (sscanf(buffer, "%d-%d-%d %d:%d:%d", &year, &month, &day, &hour, &minute, &second) < 3) {
+        SCPI_ErrorPush(context, SCPI_ERROR_ILLEGAL_PARAMETER_VALUE);
+        return false;
+    }
+
+    if (year < 2000 || year > 2099 ||
+        !datetime::isValidDate((uint8_t)(year - 2000), (uint8_t)month, (uint8_t)day) ||
+        !datetime::isValidTime((uint8_t)hour, (uint8_t)minute, (uint8_t)second))
+    {
+        SCPI_ErrorPush(context, SCPI_ERROR_DATA_OUT_OF_RANGE);
+        return false;
+    }
+
+    time = datetime::makeTime(year, month, day, hour, minute, second);
+    return true;
+}
+
+/// Events matching SYSTem:EVENt:FILTer, the most recent first.
+/// Optional parameters are the index of the first matching event and the max. number of events.
+/// Every event is returned as date and time, type, channel (0 if none), event ID and message.
+/// In FORMat REAL the response is definite length block of uint32 date and time
+/// (seconds since 1970) and int16 event ID pairs in the native (little endian) byte order.
+scpi_result_t scpi_syst_EventDataQ(scpi_t * context) {
+    int32_t start;
+    if (!SCPI_ParamInt(context, &start, FALSE)) {
+        if (SCPI_ParamErrorOccurred(context)) {
+            return SCPI_RES_ERR;
+        }
+        start = 0;
+    }
+
+    int32_t count;
+    if (!SCPI_ParamInt(context, &count, FALSE)) {
+        if (SCPI_ParamErrorOccurred(context)) {
+            return SCPI_RES_ERR;
+        }
+        count = event_queue::getNumEvents();
+    }
+
+    if (start < 0 || start > event_queue::MAX_EVENTS || count < 0 || count > event_queue::MAX_EVENTS) {
+        SCPI_ErrorPush(context, SCPI_ERROR_DATA_OUT_OF_RANGE);
+        return SCPI_RES_ERR;
+    }
+
+    scpi_psu_t *psu_context = (scpi_psu_t *)context->user_context;
+    const event_queue::EventFilter *filter = &psu_context->event_filter;
+
+    // skip to the first requested event
+    int index = 0;
+    event_queue::Event e;
+    for (int i = 0; i < start && event_queue::findEvent(filter, index, &e); ++i) {
+        ++index;
+    }
+
+    if (psu_context->format == SCPI_PSU_FORMAT_REAL) {
+        // records are streamed, block size is known from the number of matching events
+        int numRecords = 0;
+        for (int i = index; numRecords < count && event_queue::findEvent(filter, i, &e); ++i) {
+            ++numRecords;
+        }
+
+        SCPI_ResultArbitraryBlockHeader(context, numRecords * (sizeof(e.dateTime) + sizeof(e.eventId)));
+        if (numRecords == 0) {
+            SCPI_ResultArbitraryBlockData(context, 0, 0);
+        }
+        for (int i = 0; i < numRecords && event_queue::findEvent(filter, index, &e); ++i, ++index) {
+            SCPI_ResultArbitraryBlockData(context, &e.dateTime, sizeof(e.dateTime));
+            SCPI_ResultArbitraryBlockData(context, &e.eventId, sizeof(e.eventId));
+        }
+        return SCPI_RES_OK;
+    }
+
+    for (int i = 0; i < count && event_queue::findEvent(filter, index, &e); ++i, ++index) {
+        char buffer[24];
+        event_time_to_string(e.dateTime, buffer);
+        SCPI_ResultText(context, buffer);
+
+        const char *text;
+        SCPI_ChoiceToName(event_type_choice, event_queue::getEventType(&e), &text);
+        SCPI_ResultMnemonic(context, text);
+
+        SCPI_ResultInt(context, event_queue::getEventChannel(&e));
+        SCPI_ResultInt(context, e.eventId);
+
+        const char *message = event_queue::getEventMessage(&e);
+        SCPI_ResultText(context, message ? message : "");
+    }
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_syst_EventCountQ(scpi_t * context) {
+    scpi_psu_t *psu_context = (scpi_psu_t *)context->user_context;
+
+    SCPI_ResultInt(context, event_queue::getNumMatchingEvents(&psu_context->event_filter));
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_syst_EventFilterType(scpi_t * context) {
+    int32_t type;
+    if (!SCPI_ParamChoice(context, event_type_choice, &type, TRUE)) {
+        return SCPI_RES_ERR;
+    }
+
+    scpi_psu_t *psu_context = (scpi_psu_t *)context->user_context;
+    psu_context->event_filter.type = (uint8_t)type;
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_syst_EventFilterTypeQ(scpi_t * context) {
+    scpi_psu_t *psu_context = (scpi_psu_t *)context->user_context;
+
+    const char *text;
+    SCPI_ChoiceToName(event_type_choice, psu_context->event_filter.type, &text);
+    SCPI_ResultMnemonic(context, text);
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_syst_EventFilterChannel(scpi_t * context) {
+    int32_t channel;
+    if (!SCPI_ParamChoice(context, event_channel_choice, &channel, TRUE)) {
+        return SCPI_RES_ERR;
+    }
+
+    scpi_psu_t *psu_context = (scpi_psu_t *)context->user_context;
+    psu_context->event_filter.channel = (uint8_t)channel;
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_syst_EventFilterChannelQ(scpi_t * context) {
+    scpi_psu_t *psu_context = (scpi_psu_t *)context->user_context;
+
+    const char *text;
+    SCPI_ChoiceToName(event_channel_choice, psu_context->event_filter.channel, &text);
+    SCPI_ResultMnemonic(context, text);
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_syst_EventFilterTime(scpi_t * context) {
+    uint32_t from;
+    if (!get_event_time_param(context, from, TRUE)) {
+        return SCPI_RES_ERR;
+    }
+
+    uint32_t to;
+    if (!get_event_time_param(context, to, FALSE)) {
+        return SCPI_RES_ERR;
+    }
+
+    if (from && to && from > to) {
+        SCPI_ErrorPush(context, SCPI_ERROR_DATA_OUT_OF_RANGE);
+        return SCPI_RES_ERR;
+    }
+
+    scpi_psu_t *psu_context = (scpi_psu_t *)context->user_context;
+    psu_context->event_filter.from = from;
+    psu_context->event_filter.to = to;
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_syst_EventFilterTimeQ(scpi_t * context) {
+    scpi_psu_t *psu_context = (scpi_psu_t *)context->user_context;
+
+    char buffer[24] = { 0 };
+
+    if (psu_context->event_filter.from) {
+        event_time_to_string(psu_context->event_filter.from, buffer);
+    }
+    SCPI_ResultText(context, buffer);
+
+    buffer[0] = 0;
+    if (psu_context->event_filter.to) {
+        event_time_to_string(psu_context->event_filter.to, buffer);
+    }
+    SCPI_ResultText(context, buffer);
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_syst_EventFilterClear(scpi_t * context) {
+    scpi_psu_t *psu_context = (scpi_psu_t *)context->user_context;
+    memset(&psu_context->event_filter, 0, sizeof(event_queue::EventFilter));
+
+    return SCPI_RES_OK;
+}
+
 scpi_result_t scpi_syst_VersionQ(scpi_t * context) {
     return SCPI_SystemVersionQ(context);
 }
@@ -533,6 +818,104 @@ scpi_result_t scpi_syst_SerialQ(scpi_t * context) {
     return SCPI_RES_OK;
 }
 
+scpi_result_t scpi_syst_CommunicateTelemetryState(scpi_t * context) {
+    bool enable;
+    if (!SCPI_ParamBool(context, &enable, TRUE)) {
+        return SCPI_RES_ERR;
+    }
+
+#if !OPTION_ETHERNET
+    if (enable) {
+        SCPI_ErrorPush(context, SCPI_ERROR_OPTION_NOT_INSTALLED);
+        return SCPI_RES_ERR;
+    }
+#endif
+
+    if (enable != telemetry::isEnabled()) {
+        if (!telemetry::enable(enable)) {
+            SCPI_ErrorPush(context, SCPI_ERROR_EXECUTION_ERROR);
+            return SCPI_RES_ERR;
+        }
+    }
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_syst_CommunicateTelemetryStateQ(scpi_t * context) {
+    SCPI_ResultBool(context, telemetry::isEnabled());
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_syst_CommunicateTelemetryAddress(scpi_t * context) {
+    const char *address;
+    size_t addressLength;
+
+    if (!SCPI_ParamCharacters(context, &address, &addressLength, true)) {
+        return SCPI_RES_ERR;
+    }
+
+    uint32_t ipAddress;
+    if (!util::parseIpAddress(address, addressLength, ipAddress)) {
+        SCPI_ErrorPush(context, SCPI_ERROR_ILLEGAL_PARAMETER_VALUE);
+        return SCPI_RES_ERR;
+    }
+
+    if (!telemetry::setAddress(ipAddress)) {
+        SCPI_ErrorPush(context, SCPI_ERROR_EXECUTION_ERROR);
+        return SCPI_RES_ERR;
+    }
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_syst_CommunicateTelemetryAddressQ(scpi_t * context) {
+    char buffer[16];
+    util::ipAddressToString(telemetry::getAddress(), buffer);
+    SCPI_ResultText(context, buffer);
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_syst_CommunicateTelemetryPort(scpi_t * context) {
+    int32_t port;
+    if (!SCPI_ParamInt(context, &port, TRUE)) {
+        return SCPI_RES_ERR;
+    }
+
+    if (port < 1 || port > 65535) {
+        SCPI_ErrorPush(context, SCPI_ERROR_DATA_OUT_OF_RANGE);
+        return SCPI_RES_ERR;
+    }
+
+    if (!telemetry::setPort((uint16_t)port)) {
+        SCPI_ErrorPush(context, SCPI_ERROR_EXECUTION_ERROR);
+        return SCPI_RES_ERR;
+    }
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_syst_CommunicateTelemetryPortQ(scpi_t * context) {
+    SCPI_ResultInt(context, telemetry::getPort());
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_syst_CommunicateTelemetryInterval(scpi_t * context) {
+    float interval;
+    if (!get_duration_param(context, interval, TELEMETRY_MIN_INTERVAL / 1000.0f, TELEMETRY_MAX_INTERVAL / 1000.0f, TELEMETRY_DEFAULT_INTERVAL / 1000.0f)) {
+        return SCPI_RES_ERR;
+    }
+
+    if (!telemetry::setInterval((uint16_t)roundf(interval * 1000))) {
+        SCPI_ErrorPush(context, SCPI_ERROR_EXECUTION_ERROR);
+        return SCPI_RES_ERR;
+    }
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_syst_CommunicateTelemetryIntervalQ(scpi_t * context) {
+    return result_float(context, telemetry::getInterval() / 1000.0f);
+}
 
 }
 }
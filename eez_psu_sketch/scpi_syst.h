@@ -22,6 +22,16 @@
     SCPI_COMMAND("SYSTem:CAPability?", scpi_syst_CapabilityQ) \
     SCPI_COMMAND("SYSTem:ERRor[:NEXT]?", scpi_syst_ErrorNextQ) \
     SCPI_COMMAND("SYSTem:ERRor:COUNt?", scpi_syst_ErrorCountQ) \
+    SCPI_COMMAND("SYSTem:ERRor:STATistics?", scpi_syst_ErrorStatisticsQ) \
+    SCPI_COMMAND("SYSTem:EVENt[:DATA]?", scpi_syst_EventDataQ) \
+    SCPI_COMMAND("SYSTem:EVENt:COUNt?", scpi_syst_EventCountQ) \
+    SCPI_COMMAND("SYSTem:EVENt:FILTer:TYPE", scpi_syst_EventFilterType) \
+    SCPI_COMMAND("SYSTem:EVENt:FILTer:TYPE?", scpi_syst_EventFilterTypeQ) \
+    SCPI_COMMAND("SYSTem:EVENt:FILTer:CHANnel", scpi_syst_EventFilterChannel) \
+    SCPI_COMMAND("SYSTem:EVENt:FILTer:CHANnel?", scpi_syst_EventFilterChannelQ) \
+    SCPI_COMMAND("SYSTem:EVENt:FILTer:TIME", scpi_syst_EventFilterTime) \
+    SCPI_COMMAND("SYSTem:EVENt:FILTer:TIME?", scpi_syst_EventFilterTimeQ) \
+    SCPI_COMMAND("SYSTem:EVENt:FILTer:CLEar", scpi_syst_EventFilterClear) \
     SCPI_COMMAND("SYSTem:VERSion?", scpi_syst_VersionQ) \
     SCPI_COMMAND("SYSTem:POWer", scpi_syst_Power) \
     SCPI_COMMAND("SYSTem:POWer?", scpi_syst_PowerQ) \
@@ -55,4 +65,12 @@
     SCPI_COMMAND("SYSTem:CPU:MODel?", scpi_syst_CpuModelQ) \
     SCPI_COMMAND("SYSTem:CPU:OPTion?", scpi_syst_CpuOptionQ) \
     SCPI_COMMAND("SYSTem:SERial", scpi_syst_Serial) \
-    SCPI_COMMAND("SYSTem:SERial?", scpi_syst_SerialQ)
+    SCPI_COMMAND("SYSTem:SERial?", scpi_syst_SerialQ) \
+    SCPI_COMMAND("SYSTem:COMMunicate:TELemetry[:STATe]", scpi_syst_CommunicateTelemetryState) \
+    SCPI_COMMAND("SYSTem:COMMunicate:TELemetry[:STATe]?", scpi_syst_CommunicateTelemetryStateQ) \
+    SCPI_COMMAND("SYSTem:COMMunicate:TELemetry:ADDRess", scpi_syst_CommunicateTelemetryAddress) \
+    SCPI_COMMAND("SYSTem:COMMunicate:TELemetry:ADDRess?", scpi_syst_CommunicateTelemetryAddressQ) \
+    SCPI_COMMAND("SYSTem:COMMunicate:TELemetry:PORT", scpi_syst_CommunicateTelemetryPort) \
+    SCPI_COMMAND("SYSTem:COMMunicate:TELemetry:PORT?", scpi_syst_CommunicateTelemetryPortQ) \
+    SCPI_COMMAND("SYSTem:COMMunicate:TELemetry:INTerval", scpi_syst_CommunicateTelemetryInterval) \
+    SCPI_COMMAND("SYSTem:COMMunicate:TELemetry:INTerval?", scpi_syst_CommunicateTelemetryIntervalQ)
@@ -0,0 +1,114 @@
+/*
+ * EEZ PSU Firmware
+ * Copyright (C) 2015-present, Envox d.o.o.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+ 
+#include "psu.h"
+#include "scpi_psu.h"
+#include "scpi_trig.h"
+
+#include "trigger.h"
+
+namespace eez {
+namespace psu {
+namespace scpi {
+
+////////////////////////////////////////////////////////////////////////////////
+
+static scpi_choice_def_t trigger_source_choice[] = {
+    { "IMMediate", trigger::SOURCE_IMMEDIATE },
+    { "BUS", trigger::SOURCE_BUS },
+    { "PIN", trigger::SOURCE_PIN },
+    SCPI_CHOICE_LIST_END /* termination of option list */
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+scpi_result_t scpi_trig_Abort(scpi_t * context) {
+    trigger::abort();
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_trig_Initiate(scpi_t * context) {
+    int16_t err;
+    if (!trigger::initiate(err)) {
+        SCPI_ErrorPush(context, err);
+        return SCPI_RES_ERR;
+    }
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_trig_Immediate(scpi_t * context) {
+    int16_t err;
+    if (!trigger::generateTrigger(false, err)) {
+        SCPI_ErrorPush(context, err);
+        return SCPI_RES_ERR;
+    }
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_trig_Source(scpi_t * context) {
+    int32_t source;
+    if (!SCPI_ParamChoice(context, trigger_source_choice, &source, true)) {
+        return SCPI_RES_ERR;
+    }
+
+    if (trigger::isInitiated()) {
+        SCPI_ErrorPush(context, SCPI_ERROR_EXECUTION_ERROR);
+        return SCPI_RES_ERR;
+    }
+
+    trigger::setSource((trigger::Source)source);
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_trig_SourceQ(scpi_t * context) {
+    const char *text;
+    SCPI_ChoiceToName(trigger_source_choice, trigger::getSource(), &text);
+    SCPI_ResultMnemonic(context, text);
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_trig_Delay(scpi_t * context) {
+    float delay;
+    if (!get_duration_param(context, delay, 0, TRIGGER_MAX_DELAY, TRIGGER_DEF_DELAY)) {
+        return SCPI_RES_ERR;
+    }
+
+    if (trigger::isInitiated()) {
+        SCPI_ErrorPush(context, SCPI_ERROR_EXECUTION_ERROR);
+        return SCPI_RES_ERR;
+    }
+
+    trigger::setDelay(delay);
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_trig_DelayQ(scpi_t * context) {
+    SCPI_ResultFloat(context, trigger::getDelay());
+
+    return SCPI_RES_OK;
+}
+
+}
+}
+} // namespace eez::psu::scpi
@@ -0,0 +1,29 @@
+/*
+ * EEZ PSU Firmware
+ * Copyright (C) 2015-present, Envox d.o.o.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+ 
+#pragma once
+
+#define SCPI_TRIG_COMMANDS \
+    SCPI_COMMAND("ABORt", scpi_trig_Abort) \
+    SCPI_COMMAND("INITiate[:IMMediate]", scpi_trig_Initiate) \
+    SCPI_COMMAND("TRIGger[:SEQuence][:IMMediate]", scpi_trig_Immediate) \
+    SCPI_COMMAND("TRIGger[:SEQuence]:SOURce", scpi_trig_Source) \
+    SCPI_COMMAND("TRIGger[:SEQuence]:SOURce?", scpi_trig_SourceQ) \
+    SCPI_COMMAND("TRIGger[:SEQuence]:DELay", scpi_trig_Delay) \
+    SCPI_COMMAND("TRIGger[:SEQuence]:DELay?", scpi_trig_DelayQ) \
+
@@ -35,8 +35,12 @@ extern "C" {
 
 #define USE_USER_ERROR_LIST 1
 #define LIST_OF_USER_ERRORS \
+    X(SCPI_ERROR_TRIGGER_IGNORED,                           -211, "Trigger ignored")                              \
+    X(SCPI_ERROR_INIT_IGNORED,                              -213, "Init ignored")                                 \
+    X(SCPI_ERROR_SETTINGS_CONFLICT,                         -221, "Settings conflict")                            \
     X(SCPI_ERROR_DATA_OUT_OF_RANGE,                         -222, "Data out of range")                            \
     X(SCPI_ERROR_TOO_MUCH_DATA,                             -223, "Too much data")                                \
+    X(SCPI_ERROR_LISTS_NOT_SAME_LENGTH,                     -226, "Lists not same length")                        \
     X(SCPI_ERROR_HARDWARE_ERROR,                            -240, "Hardware error")                               \
     X(SCPI_ERROR_CH1_FAULT_DETECTED,                        -242, "CH1 fault detected")                           \
 	X(SCPI_ERROR_CH2_FAULT_DETECTED,                        -243, "CH2 fault detected")                           \
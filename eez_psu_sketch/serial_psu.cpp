@@ -36,7 +36,7 @@ scpi_result_t SCPI_Flush(scpi_t *context) {
 
 int SCPI_Error(scpi_t *context, int_fast16_t err) {
     if (err != 0) {
-        scpi::printError(err);
+        scpi::onError(err);
     }
     return 0;
 }
@@ -62,6 +62,10 @@ scpi_result_t SCPI_Reset(scpi_t *context) {
     return psu::reset() ? SCPI_RES_OK : SCPI_RES_ERR;
 }
 
+uint32_t SCPI_Time(scpi_t *context) {
+    return scpi::getErrorTime();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 scpi_reg_val_t scpi_psu_regs[SCPI_PSU_REG_COUNT];
@@ -73,10 +77,11 @@ scpi_interface_t scpi_interface = {
     SCPI_Control,
     SCPI_Flush,
     SCPI_Reset,
+    SCPI_Time,
 };
 
 char scpi_input_buffer[SCPI_PARSER_INPUT_BUFFER_LENGTH];
-int16_t error_queue_data[SCPI_PARSER_ERROR_QUEUE_SIZE + 1];
+scpi_error_info_t error_queue_data[SCPI_PARSER_ERROR_QUEUE_SIZE + 1];
 
 scpi_t scpi_context;
 
@@ -114,67 +114,120 @@ namespace eez {
 namespace psu {
 namespace sound {
 
-int power_up_tune[] = {
+enum Priority {
+    PRIORITY_LOW,    // key and error beeps
+    PRIORITY_MEDIUM, // SYST:BEEP
+    PRIORITY_HIGH    // power up and power down
+};
+
+static const int power_up_tune[] = {
     NOTE_C4, 8,
     NOTE_C4, 2,
     -1 // end!
 };
 
-int power_down_tune[] = {
+static const int power_down_tune[] = {
     NOTE_C4, 8,
     NOTE_A3, 8,
     NOTE_G3, 4,
     -1 // end!
 };
 
-int beep_tune[] = {
+static const int beep_tune[] = {
     NOTE_C6, 4,
     -1 // end!
 };
 
-int *g_play_tune = 0;
+static const int *g_lastTune;
+static Priority g_lastPriority;
+
+static int16_t g_lastError;
+static unsigned long g_lastErrorTime;
+
+static void play_tune(const int *tune, Priority priority) {
+    if (buzzer::isPlaying()) {
+        if (priority < g_lastPriority) {
+            // more important tune is playing
+            return;
+        }
+
+        if (priority > g_lastPriority) {
+            buzzer::clear();
+        } else if (tune == g_lastTune) {
+            // the same tune is already playing or waiting
+            return;
+        }
+    }
+
+    int num_tones = 0;
+    for (int index = 0; tune[index] != -1; index += 2) {
+        num_tones += 2;
+    }
+    if (num_tones > buzzer::getFreeQueueSize()) {
+        // no room after the tune of the same priority, newer tune replaces it
+        buzzer::clear();
+        if (num_tones > buzzer::getFreeQueueSize()) {
+            return;
+        }
+    }
 
-static void play_tune(int *tune) {
     // iterate over the notes of the melody:
     for (int index = 0; tune[index] != -1; index += 2) {
         // to calculate the note duration, take one second
         // divided by the note type.
         // e.g. quarter note = 1000 / 4, eighth note = 1000/8, etc.
-        int noteDuration = 1000 / tune[index + 1];
-        buzzer::tone(tune[index], noteDuration); // Arduino pin A1 is PF6 (Pin 37) assigned to BUZZER
+        uint16_t noteDuration = 1000 / tune[index + 1];
+        buzzer::enqueue(tune[index], noteDuration);
 
         // to distinguish the notes, set a minimum time between them.
         // the note's duration + 30% seems to work well:
-        int pauseBetweenNotes = (int)(noteDuration * 1.30);
-        delay(pauseBetweenNotes);
+        buzzer::enqueue(0, noteDuration * 30 / 100);
+
+#ifdef EEZ_PSU_SIMULATOR
+        simulator::logAudioEvent(tune[index], noteDuration, priority);
+#endif
     }
+
+    g_lastTune = tune;
+    g_lastPriority = priority;
 }
 
 void tick(unsigned long tick_usec) {
-    if (g_play_tune) {
-        play_tune(g_play_tune);
-        g_play_tune = 0;
-    }
+    buzzer::tick(tick_usec);
 }
 
 void playPowerUp() {
     if (persist_conf::isBeepEnabled()) {
-        g_play_tune = power_up_tune;
+        play_tune(power_up_tune, PRIORITY_HIGH);
     }
 }
 
 void playPowerDown() {
     if (persist_conf::isBeepEnabled()) {
-        g_play_tune = power_down_tune;
+        play_tune(power_down_tune, PRIORITY_HIGH);
     }
 }
 
 void playBeep(bool force) {
-    if (force || persist_conf::isBeepEnabled()) {
-        g_play_tune = beep_tune;
+    if (force) {
+        play_tune(beep_tune, PRIORITY_MEDIUM);
+    } else if (persist_conf::isBeepEnabled()) {
+        play_tune(beep_tune, PRIORITY_LOW);
+    }
+}
+
+void playErrorBeep(int16_t error) {
+    unsigned long now = millis();
+    bool burst = error == g_lastError && now - g_lastErrorTime < SOUND_ERROR_BURST_TIME;
+
+    g_lastError = error;
+    g_lastErrorTime = now;
+
+    if (!burst) {
+        playBeep();
     }
 }
 
 }
 }
-} // namespace eez::psu::sound
\ No newline at end of file
+} // namespace eez::psu::sound
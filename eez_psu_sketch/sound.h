@@ -22,6 +22,7 @@ namespace eez {
 namespace psu {
 
 /// Play simple sound tunes.
+/// Tunes are queued to the buzzer, more important tune interrupts less important one.
 namespace sound {
 
 void tick(unsigned long tick_usec);
@@ -35,6 +36,9 @@ void playPowerDown();
 /// Play beep sound.
 void playBeep(bool force = false);
 
+/// Play beep sound for the error, only once for the burst of the same error.
+void playErrorBeep(int16_t error);
+
 }
 }
 } // namespace eez::psu::sound
@@ -0,0 +1,149 @@
+/*
+ * EEZ PSU Firmware
+ * Copyright (C) 2015-present, Envox d.o.o.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+ 
+#include "psu.h"
+#include "spi_queue.h"
+#include "watchdog.h"
+
+namespace eez {
+namespace psu {
+namespace spi_queue {
+
+uint16_t g_numOverflows;
+
+static uint16_t g_lastReportedNumOverflows;
+
+/// Number of nested holds of the bus by the main loop (see holdBus).
+static volatile uint8_t g_busHolds;
+
+/// Transactions from the interrupt handler postponed because the bus was busy.
+static Transaction g_deferred[SPI_QUEUE_DEFERRED_SIZE];
+static volatile uint8_t g_deferredHead;
+static volatile uint8_t g_deferredTail;
+
+////////////////////////////////////////////////////////////////////////////////
+
+static void doTransfer(SPISettings &settings, uint8_t select_pin, uint8_t isolator_pin, uint8_t *buffer, uint16_t length) {
+    SPI.beginTransaction(settings);
+    if (isolator_pin != NO_PIN) {
+        digitalWrite(isolator_pin, ISOLATOR_ENABLE);
+    }
+    digitalWrite(select_pin, LOW);
+
+    SPI.transfer(buffer, length);
+
+    digitalWrite(select_pin, HIGH);
+    if (isolator_pin != NO_PIN) {
+        digitalWrite(isolator_pin, ISOLATOR_DISABLE);
+    }
+    SPI.endTransaction();
+}
+
+static void executeFromInterrupt(Transaction &transaction) {
+    doTransfer(*transaction.settings, transaction.select_pin, transaction.isolator_pin, transaction.data, transaction.length);
+
+    if (transaction.callback) {
+        transaction.callback(transaction);
+    }
+}
+
+void holdBus() {
+    ++g_busHolds;
+}
+
+void releaseBus() {
+    if (g_busHolds > 1) {
+        --g_busHolds;
+        return;
+    }
+
+    // Execute transactions deferred by the interrupt handler before the bus is released.
+    // The bus stays held meanwhile, so the interrupt handler keeps deferring, and callbacks
+    // are executed in the interrupt context as if there was no delay, e.g. the events
+    // are pushed to the event queue later from the main loop and not written to EEPROM here.
+    while (true) {
+        noInterrupts();
+        if (g_deferredHead == g_deferredTail) {
+            g_busHolds = 0;
+            interrupts();
+            return;
+        }
+        Transaction transaction = g_deferred[g_deferredHead];
+        g_deferredHead = (g_deferredHead + 1) % SPI_QUEUE_DEFERRED_SIZE;
+        interrupts();
+
+        bool insideInterruptHandler = g_insideInterruptHandler;
+        g_insideInterruptHandler = true;
+        executeFromInterrupt(transaction);
+        g_insideInterruptHandler = insideInterruptHandler;
+    }
+}
+
+void transfer(SPISettings &settings, uint8_t select_pin, uint8_t isolator_pin, uint8_t *buffer, uint16_t length) {
+    holdBus();
+    doTransfer(settings, select_pin, isolator_pin, buffer, length);
+    releaseBus();
+}
+
+void transferFromInterrupt(const Transaction &transaction) {
+    if (g_busHolds) {
+        uint8_t next = (g_deferredTail + 1) % SPI_QUEUE_DEFERRED_SIZE;
+        if (next == g_deferredHead) {
+            ++g_numOverflows;
+            return;
+        }
+        g_deferred[g_deferredTail] = transaction;
+        g_deferredTail = next;
+        return;
+    }
+
+    Transaction completed = transaction;
+    executeFromInterrupt(completed);
+}
+
+void beginTransaction(SPISettings &settings) {
+    holdBus();
+    SPI.beginTransaction(settings);
+}
+
+void endTransaction() {
+    SPI.endTransaction();
+    releaseBus();
+}
+
+void tick(unsigned long tick_usec) {
+    if (g_numOverflows != g_lastReportedNumOverflows) {
+        g_lastReportedNumOverflows = g_numOverflows;
+        DebugTraceF("SPI deferred transactions overflow (%u)", (unsigned)g_numOverflows);
+    }
+}
+
+void delay(uint32_t ms) {
+    unsigned long start = millis();
+    do {
+        unsigned long tick_usec = micros();
+        tick(tick_usec);
+#if EEZ_PSU_SELECTED_REVISION == EEZ_PSU_REVISION_R3B4
+        watchdog::tick(tick_usec);
+#endif
+    } while (millis() - start < ms);
+}
+
+}
+}
+} // namespace eez::psu::spi_queue
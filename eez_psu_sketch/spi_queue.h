@@ -0,0 +1,97 @@
+/*
+ * EEZ PSU Firmware
+ * Copyright (C) 2015-present, Envox d.o.o.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+ 
+#pragma once
+
+namespace eez {
+namespace psu {
+/// Central SPI bus access.
+///
+/// All drivers go through this module instead of using the SPI object directly.
+/// Synchronous transfers are done in bursts with the chip (and isolator) selected
+/// only once per transaction.
+///
+/// The conversion reads of the IO expander interrupt (used by OVP/OCP/OPP) and the
+/// DAC writes of list/trigger steps are executed from the interrupt handler itself
+/// (see transferFromInterrupt), together with their callbacks. If the main loop holds
+/// the bus at that moment, they are deferred and executed, still in the interrupt
+/// context (g_insideInterruptHandler is set), as soon as the bus is released.
+/// The main loop holds the bus only during the single transfer, i.e. while some
+/// chip is selected, or while the transfer buffer of the EEPROM chunk is in use.
+///
+/// This departs from the original plan in which the interrupt handler only queued
+/// the reads and callbacks were executed from the main loop: the protection would
+/// then wait for the main loop, which can be blocked for a long time (delay, EEPROM
+/// write, DHCP, *WAI, ...).
+namespace spi_queue {
+
+/// Use as isolator_pin when device is not behind the isolator.
+static const uint8_t NO_PIN = 0xFF;
+
+struct Transaction;
+
+/// Called right after the transaction from the interrupt handler is executed,
+/// always in the interrupt context. Received bytes are in transaction.data.
+typedef void (*Callback)(const Transaction &transaction);
+
+/// SPI transaction descriptor.
+struct Transaction {
+    SPISettings *settings;
+    uint8_t select_pin;
+    uint8_t isolator_pin;
+    uint8_t length;
+    uint8_t param;
+    uint8_t data[SPI_QUEUE_MAX_TRANSFER];
+    Callback callback;
+};
+
+/// Number of transactions from the interrupt handler dropped because too many were deferred.
+extern uint16_t g_numOverflows;
+
+/// Execute transaction immediately. Buffer is sent and overwritten with the received bytes.
+/// In the interrupt context it can be called only from the transaction callback.
+void transfer(SPISettings &settings, uint8_t select_pin, uint8_t isolator_pin, uint8_t *buffer, uint16_t length);
+
+/// Execute transaction from the interrupt handler. If the bus is in use at that
+/// moment, transaction is executed as soon as the bus is released. Callback, if set,
+/// is called right after the transaction is executed, i.e. either from the interrupt
+/// handler or from the code releasing the bus.
+void transferFromInterrupt(const Transaction &transaction);
+
+/// Used instead of SPI.beginTransaction/endTransaction by the code (like RTC or the
+/// Ethernet library transfer hooks) which accesses the bus directly, so the bus is not
+/// used from the interrupt at the same time. Keep it as short as a single transfer.
+void beginTransaction(SPISettings &settings);
+void endTransaction();
+
+/// Hold the bus between several transfers, e.g. while the shared transfer buffer is in use,
+/// so the transactions deferred by the interrupt handler are not executed in between.
+/// Calls can be nested, must not be called from the interrupt handler.
+void holdBus();
+/// Release the bus held by holdBus. Deferred transactions are executed when the last hold is released.
+void releaseBus();
+
+/// Report dropped transactions, if any.
+void tick(unsigned long tick_usec);
+
+/// Same as delay, but keeps pulsing the watchdog while waiting.
+void delay(uint32_t ms);
+
+}
+}
+} // namespace eez::psu::spi_queue
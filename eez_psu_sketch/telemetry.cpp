@@ -0,0 +1,197 @@
+/*
+ * EEZ PSU Firmware
+ * Copyright (C) 2015-present, Envox d.o.o.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+ 
+#include "psu.h"
+
+#if OPTION_ETHERNET
+#if defined(EEZ_PSU_SIMULATOR) || EEZ_PSU_SELECTED_REVISION == EEZ_PSU_REVISION_R1B9
+#include <UIPEthernet.h>
+#include <UIPUdp.h>
+#elif EEZ_PSU_SELECTED_REVISION == EEZ_PSU_REVISION_R3B4
+#include <Ethernet2.h>
+#include <EthernetUdp2.h>
+#endif
+#include "ethernet.h"
+#endif
+
+#include "persist_conf.h"
+#include "temperature.h"
+#include "telemetry.h"
+
+namespace eez {
+namespace psu {
+namespace telemetry {
+
+#if OPTION_ETHERNET
+
+static EthernetUDP g_udp;
+static bool g_udpStarted = false;
+
+static uint32_t g_sequence = 0;
+static unsigned long g_lastPacketTick;
+
+static uint8_t g_packet[sizeof(PacketHeader) + CH_MAX * sizeof(ChannelSample)];
+
+////////////////////////////////////////////////////////////////////////////////
+
+static uint16_t getChannelSampleFlags(Channel &channel) {
+    uint16_t flags = 0;
+
+    if (channel.isOutputEnabled()) flags |= CHANNEL_SAMPLE_OUTPUT_ENABLED;
+    if (channel.isCvMode()) flags |= CHANNEL_SAMPLE_CV_MODE;
+    if (channel.isCcMode()) flags |= CHANNEL_SAMPLE_CC_MODE;
+
+    if (channel.prot_conf.flags.u_state) flags |= CHANNEL_SAMPLE_OVP_ENABLED;
+    if (channel.prot_conf.flags.i_state) flags |= CHANNEL_SAMPLE_OCP_ENABLED;
+    if (channel.prot_conf.flags.p_state) flags |= CHANNEL_SAMPLE_OPP_ENABLED;
+
+    if (channel.ovp.flags.tripped) flags |= CHANNEL_SAMPLE_OVP_TRIPPED;
+    if (channel.ocp.flags.tripped) flags |= CHANNEL_SAMPLE_OCP_TRIPPED;
+    if (channel.opp.flags.tripped) flags |= CHANNEL_SAMPLE_OPP_TRIPPED;
+    if (temperature::isChannelTripped(&channel)) flags |= CHANNEL_SAMPLE_OTP_TRIPPED;
+
+    if (channel.isRemoteSensingEnabled()) flags |= CHANNEL_SAMPLE_REMOTE_SENSE;
+    if (channel.isRemoteProgrammingEnabled()) flags |= CHANNEL_SAMPLE_REMOTE_PROG;
+
+    return flags;
+}
+
+static size_t buildPacket() {
+    PacketHeader header;
+    header.magic = PACKET_MAGIC;
+    header.version = PACKET_VERSION;
+    header.numChannels = CH_NUM;
+    header.flags = psu::isPowerUp() ? PACKET_FLAG_POWER_UP : 0;
+    header.reserved = 0;
+    header.sequence = g_sequence++;
+    header.timestamp = millis();
+
+    memcpy(g_packet, &header, sizeof(PacketHeader));
+
+    uint8_t *p = g_packet + sizeof(PacketHeader);
+
+    for (int i = 0; i < CH_NUM; ++i) {
+        Channel &channel = Channel::get(i);
+
+        ChannelSample sample;
+
+        // mon values are updated from the ADC interrupt
+        noInterrupts();
+        sample.u_mon = channel.u.mon;
+        sample.i_mon = channel.i.mon;
+        interrupts();
+
+        sample.p_mon = sample.u_mon * sample.i_mon;
+        sample.u_set = channel.u.set;
+        sample.i_set = channel.i.set;
+        sample.flags = getChannelSampleFlags(channel);
+        sample.reserved = 0;
+
+        memcpy(p, &sample, sizeof(ChannelSample));
+        p += sizeof(ChannelSample);
+    }
+
+    return p - g_packet;
+}
+
+static void sendPacket() {
+    size_t size = buildPacket();
+
+    if (!g_udpStarted) {
+        g_udpStarted = g_udp.begin(TELEMETRY_LOCAL_PORT) ? true : false;
+        if (!g_udpStarted) {
+            DebugTrace("Telemetry UDP socket not available!");
+        }
+    }
+
+    if (g_udpStarted) {
+        if (g_udp.beginPacket(IPAddress(persist_conf::dev_conf.telemetry_ip_address), persist_conf::dev_conf.telemetry_port)) {
+            g_udp.write(g_packet, size);
+            g_udp.endPacket();
+        }
+    }
+}
+
+static void stop() {
+    if (g_udpStarted) {
+        g_udp.stop();
+        g_udpStarted = false;
+    }
+}
+
+#endif // OPTION_ETHERNET
+
+////////////////////////////////////////////////////////////////////////////////
+
+void tick(unsigned long tick_usec) {
+#if OPTION_ETHERNET
+    if (!isEnabled() || ethernet::test_result != psu::TEST_OK || getAddress() == 0) {
+        return;
+    }
+
+    if (tick_usec - g_lastPacketTick >= getInterval() * 1000UL) {
+        g_lastPacketTick = tick_usec;
+        sendPacket();
+    }
+#endif
+}
+
+bool enable(bool enable) {
+    persist_conf::dev_conf.flags.telemetryEnabled = enable ? 1 : 0;
+#if OPTION_ETHERNET
+    if (!enable) {
+        stop();
+    }
+#endif
+    return persist_conf::saveDevice();
+}
+
+bool isEnabled() {
+    return persist_conf::dev_conf.flags.telemetryEnabled ? true : false;
+}
+
+bool setAddress(uint32_t ipAddress) {
+    persist_conf::dev_conf.telemetry_ip_address = ipAddress;
+    return persist_conf::saveDevice();
+}
+
+uint32_t getAddress() {
+    return persist_conf::dev_conf.telemetry_ip_address;
+}
+
+bool setPort(uint16_t port) {
+    persist_conf::dev_conf.telemetry_port = port;
+    return persist_conf::saveDevice();
+}
+
+uint16_t getPort() {
+    return persist_conf::dev_conf.telemetry_port;
+}
+
+bool setInterval(uint16_t interval) {
+    persist_conf::dev_conf.telemetry_interval = interval;
+    return persist_conf::saveDevice();
+}
+
+uint16_t getInterval() {
+    return persist_conf::dev_conf.telemetry_interval;
+}
+
+}
+}
+} // namespace eez::psu::telemetry
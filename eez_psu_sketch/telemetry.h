@@ -0,0 +1,95 @@
+/*
+ * EEZ PSU Firmware
+ * Copyright (C) 2015-present, Envox d.o.o.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+ 
+#pragma once
+
+namespace eez {
+namespace psu {
+/// Binary UDP telemetry stream with the state of all channels.
+namespace telemetry {
+
+/// Value of PacketHeader::magic ("EZTL").
+static const uint32_t PACKET_MAGIC = 0x4C545A45L;
+
+/// Value of PacketHeader::version.
+static const uint8_t PACKET_VERSION = 1;
+
+/// PacketHeader::flags bits.
+enum PacketFlags {
+    PACKET_FLAG_POWER_UP = (1 << 0)
+};
+
+/// ChannelSample::flags bits.
+enum ChannelSampleFlags {
+    CHANNEL_SAMPLE_OUTPUT_ENABLED = (1 << 0),
+    CHANNEL_SAMPLE_CV_MODE = (1 << 1),
+    CHANNEL_SAMPLE_CC_MODE = (1 << 2),
+    CHANNEL_SAMPLE_OVP_ENABLED = (1 << 3),
+    CHANNEL_SAMPLE_OCP_ENABLED = (1 << 4),
+    CHANNEL_SAMPLE_OPP_ENABLED = (1 << 5),
+    CHANNEL_SAMPLE_OVP_TRIPPED = (1 << 6),
+    CHANNEL_SAMPLE_OCP_TRIPPED = (1 << 7),
+    CHANNEL_SAMPLE_OPP_TRIPPED = (1 << 8),
+    CHANNEL_SAMPLE_OTP_TRIPPED = (1 << 9),
+    CHANNEL_SAMPLE_REMOTE_SENSE = (1 << 10),
+    CHANNEL_SAMPLE_REMOTE_PROG = (1 << 11)
+};
+
+/// Datagram header. It is followed by numChannels ChannelSample records.
+/// All the fields are little endian.
+struct PacketHeader {
+    uint32_t magic;
+    uint8_t version;
+    uint8_t numChannels;
+    uint8_t flags;
+    uint8_t reserved;
+    /// Incremented for every datagram sent, collector can use it to detect lost datagrams.
+    uint32_t sequence;
+    /// Milliseconds since boot.
+    uint32_t timestamp;
+};
+
+/// Per channel part of the datagram.
+struct ChannelSample {
+    float u_mon;
+    float i_mon;
+    float p_mon;
+    float u_set;
+    float i_set;
+    uint16_t flags;
+    uint16_t reserved;
+};
+
+void tick(unsigned long tick_usec);
+
+bool enable(bool enable);
+bool isEnabled();
+
+bool setAddress(uint32_t ipAddress);
+uint32_t getAddress();
+
+bool setPort(uint16_t port);
+uint16_t getPort();
+
+/// Set interval, in milliseconds, between two datagrams.
+bool setInterval(uint16_t interval);
+uint16_t getInterval();
+
+}
+}
+} // namespace eez::psu::telemetry
@@ -28,7 +28,10 @@ class Channel;
 /// Temperature measurement and protection.
 namespace temperature {
 
+#pragma pack(push, 1)
+
 /// Configuration data for the temperature protection.
+/// It is stored in profile, so it is packed.
 struct ProtectionConfiguration {
     int8_t sensor;
     float delay;
@@ -36,6 +39,8 @@ struct ProtectionConfiguration {
     bool state;
 };
 
+#pragma pack(pop)
+
 bool init();
 bool test();
 void tick(unsigned long tick_usec);
@@ -184,13 +184,22 @@ void touch_read() {
 void touch_init() {
 }
 
+// raw state of the simulated touch controller, sampled by touch_read
+// so the filtered state isn't overwritten between two samples
+static bool sim_is_pressed = false;
+static int sim_x = -1;
+static int sim_y = -1;
+
 void touch_read() {
+    touch_is_pressed = sim_is_pressed;
+    touch_x = sim_x;
+    touch_y = sim_y;
 }
 
 void touch_write(bool is_pressed, int x, int y) {
-    touch_is_pressed = is_pressed;
-    touch_x = x;
-    touch_y = y;
+    sim_is_pressed = is_pressed;
+    sim_x = x;
+    sim_y = y;
 }
 
 #endif
@@ -200,6 +209,7 @@ void touch_write(bool is_pressed, int x, int y) {
 EventType event_type = TOUCH_NONE;
 int x = -1;
 int y = -1;
+bool is_new_sample = false;
 
 unsigned long last_tick_usec = 0;
 
@@ -211,8 +221,11 @@ void init() {
 }
 
 void tick(unsigned long tick_usec) {
+    is_new_sample = false;
+
     if (last_tick_usec == 0 || tick_usec - last_tick_usec > CONF_GUI_TOUCH_READ_FREQ_MS * 1000UL) {
     	touch_read();
+        is_new_sample = true;
 
         touch_is_pressed = filter(touch_is_pressed, touch_x, touch_y);
         if (touch_is_pressed) {
@@ -38,6 +38,8 @@ enum EventType {
 extern EventType event_type;
 extern int x;
 extern int y;
+/// True in the tick in which a new position was read from the touch controller.
+extern bool is_new_sample;
 
 extern bool directIsPressed();
 
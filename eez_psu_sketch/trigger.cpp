@@ -0,0 +1,359 @@
+/*
+ * EEZ PSU Firmware
+ * Copyright (C) 2015-present, Envox d.o.o.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+ 
+#include "psu.h"
+#include "trigger.h"
+#include "list.h"
+#include "ramp.h"
+#include "profile.h"
+#include "scpi_regs.h"
+
+namespace eez {
+namespace psu {
+namespace trigger {
+
+enum State {
+    STATE_IDLE,
+    /// waiting for the trigger
+    STATE_INITIATED,
+    /// trigger accepted, waiting for the delay to elapse
+    STATE_TRIGGERED,
+    /// staged codes are written to the DACs, channel state is not yet updated
+    STATE_EXECUTED
+};
+
+struct ChannelTrigger {
+    float u;
+    float i;
+    bool u_pending;
+    bool i_pending;
+
+    bool staged;
+    uint16_t u_dac;
+    uint16_t i_dac;
+    int16_t u_prot_adc;
+    int16_t i_prot_adc;
+};
+
+static ChannelTrigger g_channels[CH_MAX];
+
+static Source g_source;
+static float g_delay;
+static uint32_t g_delayMicros;
+
+static volatile State g_state;
+static volatile uint32_t g_triggerTime;
+static bool g_opcPending;
+
+#if !defined(EEZ_PSU_ARDUINO_DUE)
+static int g_lastPinState;
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+
+/// Write staged codes of all the channels, can be called from the interrupt handler.
+/// Writes are issued back to back with the interrupts disabled, so nothing can get
+/// between them, but they are still separate SPI transactions executed one after
+/// another (or all of them deferred until the main loop releases the bus, see
+/// spi_queue::transferFromInterrupt), i.e. channels change within a few DAC
+/// transfers of each other, not at the same instant.
+static void latch() {
+    noInterrupts();
+    for (int i = 0; i < CH_NUM; ++i) {
+        ChannelTrigger &trigger = g_channels[i];
+        if (trigger.staged) {
+            Channel &channel = Channel::get(i);
+            // protection must not trip on the new levels before the main loop updates the channel state
+            channel.raiseVoltageProtectionThreshold(trigger.u_prot_adc);
+            channel.raiseCurrentProtectionThreshold(trigger.i_prot_adc);
+            channel.dac.set_codes_from_interrupt(trigger.u_dac, trigger.i_dac);
+        }
+    }
+    g_state = STATE_EXECUTED;
+    interrupts();
+}
+
+/// Trigger is accepted, can be called from the interrupt handler.
+static void onTrigger() {
+    if (g_delayMicros == 0) {
+        latch();
+    } else {
+        g_triggerTime = micros();
+        g_state = STATE_TRIGGERED;
+    }
+}
+
+#if defined(EEZ_PSU_ARDUINO_DUE)
+static void onPinInterrupt() {
+    if (g_state == STATE_INITIATED && g_source == SOURCE_PIN) {
+        onTrigger();
+    }
+}
+#endif
+
+static void setWaitingForTrigger(bool on) {
+    for (int i = 0; i < CH_NUM; ++i) {
+        Channel::get(i).setOperBits(OPER_ISUM_TRIG, on);
+    }
+}
+
+/// Update channels state after the staged codes are written.
+static void complete() {
+    for (int i = 0; i < CH_NUM; ++i) {
+        ChannelTrigger &trigger = g_channels[i];
+        if (trigger.staged) {
+            Channel &channel = Channel::get(i);
+            channel.updateVoltageLevel(trigger.u_pending ? trigger.u : channel.u.set);
+            channel.updateCurrentLevel(trigger.i_pending ? trigger.i : channel.i.set);
+
+            trigger.u_pending = false;
+            trigger.i_pending = false;
+            trigger.staged = false;
+        }
+    }
+
+    profile::save();
+
+    g_state = STATE_IDLE;
+    setWaitingForTrigger(false);
+
+    if (g_opcPending) {
+        g_opcPending = false;
+        setEsrBits(ESR_OPC);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void init() {
+#if defined(EEZ_PSU_ARDUINO_DUE)
+    attachInterrupt(digitalPinToInterrupt(EXT_TRIG), onPinInterrupt, RISING);
+#else
+    g_lastPinState = digitalRead(EXT_TRIG);
+#endif
+}
+
+void tick(unsigned long tick_usec) {
+#if !defined(EEZ_PSU_ARDUINO_DUE)
+    // EXT_TRIG is not an interrupt pin on Arduino Mega
+    int pinState = digitalRead(EXT_TRIG);
+    if (pinState && !g_lastPinState && g_state == STATE_INITIATED && g_source == SOURCE_PIN) {
+        onTrigger();
+    }
+    g_lastPinState = pinState;
+#endif
+
+    if (g_state == STATE_TRIGGERED) {
+        if (micros() - g_triggerTime >= g_delayMicros) {
+            latch();
+        }
+    }
+
+    if (g_state == STATE_EXECUTED) {
+        complete();
+    }
+}
+
+void reset() {
+    // ABOR
+    abort();
+
+    // TRIG:SOUR IMM
+    g_source = SOURCE_IMMEDIATE;
+
+    // TRIG:DEL 0
+    setDelay(TRIGGER_DEF_DELAY);
+
+    // [SOUR[n]]:VOLT:TRIG
+    // [SOUR[n]]:CURR:TRIG -> same as immediate levels
+    for (int i = 0; i < CH_NUM; ++i) {
+        g_channels[i].u_pending = false;
+        g_channels[i].i_pending = false;
+    }
+}
+
+void setSource(Source source) {
+    g_source = source;
+}
+
+Source getSource() {
+    return g_source;
+}
+
+void setDelay(float delay) {
+    g_delay = delay;
+    g_delayMicros = (uint32_t)round(delay * 1000000L);
+}
+
+float getDelay() {
+    return g_delay;
+}
+
+void setVoltage(Channel &channel, float value) {
+    ChannelTrigger &trigger = g_channels[channel.index - 1];
+    trigger.u = value;
+    trigger.u_pending = true;
+}
+
+float getVoltage(Channel &channel) {
+    ChannelTrigger &trigger = g_channels[channel.index - 1];
+    return trigger.u_pending ? trigger.u : channel.u.set;
+}
+
+void setCurrent(Channel &channel, float value) {
+    ChannelTrigger &trigger = g_channels[channel.index - 1];
+    trigger.i = value;
+    trigger.i_pending = true;
+}
+
+float getCurrent(Channel &channel) {
+    ChannelTrigger &trigger = g_channels[channel.index - 1];
+    return trigger.i_pending ? trigger.i : channel.i.set;
+}
+
+bool initiate(int16_t &err) {
+    if (g_state != STATE_IDLE) {
+        err = SCPI_ERROR_INIT_IGNORED;
+        return false;
+    }
+
+    // check everything before anything is staged
+    for (int i = 0; i < CH_NUM; ++i) {
+        ChannelTrigger &trigger = g_channels[i];
+        if (!trigger.u_pending && !trigger.i_pending) {
+            continue;
+        }
+
+        Channel &channel = Channel::get(i);
+
+        if (list::isRunning(channel) || (trigger.u_pending && channel.isRemoteProgrammingEnabled())) {
+            err = SCPI_ERROR_EXECUTION_ERROR;
+            return false;
+        }
+
+        float u_level = getVoltage(channel);
+        float i_level = getCurrent(channel);
+
+        if (u_level > channel.getVoltageLimit()) {
+            err = SCPI_ERROR_VOLTAGE_LIMIT_EXCEEDED;
+            return false;
+        }
+
+        if (i_level > channel.getCurrentLimit()) {
+            err = SCPI_ERROR_CURRENT_LIMIT_EXCEEDED;
+            return false;
+        }
+
+        if (u_level * i_level > channel.getPowerLimit()) {
+            err = SCPI_ERROR_POWER_LIMIT_EXCEEDED;
+            return false;
+        }
+    }
+
+    for (int i = 0; i < CH_NUM; ++i) {
+        ChannelTrigger &trigger = g_channels[i];
+        trigger.staged = trigger.u_pending || trigger.i_pending;
+        if (trigger.staged) {
+            Channel &channel = Channel::get(i);
+            // running ramp would overwrite staged codes
+            ramp::stop(channel);
+            float u_level = getVoltage(channel);
+            float i_level = getCurrent(channel);
+            trigger.u_dac = channel.getVoltageDacCode(u_level);
+            trigger.i_dac = channel.getCurrentDacCode(i_level);
+            // OVP level is raised to U_SET by updateVoltageLevel
+            trigger.u_prot_adc = channel.getVoltageProtectionThreshold(channel.prot_conf.u_level < u_level ? u_level : channel.prot_conf.u_level);
+            trigger.i_prot_adc = channel.getCurrentProtectionThreshold(i_level);
+        }
+    }
+
+    setWaitingForTrigger(true);
+
+    noInterrupts();
+    g_state = STATE_INITIATED;
+    interrupts();
+
+    if (g_source == SOURCE_IMMEDIATE) {
+        onTrigger();
+        tick(micros());
+    }
+
+    return true;
+}
+
+bool generateTrigger(bool bus, int16_t &err) {
+    if (g_state != STATE_INITIATED || (bus && g_source != SOURCE_BUS)) {
+        err = SCPI_ERROR_TRIGGER_IGNORED;
+        return false;
+    }
+
+    onTrigger();
+    tick(micros());
+
+    return true;
+}
+
+void abort() {
+    noInterrupts();
+    bool executed = g_state == STATE_EXECUTED;
+    if (!executed) {
+        g_state = STATE_IDLE;
+    }
+    interrupts();
+
+    if (executed) {
+        // too late, DACs are already written
+        complete();
+        return;
+    }
+
+    for (int i = 0; i < CH_NUM; ++i) {
+        g_channels[i].staged = false;
+    }
+
+    setWaitingForTrigger(false);
+    g_opcPending = false;
+}
+
+bool isInitiated() {
+    return g_state != STATE_IDLE;
+}
+
+bool setOpcWhenComplete() {
+    if (g_state == STATE_IDLE) {
+        return false;
+    }
+
+    g_opcPending = true;
+    return true;
+}
+
+void waitForDelay() {
+    while (g_state == STATE_TRIGGERED) {
+        psu::tickWhileWaiting();
+        tick(micros());
+    }
+
+    if (g_state == STATE_EXECUTED) {
+        complete();
+    }
+}
+
+}
+}
+} // namespace eez::psu::trigger
@@ -0,0 +1,81 @@
+/*
+ * EEZ PSU Firmware
+ * Copyright (C) 2015-present, Envox d.o.o.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+ 
+#pragma once
+
+namespace eez {
+namespace psu {
+/// INITiate/TRIGger subsystem.
+///
+/// Triggered voltage and current levels ([SOUR[n]]:VOLT:TRIG, [SOUR[n]]:CURR:TRIG)
+/// are staged as DAC codes when the trigger system is initiated. When the trigger
+/// arrives, and the trigger delay elapses, staged codes of all the channels are written
+/// to the DACs in one critical section, so all the outputs change at the same time.
+namespace trigger {
+
+enum Source {
+    SOURCE_IMMEDIATE,
+    SOURCE_BUS,
+    SOURCE_PIN
+};
+
+void init();
+void tick(unsigned long tick_usec);
+
+/// Restore *RST defaults and abort the trigger system.
+void reset();
+
+void setSource(Source source);
+Source getSource();
+
+void setDelay(float delay);
+float getDelay();
+
+void setVoltage(Channel &channel, float value);
+/// Triggered voltage level, it is the same as the immediate level if not set.
+float getVoltage(Channel &channel);
+
+void setCurrent(Channel &channel, float value);
+/// Triggered current level, it is the same as the immediate level if not set.
+float getCurrent(Channel &channel);
+
+/// INIT, start waiting for the trigger.
+/// Returns false and SCPI error code in err if trigger system can't be initiated.
+bool initiate(int16_t &err);
+
+/// *TRG and TRIG[:IMM]. If bus is true, trigger is accepted only if source is BUS.
+/// Returns false and SCPI error code in err if trigger is ignored.
+bool generateTrigger(bool bus, int16_t &err);
+
+/// ABOR
+void abort();
+
+/// Is trigger system initiated, or triggered and waiting for the delay to elapse?
+bool isInitiated();
+
+/// Set OPC bit in ESR when trigger is executed (*OPC).
+/// Returns false if there is no pending trigger.
+bool setOpcWhenComplete();
+
+/// Wait for the execution of the trigger which is already accepted,
+/// i.e. for the trigger delay to elapse (*WAI and *OPC?).
+void waitForDelay();
+
+}
+}
+} // namespace eez::psu::trigger
@@ -164,6 +164,58 @@ bool isNaN(float x) {
 	return x != x;
 }
 
+bool parseIpAddress(const char *ipAddressStr, size_t ipAddressStrLength, uint32_t &ipAddress) {
+	const char *p = ipAddressStr;
+	const char *end = ipAddressStr + ipAddressStrLength;
+
+	uint8_t ipAddressArray[4];
+
+	for (int i = 0; i < 4; ++i) {
+		if (p == end) {
+			return false;
+		}
+
+		uint32_t part = 0;
+		for (int j = 0; j < 4; ++j) {
+			if (p == end || *p < '0' || *p > '9') {
+				if (j == 0) {
+					return false;
+				}
+				break;
+			}
+			if (j == 3) {
+				return false;
+			}
+			part = part * 10 + (*p++ - '0');
+		}
+
+		if (part > 255) {
+			return false;
+		}
+
+		ipAddressArray[i] = (uint8_t)part;
+
+		if (i < 3) {
+			if (p == end || *p++ != '.') {
+				return false;
+			}
+		}
+	}
+
+	if (p != end) {
+		return false;
+	}
+
+	memcpy(&ipAddress, ipAddressArray, 4);
+
+	return true;
+}
+
+void ipAddressToString(uint32_t ipAddress, char *ipAddressStr) {
+	uint8_t *bytes = (uint8_t *)&ipAddress;
+	sprintf_P(ipAddressStr, PSTR("%d.%d.%d.%d"), (int)bytes[0], (int)bytes[1], (int)bytes[2], (int)bytes[3]);
+}
+
 }
 }
 } // namespace eez::psu::util
\ No newline at end of file
@@ -55,6 +55,9 @@ float multiply(float a, float b, float prec);
 
 bool isNaN(float x);
 
+bool parseIpAddress(const char *ipAddressStr, size_t ipAddressStrLength, uint32_t &ipAddress);
+void ipAddressToString(uint32_t ipAddress, char *ipAddressStr);
+
 }
 }
 } // namespace eez::psu::util
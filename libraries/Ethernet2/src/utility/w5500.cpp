@@ -25,6 +25,31 @@ W5500Class w5500;
 SPISettings wiznet_SPI_settings(800000, MSBFIRST, SPI_MODE0);
 uint8_t SPI_CS;
 
+void (*W5500Class::beginTransactionHook)(void);
+void (*W5500Class::endTransactionHook)(void);
+
+void W5500Class::setTransactionHooks(void (*begin)(void), void (*end)(void))
+{
+  beginTransactionHook = begin;
+  endTransactionHook = end;
+}
+
+void W5500Class::beginTransaction()
+{
+  if (beginTransactionHook) {
+    beginTransactionHook();
+  }
+  SPI.beginTransaction(wiznet_SPI_settings);
+}
+
+void W5500Class::endTransaction()
+{
+  SPI.endTransaction();
+  if (endTransactionHook) {
+    endTransactionHook();
+  }
+}
+
 void W5500Class::init(uint8_t ss_pin)
 {
   SPI_CS = ss_pin;
@@ -102,21 +127,21 @@ void W5500Class::read_data(SOCKET s, volatile uint16_t src, volatile uint8_t *ds
 
 uint8_t W5500Class::write(uint16_t _addr, uint8_t _cb, uint8_t _data)
 {
-    SPI.beginTransaction(wiznet_SPI_settings);
+    beginTransaction();
     setSS();  
     SPI.transfer(_addr >> 8);
     SPI.transfer(_addr & 0xFF);
     SPI.transfer(_cb);
     SPI.transfer(_data);
     resetSS();
-    SPI.endTransaction();
+    endTransaction();
 
     return 1;
 }
 
 uint16_t W5500Class::write(uint16_t _addr, uint8_t _cb, const uint8_t *_buf, uint16_t _len)
 {
-    SPI.beginTransaction(wiznet_SPI_settings);
+    beginTransaction();
     setSS();
     SPI.transfer(_addr >> 8);
     SPI.transfer(_addr & 0xFF);
@@ -125,28 +150,28 @@ uint16_t W5500Class::write(uint16_t _addr, uint8_t _cb, const uint8_t *_buf, uin
         SPI.transfer(_buf[i]);
     }
     resetSS();
-    SPI.endTransaction();
+    endTransaction();
 
     return _len;
 }
 
 uint8_t W5500Class::read(uint16_t _addr, uint8_t _cb)
 {
-    SPI.beginTransaction(wiznet_SPI_settings);
+    beginTransaction();
     setSS();
     SPI.transfer(_addr >> 8);
     SPI.transfer(_addr & 0xFF);
     SPI.transfer(_cb);
     uint8_t _data = SPI.transfer(0);
     resetSS();
-    SPI.endTransaction();
+    endTransaction();
 
     return _data;
 }
 
 uint16_t W5500Class::read(uint16_t _addr, uint8_t _cb, uint8_t *_buf, uint16_t _len)
 { 
-    SPI.beginTransaction(wiznet_SPI_settings);
+    beginTransaction();
     setSS();
     SPI.transfer(_addr >> 8);
     SPI.transfer(_addr & 0xFF);
@@ -155,7 +180,7 @@ uint16_t W5500Class::read(uint16_t _addr, uint8_t _cb, uint8_t *_buf, uint16_t _
         _buf[i] = SPI.transfer(0);
     }
     resetSS();
-    SPI.endTransaction();
+    endTransaction();
 
     return _len;
 }
@@ -171,14 +196,14 @@ void W5500Class::execCmdSn(SOCKET s, SockCMD _cmd) {
 
 uint8_t W5500Class::readVersion(void)
 {
-    SPI.beginTransaction(wiznet_SPI_settings);
+    beginTransaction();
     setSS();
     SPI.transfer( 0x00 );
     SPI.transfer( 0x39 );
     SPI.transfer( 0x01);
     uint8_t _data = SPI.transfer(0);
     resetSS();
-    SPI.endTransaction();
+    endTransaction();
 
     return _data;
 }
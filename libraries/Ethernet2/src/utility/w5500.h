@@ -133,6 +133,12 @@ public:
   void init(uint8_t ss_pin = 10);
   uint8_t readVersion(void);
 
+  /**
+   * @brief	Set the functions called before and after every SPI transaction,
+   *        so the application can share the bus with its interrupt handlers.
+   */
+  static void setTransactionHooks(void (*begin)(void), void (*end)(void));
+
   /**
    * @brief	This function is being used for copy the data form Receive buffer of the chip to application buffer.
    * 
@@ -333,6 +339,12 @@ public:
 private:
   static const uint16_t RSIZE = 2048; // Max Rx buffer size
 
+private:
+  static void (*beginTransactionHook)(void);
+  static void (*endTransactionHook)(void);
+  static void beginTransaction();
+  static void endTransaction();
+
 private:
   // could do inline optimizations
   static inline void initSS()  { pinMode(SPI_CS, OUTPUT); }
@@ -47,9 +47,9 @@ extern "C" {
 #endif
 
 // set CS to 0 = active
-#define CSACTIVE digitalWrite(enc28j60_control_cs, LOW)
+#define CSACTIVE do { if (enc28j60_begin_transaction) enc28j60_begin_transaction(); digitalWrite(enc28j60_control_cs, LOW); } while (0)
 // set CS to 1 = passive
-#define CSPASSIVE digitalWrite(enc28j60_control_cs, HIGH)
+#define CSPASSIVE do { digitalWrite(enc28j60_control_cs, HIGH); if (enc28j60_end_transaction) enc28j60_end_transaction(); } while (0)
 //
 #if defined(ARDUINO_ARCH_AVR)
 #define waitspi() while(!(SPSR&(1<<SPIF)))
@@ -67,18 +67,25 @@ uint8_t Enc28J60Network::bank=0xff;
 struct memblock Enc28J60Network::receivePkt;
 
 static int enc28j60_control_cs = ENC28J60_CONTROL_CS;
+static void (*enc28j60_begin_transaction)(void);
+static void (*enc28j60_end_transaction)(void);
 
 void Enc28J60Network::setControlCS(int control_cs) {
   enc28j60_control_cs = control_cs;
 }
 
+void Enc28J60Network::setTransactionHooks(void (*begin)(void), void (*end)(void)) {
+  enc28j60_begin_transaction = begin;
+  enc28j60_end_transaction = end;
+}
+
 void Enc28J60Network::init(uint8_t* macaddr)
 {
   MemoryPool::init(); // 1 byte in between RX_STOP_INIT and pool to allow prepending of controlbyte
   // initialize I/O
   // ss as output:
   pinMode(enc28j60_control_cs, OUTPUT);
-  CSPASSIVE; // ss=0
+  digitalWrite(enc28j60_control_cs, HIGH); // ss=0
   //
 
 #if ENC28J60_USE_SPILIB
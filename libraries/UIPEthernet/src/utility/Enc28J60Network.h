@@ -84,6 +84,9 @@ public:
   bool linkStatus();
 
   static void setControlCS(int control_cs);
+  // begin is called before the chip is selected and end after it is deselected,
+  // so the application can share the SPI bus with its interrupt handlers
+  static void setTransactionHooks(void (*begin)(void), void (*end)(void));
 
   static void init(uint8_t* macaddr);
   static memhandle receivePacket();
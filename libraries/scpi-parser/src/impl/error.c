@@ -35,6 +35,7 @@
  */
 
 #include <stdint.h>
+#include <string.h>
 
 #include "scpi/parser.h"
 #include "scpi/ieee488.h"
@@ -50,8 +51,9 @@ static char error_message_buffer[SCPI_MAX_ERROR_MESSAGE_SIZE + 1];
  * Initialize error queue
  * @param context - scpi context
  */
-void SCPI_ErrorInit(scpi_t * context, int16_t * data, int16_t size) {
+void SCPI_ErrorInit(scpi_t * context, scpi_error_info_t * data, int16_t size) {
     fifo_init(&context->error_queue, data, size);
+    memset(&context->error_stat, 0, sizeof(context->error_stat));
 }
 
 /**
@@ -87,6 +89,7 @@ static void SCPI_ErrorEmit(scpi_t * context, int16_t err) {
  */
 void SCPI_ErrorClear(scpi_t * context) {
     fifo_clear(&context->error_queue);
+    memset(&context->error_stat, 0, sizeof(context->error_stat));
 
     SCPI_ErrorEmitEmpty(context);
 }
@@ -97,9 +100,27 @@ void SCPI_ErrorClear(scpi_t * context) {
  * @return error number
  */
 int16_t SCPI_ErrorPop(scpi_t * context) {
-    int16_t result = 0;
+    scpi_error_info_t info;
+
+    SCPI_ErrorPopInfo(context, &info);
+
+    return info.code;
+}
+
+/**
+ * Pop error from queue together with its repeat count
+ * @param context - scpi context
+ * @param info - error number (0 if queue is empty) and number of repeats
+ * @return FALSE if queue is empty
+ */
+scpi_bool_t SCPI_ErrorPopInfo(scpi_t * context, scpi_error_info_t * info) {
+    scpi_bool_t result;
 
-    fifo_remove(&context->error_queue, &result);
+    info->code = 0;
+    info->repeat = 0;
+    info->time = 0;
+
+    result = fifo_remove(&context->error_queue, info);
 
     SCPI_ErrorEmitEmpty(context);
 
@@ -119,12 +140,68 @@ int32_t SCPI_ErrorCount(scpi_t * context) {
     return result;
 }
 
-static scpi_bool_t SCPI_ErrorAddInternal(scpi_t * context, int16_t err) {
+/**
+ * Count error occurrence in error statistics
+ * @param context - scpi context
+ * @param err - error number
+ */
+static void SCPI_ErrorStatAdd(scpi_t * context, int16_t err) {
+    scpi_error_stat_t * stat = &context->error_stat;
+    int i;
+
+    stat->total++;
+
+    for (i = 0; i < SCPI_ERROR_STAT_CODES; i++) {
+        if (stat->counts[i] == 0) {
+            stat->codes[i] = err;
+        }
+        if (stat->codes[i] == err) {
+            if (stat->counts[i] < UINT16_MAX) {
+                stat->counts[i]++;
+            }
+            break;
+        }
+    }
+}
+
+/**
+ * Add error to the queue. Error same as the last one in the queue is not added,
+ * only repeat count of the last one is incremented.
+ * @param context - scpi context
+ * @param err - error number
+ * @return FALSE if error was not added as a new queue entry
+ */
+static scpi_bool_t SCPI_ErrorAddInternal(scpi_t * context, int16_t err, scpi_bool_t * queue_overflow) {
+    scpi_error_info_t * last = fifo_last(&context->error_queue);
+
+    *queue_overflow = FALSE;
+
+    if (last && last->code == err && last->repeat < UINT16_MAX) {
+        last->repeat++;
+        context->error_stat.collapsed++;
+        return FALSE;
+    }
+
     if (!fifo_add(&context->error_queue, err)) {
+        context->error_stat.lost++;
+
+        if (last->code == SCPI_ERROR_QUEUE_OVERFLOW) {
+            if (last->repeat < UINT16_MAX) {
+                last->repeat++;
+            }
+            return FALSE;
+        }
+
         fifo_remove_last(&context->error_queue, NULL);
         fifo_add(&context->error_queue, SCPI_ERROR_QUEUE_OVERFLOW);
-        return FALSE;
+        *queue_overflow = TRUE;
     }
+
+    /* only the time is stored, error is formatted when it is read */
+    if (context->interface && context->interface->time) {
+        fifo_last(&context->error_queue)->time = context->interface->time(context);
+    }
+
     return TRUE;
 }
 
@@ -156,8 +233,12 @@ static const struct error_reg errs[ERROR_DEFS_N] = {
 void SCPI_ErrorPush(scpi_t * context, int16_t err) {
 
     int i;
+    scpi_bool_t queue_overflow;
+    scpi_bool_t added;
 
-    scpi_bool_t queue_overflow = !SCPI_ErrorAddInternal(context, err);
+    SCPI_ErrorStatAdd(context, err);
+
+    added = SCPI_ErrorAddInternal(context, err, &queue_overflow);
 
     for (i = 0; i < ERROR_DEFS_N; i++) {
         if ((err <= errs[i].from) && (err >= errs[i].to)) {
@@ -165,9 +246,12 @@ void SCPI_ErrorPush(scpi_t * context, int16_t err) {
         }
     }
 
-    SCPI_ErrorEmit(context, err);
-    if (queue_overflow) {
-        SCPI_ErrorEmit(context, SCPI_ERROR_QUEUE_OVERFLOW);
+    /* repeated errors are already reported, don't emit them again */
+    if (added) {
+        SCPI_ErrorEmit(context, err);
+        if (queue_overflow) {
+            SCPI_ErrorEmit(context, SCPI_ERROR_QUEUE_OVERFLOW);
+        }
     }
 
     if (context) {
@@ -5,7 +5,7 @@
  * Initialize fifo
  * @param fifo
  */
-void fifo_init(scpi_fifo_t * fifo, int16_t * data, int16_t size) {
+void fifo_init(scpi_fifo_t * fifo, scpi_error_info_t * data, int16_t size) {
     fifo->wr = 0;
     fifo->rd = 0;
     fifo->count = 0;
@@ -53,7 +53,9 @@ scpi_bool_t fifo_add(scpi_fifo_t * fifo, int16_t value) {
         return FALSE;
     }
 
-    fifo->data[fifo->wr] = value;
+    fifo->data[fifo->wr].code = value;
+    fifo->data[fifo->wr].repeat = 1;
+    fifo->data[fifo->wr].time = 0;
     fifo->wr = (fifo->wr + 1) % (fifo->size);
     fifo->count += 1;
     return TRUE;
@@ -65,7 +67,7 @@ scpi_bool_t fifo_add(scpi_fifo_t * fifo, int16_t value) {
  * @param value
  * @return FALSE - fifo is empty
  */
-scpi_bool_t fifo_remove(scpi_fifo_t * fifo, int16_t * value) {
+scpi_bool_t fifo_remove(scpi_fifo_t * fifo, scpi_error_info_t * value) {
     /* FIFO empty? */
     if (fifo_is_empty(fifo)) {
         return FALSE;
@@ -87,7 +89,7 @@ scpi_bool_t fifo_remove(scpi_fifo_t * fifo, int16_t * value) {
  * @param value
  * @return FALSE - fifo is empty
  */
-scpi_bool_t fifo_remove_last(scpi_fifo_t * fifo, int16_t * value) {
+scpi_bool_t fifo_remove_last(scpi_fifo_t * fifo, scpi_error_info_t * value) {
     /* FIFO empty? */
     if (fifo_is_empty(fifo)) {
         return FALSE;
@@ -103,6 +105,20 @@ scpi_bool_t fifo_remove_last(scpi_fifo_t * fifo, int16_t * value) {
     return TRUE;
 }
 
+/**
+ * Get last added element
+ * @param fifo
+ * @return NULL - fifo is empty
+ */
+scpi_error_info_t * fifo_last(scpi_fifo_t * fifo) {
+    /* FIFO empty? */
+    if (fifo_is_empty(fifo)) {
+        return NULL;
+    }
+
+    return &fifo->data[(fifo->wr + fifo->size - 1) % (fifo->size)];
+}
+
 /**
  * Retrive number of elements in fifo
  * @param fifo
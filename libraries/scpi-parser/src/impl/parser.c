@@ -298,7 +298,7 @@ void SCPI_Init(scpi_t * context,
         const scpi_unit_def_t * units,
         const char * idn1, const char * idn2, const char * idn3, const char * idn4,
         char * input_buffer, size_t input_buffer_length, 
-        int16_t * error_queue_data, int16_t error_queue_size) {
+        scpi_error_info_t * error_queue_data, int16_t error_queue_size) {
     memset(context, 0, sizeof(*context));
     context->cmdlist = commands;
     context->interface = interface;
@@ -1186,7 +1186,13 @@ scpi_bool_t SCPI_ParamToChoice(scpi_t * context, scpi_parameter_t * parameter, c
     }
 
     if (parameter->type == SCPI_TOKEN_PROGRAM_MNEMONIC) {
+        /* short and long form of the choice begin with the same character */
+        int first = parameter->len > 0 ? toupper((unsigned char) parameter->ptr[0]) : 0;
+
         for (res = 0; options[res].name; ++res) {
+            if (toupper((unsigned char) options[res].name[0]) != first) {
+                continue;
+            }
             if (matchPattern(options[res].name, strlen(options[res].name), parameter->ptr, parameter->len, NULL)) {
                 *value = options[res].tag;
                 result = TRUE;
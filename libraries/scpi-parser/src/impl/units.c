@@ -34,6 +34,7 @@
  *
  */
 
+#include <ctype.h>
 #include <string.h>
 #include "scpi/parser.h"
 #include "scpi/units.h"
@@ -285,6 +286,65 @@ const scpi_choice_def_t scpi_special_numbers_def[] = {
     SCPI_CHOICE_LIST_END,
 };
 
+#if SCPI_UNITS_INDEX_SIZE > 0
+/* Units table sorted by case folded name, built on the first lookup */
+static const scpi_unit_def_t * unitsIndexTable = NULL;
+static uint8_t unitsIndex[SCPI_UNITS_INDEX_SIZE];
+static size_t unitsIndexCount;
+
+/**
+ * Case insensitive compare of unit name with unit text
+ * @param name unit name from units definition (null terminated)
+ * @param unit text representation of unit
+ * @param len length of text representation
+ * @return <0, 0 or >0 like strcmp
+ */
+static int compareUnitName(const char * name, const char * unit, size_t len) {
+    size_t i;
+    int c1, c2;
+
+    for (i = 0; i < len; i++) {
+        c1 = toupper((unsigned char) name[i]);
+        c2 = toupper((unsigned char) unit[i]);
+        if (c1 != c2) {
+            return c1 - c2;
+        }
+    }
+
+    return name[len] ? 1 : 0;
+}
+
+/**
+ * Build sorted index of units definitions
+ * @param units units patterns
+ * @return TRUE if all units fits into the index
+ */
+static scpi_bool_t buildUnitsIndex(const scpi_unit_def_t * units) {
+    size_t i, j;
+    uint8_t k;
+
+    unitsIndexTable = units;
+    unitsIndexCount = 0;
+
+    for (i = 0; units[i].name != NULL; i++) {
+        if (i == SCPI_UNITS_INDEX_SIZE || i > 255) {
+            unitsIndexCount = 0;
+            return FALSE;
+        }
+
+        /* insertion sort, done only once */
+        k = (uint8_t) i;
+        for (j = unitsIndexCount; j > 0 && compareUnitName(units[unitsIndex[j - 1]].name, units[k].name, strlen(units[k].name)) > 0; j--) {
+            unitsIndex[j] = unitsIndex[j - 1];
+        }
+        unitsIndex[j] = k;
+        unitsIndexCount++;
+    }
+
+    return TRUE;
+}
+#endif /* SCPI_UNITS_INDEX_SIZE > 0 */
+
 /**
  * Convert string describing unit to its representation
  * @param units units patterns
@@ -299,6 +359,26 @@ static const scpi_unit_def_t * translateUnit(const scpi_unit_def_t * units, cons
         return NULL;
     }
 
+#if SCPI_UNITS_INDEX_SIZE > 0
+    if ((units == unitsIndexTable && unitsIndexCount > 0) || buildUnitsIndex(units)) {
+        size_t lo = 0;
+        size_t hi = unitsIndexCount;
+        while (lo < hi) {
+            size_t mid = (lo + hi) / 2;
+            int cmp = compareUnitName(units[unitsIndex[mid]].name, unit, len);
+            if (cmp == 0) {
+                return &units[unitsIndex[mid]];
+            }
+            if (cmp < 0) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        return NULL;
+    }
+#endif /* SCPI_UNITS_INDEX_SIZE > 0 */
+
     for (i = 0; units[i].name != NULL; i++) {
         if (compareStr(unit, len, units[i].name, strlen(units[i].name))) {
             return &units[i];
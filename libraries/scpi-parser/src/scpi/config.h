@@ -176,6 +176,16 @@ extern "C" {
 #define USE_UNITS_ELECTRIC_CHARGE_CONDUCTANCE SYSTEM_TYPE
 #endif
 
+/* Number of distinct error codes counted in error statistics */
+#ifndef SCPI_ERROR_STAT_CODES
+#define SCPI_ERROR_STAT_CODES 8
+#endif
+
+/* Maximal number of units covered by the sorted units index, 0 disables it */
+#ifndef SCPI_UNITS_INDEX_SIZE
+#define SCPI_UNITS_INDEX_SIZE 128
+#endif
+
 /* Compiler specific */
 /* RealView/Keil ARM Compiler, e.g. Cortex-M CPUs */
 #if defined(__CC_ARM)
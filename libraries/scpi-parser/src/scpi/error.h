@@ -44,9 +44,10 @@
 extern "C" {
 #endif
 
-    void SCPI_ErrorInit(scpi_t * context, int16_t * data, int16_t size);
+    void SCPI_ErrorInit(scpi_t * context, scpi_error_info_t * data, int16_t size);
     void SCPI_ErrorClear(scpi_t * context);
     int16_t SCPI_ErrorPop(scpi_t * context);
+    scpi_bool_t SCPI_ErrorPopInfo(scpi_t * context, scpi_error_info_t * info);
     void SCPI_ErrorPush(scpi_t * context, int16_t err);
     int32_t SCPI_ErrorCount(scpi_t * context);
     const char * SCPI_ErrorTranslate(int16_t err);
@@ -49,7 +49,7 @@ extern "C" {
             const scpi_unit_def_t * units,
             const char * idn1, const char * idn2, const char * idn3, const char * idn4,
             char * input_buffer, size_t input_buffer_length, 
-            int16_t * error_queue_data, int16_t error_queue_size);
+            scpi_error_info_t * error_queue_data, int16_t error_queue_size);
 
     scpi_bool_t SCPI_Input(scpi_t * context, const char * data, int len);
     scpi_bool_t SCPI_Parse(scpi_t * context, char * data, int len);
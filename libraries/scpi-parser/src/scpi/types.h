@@ -140,6 +140,7 @@ extern "C" {
     typedef size_t(*scpi_write_t)(scpi_t * context, const char * data, size_t len);
     typedef scpi_result_t(*scpi_write_control_t)(scpi_t * context, scpi_ctrl_name_t ctrl, scpi_reg_val_t val);
     typedef int (*scpi_error_callback_t)(scpi_t * context, int_fast16_t error);
+    typedef uint32_t (*scpi_time_callback_t)(scpi_t * context);
 
     /* scpi lexer */
     enum _scpi_token_type_t {
@@ -205,15 +206,37 @@ extern "C" {
 
     typedef scpi_result_t(*scpi_command_callback_t)(scpi_t *);
 
+    struct _scpi_error_info_t {
+        int16_t code;
+        /* number of times the error was pushed in a row */
+        uint16_t repeat;
+        /* time of the first occurrence, from the interface time callback (0 if there is none) */
+        uint32_t time;
+    };
+    typedef struct _scpi_error_info_t scpi_error_info_t;
+
     struct _scpi_fifo_t {
         int16_t wr;
         int16_t rd;
         int16_t count;
         int16_t size;
-        int16_t * data;
+        scpi_error_info_t * data;
     };
     typedef struct _scpi_fifo_t scpi_fifo_t;
 
+    struct _scpi_error_stat_t {
+        /* all pushed errors */
+        uint32_t total;
+        /* errors merged with the same previous error in the queue */
+        uint32_t collapsed;
+        /* errors lost because the queue was full */
+        uint32_t lost;
+        /* occurrences of the first SCPI_ERROR_STAT_CODES distinct error codes */
+        int16_t codes[SCPI_ERROR_STAT_CODES];
+        uint16_t counts[SCPI_ERROR_STAT_CODES];
+    };
+    typedef struct _scpi_error_stat_t scpi_error_stat_t;
+
     /* scpi units */
     enum _scpi_unit_t {
         SCPI_UNIT_NONE,
@@ -347,6 +370,7 @@ extern "C" {
         scpi_write_control_t control;
         scpi_command_callback_t flush;
         scpi_command_callback_t reset;
+        scpi_time_callback_t time;
     };
 
     struct _scpi_t {
@@ -363,6 +387,7 @@ extern "C" {
         int_fast16_t input_count;
         scpi_bool_t cmd_error;
         scpi_fifo_t error_queue;
+        scpi_error_stat_t error_stat;
         scpi_reg_val_t registers[SCPI_REG_COUNT];
         const scpi_unit_def_t * units;
         void * user_context;
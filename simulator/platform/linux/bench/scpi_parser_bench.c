@@ -0,0 +1,115 @@
+/*
+ * EEZ PSU Firmware
+ * Copyright (C) 2015-present, Envox d.o.o.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * SCPI parser benchmark, run by "make bench".
+ *
+ * Parses numeric parameters with unit suffixes and special values (MIN, MAX, DEF),
+ * the work done by translateUnit() and SCPI_ParamToChoice() for most PSU commands.
+ * Printed sum of the parsed values must be the same for every parser version.
+ * SCPI_PARSER_DIR selects the parser sources, so the other version can be compared:
+ *
+ *     make bench SCPI_PARSER_DIR=<other checkout>/libraries/scpi-parser/src
+ *     make bench BENCH_DEFINES=-DSCPI_UNITS_INDEX_SIZE=0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "scpi/scpi.h"
+
+#define NUM_COMMANDS 2000000
+
+static double g_sum;
+static int g_numErrors;
+
+static scpi_result_t volt(scpi_t *context) {
+    scpi_number_t value;
+    if (!SCPI_ParamNumber(context, scpi_special_numbers_def, &value, TRUE)) {
+        return SCPI_RES_ERR;
+    }
+    g_sum += value.value;
+    return SCPI_RES_OK;
+}
+
+static const scpi_command_t scpi_commands[] = {
+    { "VOLTage", volt },
+    SCPI_CMD_LIST_END
+};
+
+static size_t write(scpi_t *context, const char *data, size_t len) {
+    return len;
+}
+
+static int error(scpi_t *context, int_fast16_t err) {
+    if (err != 0) {
+        ++g_numErrors;
+    }
+    return 0;
+}
+
+static scpi_interface_t scpi_interface = {
+    error,
+    write,
+    NULL,
+    NULL,
+    NULL,
+};
+
+static const char *g_lines[] = {
+    "VOLT 5 mV\n",
+    "VOLT 1.2 V\n",
+    "VOLT 3 ms\n",
+    "VOLT 10 kHz\n",
+    "VOLT 2 UA\n",
+    "VOLT MAX\n",
+    "VOLT DEF\n",
+    "VOLT 7 ANN\n"
+};
+
+static char scpi_input_buffer[256];
+// error queue element differs between parser versions, this storage fits any of them
+#define SCPI_ERROR_QUEUE_SIZE 16
+static uint64_t scpi_error_queue_data[SCPI_ERROR_QUEUE_SIZE];
+
+int main(int argc, char **argv) {
+    scpi_t context;
+    SCPI_Init(&context, scpi_commands, &scpi_interface, scpi_units_def,
+        "EEZ", "PSU", "0", "bench",
+        scpi_input_buffer, sizeof(scpi_input_buffer),
+        (void *)scpi_error_queue_data, SCPI_ERROR_QUEUE_SIZE);
+
+    int numLines = sizeof(g_lines) / sizeof(g_lines[0]);
+
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    for (int i = 0; i < NUM_COMMANDS; ++i) {
+        const char *line = g_lines[i % numLines];
+        SCPI_Input(&context, line, strlen(line));
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    double ns = ((end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec)) / NUM_COMMANDS;
+    printf("%d commands, %.1f ns/command, sum %g, %d errors\n", NUM_COMMANDS, ns, g_sum, g_numErrors);
+
+    return 0;
+}
@@ -32,6 +32,7 @@ namespace ethernet_platform {
 
 static int listen_socket = -1;
 static int client_socket = -1;
+static int udp_socket = -1;
 
 bool enable_non_blocking(int fd) {
     int flags = fcntl(fd, F_GETFL, 0);
@@ -172,6 +173,43 @@ void stop() {
     client_socket = -1;
 }
 
+
+bool udp_begin(int port) {
+    // port is not bound, datagrams are sent from any free local port
+    // so that collector can run on the same host
+    if (udp_socket == -1) {
+        udp_socket = socket(AF_INET, SOCK_DGRAM, 0);
+        if (udp_socket < 0) {
+            DebugTraceF("EHTERNET: UDP socket failed with error %d", errno);
+            udp_socket = -1;
+            return false;
+        }
+    }
+    return true;
+}
+
+int udp_send(uint32_t ip_address, int port, const char *buffer, int buffer_size) {
+    if (udp_socket == -1) return 0;
+
+    sockaddr_in remote_addr;
+    bzero((char *)&remote_addr, sizeof(remote_addr));
+    remote_addr.sin_family = AF_INET;
+    remote_addr.sin_addr.s_addr = ip_address;
+    remote_addr.sin_port = htons(port);
+
+    int n = ::sendto(udp_socket, buffer, buffer_size, 0, (sockaddr *)&remote_addr, sizeof(remote_addr));
+    if (n < 0) {
+        return 0;
+    }
+    return n;
+}
+
+void udp_stop() {
+    if (udp_socket != -1) {
+        close(udp_socket);
+        udp_socket = -1;
+    }
+}
 }
 }
 } // namespace eez::psu::ethernet_platform
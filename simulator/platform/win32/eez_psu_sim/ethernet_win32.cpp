@@ -39,6 +39,7 @@ namespace ethernet_platform {
 
 static SOCKET listen_socket = INVALID_SOCKET;
 static SOCKET client_socket = INVALID_SOCKET;
+static SOCKET udp_socket = INVALID_SOCKET;
 
 bool bind(int port) {
     WSADATA wsaData;
@@ -199,6 +200,49 @@ void stop() {
     }
 }
 
+
+bool udp_begin(int port) {
+    // port is not bound, datagrams are sent from any free local port
+    // so that collector can run on the same host
+    if (udp_socket == INVALID_SOCKET) {
+        WSADATA wsaData;
+        int iResult = WSAStartup(MAKEWORD(2, 2), &wsaData);
+        if (iResult != 0) {
+            DebugTraceF("EHTERNET: WSAStartup failed with error %d\n", iResult);
+            return false;
+        }
+
+        udp_socket = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+        if (udp_socket == INVALID_SOCKET) {
+            DebugTraceF("EHTERNET: UDP socket failed with error %ld\n", WSAGetLastError());
+            return false;
+        }
+    }
+    return true;
+}
+
+int udp_send(uint32_t ip_address, int port, const char *buffer, int buffer_size) {
+    if (udp_socket == INVALID_SOCKET) return 0;
+
+    sockaddr_in remote_addr;
+    ZeroMemory(&remote_addr, sizeof(remote_addr));
+    remote_addr.sin_family = AF_INET;
+    remote_addr.sin_addr.s_addr = ip_address;
+    remote_addr.sin_port = htons((u_short)port);
+
+    int iResult = ::sendto(udp_socket, buffer, buffer_size, 0, (sockaddr *)&remote_addr, sizeof(remote_addr));
+    if (iResult == SOCKET_ERROR) {
+        return 0;
+    }
+    return iResult;
+}
+
+void udp_stop() {
+    if (udp_socket != INVALID_SOCKET) {
+        closesocket(udp_socket);
+        udp_socket = INVALID_SOCKET;
+    }
+}
 }
 }
 } // namespace eez::psu::ethernet_platform
@@ -20,6 +20,7 @@
 
 #include <stdint.h>
 #include <queue>
+#include <string>
 
 typedef uint8_t byte;
 
@@ -66,6 +67,11 @@ void detachInterrupt(uint8_t);
 
 void tone(uint8_t _pin, unsigned int frequency, unsigned long duration = 0);
 
+/// Chip interrupts (see chips::tick) are not delivered while disabled,
+/// the pending ones are delivered as soon as the interrupts are enabled again.
+void interrupts();
+void noInterrupts();
+
 uint32_t millis();
 uint32_t micros();
 void delay(uint32_t millis);
@@ -82,6 +88,9 @@ private:
     } _address;
 
 public:
+    IPAddress() { _address.dword = 0; }
+    IPAddress(uint32_t address) { _address.dword = address; }
+
     operator uint32_t() const { return _address.dword; };
 };
 
@@ -100,8 +109,12 @@ public:
 
     void put(int ch);
 
+    /// Redirect output from stdout to the string, 0 to stop.
+    void capture(std::string *output);
+
 private:
     std::queue<int> input;
+    std::string *output;
 };
 
 extern SimulatorSerial Serial;
@@ -18,6 +18,8 @@
 
 #pragma once
 
+#include <stddef.h>
+
 #include "Arduino.h"
 
 #define SPI_CLOCK_DIV4 0x00
@@ -52,6 +54,7 @@ public:
     void usingInterrupt(uint8_t interruptNumber);
     void beginTransaction(SPISettings settings);
     uint8_t transfer(uint8_t data);
+    void transfer(void *buf, size_t count);
     void endTransaction(void);
     void attachInterrupt();
 };
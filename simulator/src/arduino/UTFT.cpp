@@ -30,6 +30,7 @@ UTFT::UTFT(byte , int , int , int , int , int) {
     disp_x_size = 239;
     disp_y_size = 319;
     buffer = new word[getDisplayXSize() * getDisplayYSize()];
+    pixels_written = 0;
 }
 
 UTFT::~UTFT() {
@@ -88,6 +89,7 @@ void UTFT::setPixel(word color) {
     if (orient == PORTRAIT) {
         if (x >= 0 && x < getDisplayXSize() && y >= 0 && y < getDisplayYSize()) {
             *(buffer + y * getDisplayXSize() + x) = color;
+            ++pixels_written;
         }
         if (++x > x2) {
             x = x1;
@@ -98,6 +100,7 @@ void UTFT::setPixel(word color) {
     } else {
         if (x >= 0 && x < getDisplayXSize() && y >= 0 && y < getDisplayYSize()) {
             *(buffer + y * getDisplayXSize() + x) = color;
+            ++pixels_written;
         }
 
 		if (--x < x1) {
@@ -136,6 +139,7 @@ void UTFT::clrScr() {
     while (p < end) {
         *p++ = 0;
     }
+    pixels_written += getDisplayXSize() * getDisplayYSize();
 }
 
 void UTFT::drawRect(int x1, int y1, int x2, int y2) {
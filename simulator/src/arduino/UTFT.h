@@ -93,6 +93,8 @@ public:
 	regsize	B_CS;
     word    x, y, x1, y1, x2, y2;
     word    *buffer;
+    /// Number of pixels written to the buffer since start, used for the frame statistics.
+    uint32_t pixels_written;
 
 	void setPixel(word color);
 	void setXY(word x1_, word y1_, word x2_, word y2_);
@@ -31,6 +31,7 @@ namespace arduino {
 
 int pins[NUM_PINS];
 InterruptCallback interrupt_callbacks[NUM_INTERRUPTS];
+static int interrupt_modes[NUM_INTERRUPTS];
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -70,12 +71,31 @@ void analogWrite(uint8_t pin, int state) {
 
 void attachInterrupt(uint8_t interrupt_no, InterruptCallback interrupt_callback, int mode) {
     interrupt_callbacks[interrupt_no] = interrupt_callback;
+    interrupt_modes[interrupt_no] = mode;
 }
 
 void detachInterrupt(uint8_t interrupt_no) {
     interrupt_callbacks[interrupt_no] = 0;
 }
 
+void setInputPin(uint8_t pin, int state) {
+    int last_state = pins[pin];
+    pins[pin] = state;
+
+    if (state == last_state) {
+        return;
+    }
+
+    uint8_t interrupt_no = digitalPinToInterrupt(pin);
+    InterruptCallback interrupt_callback = interrupt_callbacks[interrupt_no];
+    if (interrupt_callback) {
+        int mode = interrupt_modes[interrupt_no];
+        if (mode == CHANGE || (mode == RISING && state) || (mode == FALLING && !state)) {
+            interrupt_callback();
+        }
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 SimulatorSerial Serial;
@@ -84,6 +104,10 @@ void SimulatorSerial::begin(unsigned long baud) {
 }
 
 int SimulatorSerial::write(const char *buffer, int size) {
+    if (output) {
+        output->append(buffer, size);
+        return size;
+    }
     return fwrite(buffer, 1, size, stdout);
 }
 
@@ -92,19 +116,23 @@ int SimulatorSerial::print(const char *data) {
 }
 
 int SimulatorSerial::println(int value) {
-    return printf("%d\n", value);
+    char buffer[16];
+    sprintf(buffer, "%d\n", value);
+    return print(buffer);
 }
 
 int SimulatorSerial::println(const char *data) {
-    return printf("%s\n", data);
+    return print(data) + print("\n");
 }
 
 int SimulatorSerial::println(IPAddress ipAddress) {
-    return printf("%d.%d.%d.%d\n",
+    char buffer[20];
+    sprintf(buffer, "%d.%d.%d.%d\n",
         ipAddress._address.bytes[0],
         ipAddress._address.bytes[1],
         ipAddress._address.bytes[2],
         ipAddress._address.bytes[3]);
+    return print(buffer);
 }
 
 int SimulatorSerial::available(void) {
@@ -121,6 +149,10 @@ void SimulatorSerial::put(int ch) {
     input.push(ch);
 }
 
+void SimulatorSerial::capture(std::string *output_) {
+    output = output_;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 SPISettings::SPISettings(uint32_t clock, uint8_t bitOrder, uint8_t dataMode) {
@@ -143,6 +175,13 @@ uint8_t SimulatorSPI::transfer(uint8_t data) {
     return chips::transfer(data);
 }
 
+void SimulatorSPI::transfer(void *buf, size_t count) {
+    uint8_t *p = (uint8_t *)buf;
+    for (size_t i = 0; i < count; ++i) {
+        p[i] = chips::transfer(p[i]);
+    }
+}
+
 void SimulatorSPI::endTransaction(void) {
 }
 
@@ -166,7 +205,18 @@ void tone(uint8_t _pin, unsigned int frequency, unsigned long duration) {
 #include <time.h>
 #endif
 
+void interrupts() {
+    chips::enableInterrupts(true);
+}
+
+void noInterrupts() {
+    chips::enableInterrupts(false);
+}
+
 uint32_t millis() {
+    // deliver chip interrupts due by now, see chips::tick
+    chips::tick();
+
 #ifdef _WIN32
     return GetTickCount();
 #else
@@ -178,6 +228,8 @@ uint32_t millis() {
 }
 
 uint32_t micros() {
+    chips::tick();
+
 #ifdef _WIN32
     return GetTickCount() * 1000;
 #else
@@ -198,7 +250,7 @@ void delayMicroseconds(uint32_t microseconds) {
 #else
     timespec ts;
     ts.tv_sec = microseconds / 1000000;
-    ts.tv_nsec = (microseconds % 1000000) * 1000000;
+    ts.tv_nsec = (microseconds % 1000000) * 1000;
     nanosleep(&ts, 0);
 #endif
 }
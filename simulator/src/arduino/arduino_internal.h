@@ -29,6 +29,10 @@ namespace arduino {
 extern int pins[NUM_PINS];
 extern InterruptCallback interrupt_callbacks[NUM_INTERRUPTS];
 
+/// Change the state of the input pin from outside, like the signal on EXT_TRIG
+/// would do, and call the attached interrupt callback if the edge matches.
+void setInputPin(uint8_t pin, int state);
+
 }
 }
 }
@@ -18,6 +18,7 @@
 
 #include "psu.h"
 #include "chips.h"
+#include "load.h"
 #include "arduino_internal.h"
 
 namespace eez {
@@ -161,9 +162,38 @@ uint8_t transfer(uint8_t data) {
     return selected_chip ? selected_chip->transfer(data) : 0;
 }
 
+static bool g_insideTick;
+static bool g_interruptsDisabled;
+static bool g_interruptPending;
+
 void tick() {
-    adc_chip1.tick();
-    adc_chip2.tick();
+    // interrupt handler is not interrupted, also micros() called from here
+    // and from the handler calls this function again
+    if (g_insideTick) {
+        return;
+    }
+
+    // as on the real hardware, interrupt is not delivered inside the critical section
+    if (g_interruptsDisabled) {
+        g_interruptPending = true;
+        return;
+    }
+    g_interruptPending = false;
+
+    g_insideTick = true;
+
+    uint32_t tick_usec = micros();
+    adc_chip1.tick(tick_usec);
+    adc_chip2.tick(tick_usec);
+
+    g_insideTick = false;
+}
+
+void enableInterrupts(bool enable) {
+    g_interruptsDisabled = !enable;
+    if (enable && g_interruptPending) {
+        tick();
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -575,13 +605,30 @@ uint8_t IOExpanderChip::transfer(uint8_t data) {
 
 ////////////////////////////////////////////////////////////////////////////////
 
+static const uint16_t ADC_DATA_RATE[] = { 20, 45, 90, 175, 330, 600, 1000, 1000 };
+
 AnalogDigitalConverterChip::AnalogDigitalConverterChip(IOExpanderChip &ioexp_chip_, int convend_pin_)
     : ioexp_chip(ioexp_chip_)
     , convend_pin(convend_pin_)
     , state(IDLE)
-    , tick_counter(0)
-    , start(false)
+    , converting(false)
+    , data(0)
 {
+    memset(register_values, 0, sizeof(register_values));
+    memset(&faults, 0, sizeof(Faults));
+    memset(&stats, 0, sizeof(Statistics));
+}
+
+AnalogDigitalConverterChip::Faults &AnalogDigitalConverterChip::getFaults(int pin) {
+    return pin == ADC1_SELECT ? adc_chip1.faults : adc_chip2.faults;
+}
+
+AnalogDigitalConverterChip::Statistics &AnalogDigitalConverterChip::getStatistics(int pin) {
+    return pin == ADC1_SELECT ? adc_chip1.stats : adc_chip2.stats;
+}
+
+void AnalogDigitalConverterChip::resetStatistics(int pin) {
+    memset(&getStatistics(pin), 0, sizeof(Statistics));
 }
 
 void AnalogDigitalConverterChip::select() {
@@ -593,6 +640,8 @@ uint8_t AnalogDigitalConverterChip::transfer(uint8_t data) {
 
     if (state == IDLE) {
         if (data == AnalogDigitalConverter::ADC_RESET) {
+            memset(register_values, 0, sizeof(register_values));
+            converting = false;
         }
         else if (data == AnalogDigitalConverter::ADC_RD3S1) {
             register_index = 1;
@@ -600,17 +649,28 @@ uint8_t AnalogDigitalConverterChip::transfer(uint8_t data) {
         }
         else if (data == AnalogDigitalConverter::ADC_WR3S1) {
             register_index = 1;
+            register_end = 4;
             state = WRITE_REG;
         }
         else if (data == AnalogDigitalConverter::ADC_WR1S0) {
             state = WR1S0;
         }
+        else if (data == AnalogDigitalConverter::ADC_WR2S0) {
+            register_index = 0;
+            register_end = 2;
+            state = WRITE_REG;
+        }
         else if (data == AnalogDigitalConverter::ADC_RDATA) {
+            read_data = this->data;
+            if (faults.glitches > 0) {
+                --faults.glitches;
+                ++stats.glitches;
+                read_data ^= 1 << (rand() % 16);
+            }
             state = RDATA_MSB;
         }
         else if (data == AnalogDigitalConverter::ADC_START) {
-            start = true;
-            tick();
+            startConversion();
         }
     }
     else if (state == READ_REG) {
@@ -618,52 +678,77 @@ uint8_t AnalogDigitalConverterChip::transfer(uint8_t data) {
     }
     else if (state == WRITE_REG) {
         register_values[register_index++] = data;
+        if (register_index == register_end) {
+            state = IDLE;
+        }
     }
     else if (state == WR1S0) {
         register_values[0] = data;
         state = IDLE;
     }
     else if (state == RDATA_MSB) {
-        result = getValue() >> 8;
+        result = read_data >> 8;
         state = RDATA_LSB;
     }
     else if (state == RDATA_LSB) {
-        result = getValue() & 0xFF;
+        result = read_data & 0xFF;
     }
 
     return result;
 }
 
-void AnalogDigitalConverterChip::tick() {
-    if (tick_counter < 4) {
-        ++tick_counter;
+void AnalogDigitalConverterChip::startConversion() {
+    // register 01h: [7:5] data rate, normal mode
+    conversion_time = 1000000UL / ADC_DATA_RATE[register_values[1] >> 5];
+    conversion_start = micros();
+    // input is selected for the whole conversion
+    conversion_mux = register_values[0];
+    converting = true;
+}
 
-        if (start) {
-            start = false;
+void AnalogDigitalConverterChip::tick(uint32_t tick_usec) {
+    if (!converting || tick_usec - conversion_start < conversion_time) {
+        return;
+    }
 
-            //static const int CODE_TO_SPS [] = { 20, 45, 90, 175, 330, 600, 1000 };
-            //psu::delayMicroseconds(1000000 / CODE_TO_SPS[ADC_SPS]);
+    converting = false;
+    ++stats.conversions;
 
-            InterruptCallback callback = interrupt_callbacks[convend_pin];
-            if (callback) {
-                callback();
-            }
-        }
+    data = getValue();
+    if (faults.noise > 0) {
+        int32_t value = data + rand() % (2 * faults.noise + 1) - faults.noise;
+        data = (uint16_t)util::clamp(value, AnalogDigitalConverter::ADC_MIN, AnalogDigitalConverter::ADC_MAX);
+    }
+
+    if (faults.missed_interrupts > 0) {
+        --faults.missed_interrupts;
+        ++stats.missed_interrupts;
+        return;
+    }
+
+    uint32_t latency = tick_usec - conversion_start - conversion_time;
+    if (latency > stats.max_latency) {
+        stats.max_latency = latency;
+    }
+    stats.total_latency += latency;
+    ++stats.num_latencies;
 
-        --tick_counter;
+    InterruptCallback callback = interrupt_callbacks[convend_pin];
+    if (callback) {
+        callback();
     }
 }
 
 uint16_t AnalogDigitalConverterChip::getValue() {
     updateValues();
 
-    if (register_values[0] == AnalogDigitalConverter::ADC_REG0_READ_U_MON) {
+    if (conversion_mux == AnalogDigitalConverter::ADC_REG0_READ_U_MON) {
         return u_mon;
     }
-    if (register_values[0] == AnalogDigitalConverter::ADC_REG0_READ_I_MON) {
+    if (conversion_mux == AnalogDigitalConverter::ADC_REG0_READ_I_MON) {
         return i_mon;
     }
-    if (register_values[0] == AnalogDigitalConverter::ADC_REG0_READ_U_SET) {
+    if (conversion_mux == AnalogDigitalConverter::ADC_REG0_READ_U_SET) {
         return u_set;
     }
     else {
@@ -687,7 +772,6 @@ void AnalogDigitalConverterChip::setDacValue(uint8_t data_buffer, uint16_t dac_v
             AnalogDigitalConverter::ADC_MIN, AnalogDigitalConverter::ADC_MAX);
     }
     updateValues();
-    tick();
 }
 
 void AnalogDigitalConverterChip::updateValues() {
@@ -698,19 +782,9 @@ void AnalogDigitalConverterChip::updateValues() {
                 float u_set_v = channel.isRemoteProgrammingEnabled() ? util::remap(channel.simulator.voltProgExt, 0, 0, 2.5, channel.u.max) : channel.remapAdcDataToVoltage(u_set);
                 float i_set_a = channel.remapAdcDataToCurrent(i_set);
 
-                float u_mon_v = i_set_a * channel.simulator.load;
-                float i_mon_a = i_set_a;
-                if (u_mon_v > u_set_v) {
-                    u_mon_v = u_set_v;
-                    i_mon_a = u_set_v / channel.simulator.load;
-
-                    ioexp_chip.cv = true;
-                    ioexp_chip.cc = false;
-                }
-                else {
-                    ioexp_chip.cv = false;
-                    ioexp_chip.cc = true;
-                }
+                float u_mon_v;
+                float i_mon_a;
+                load::calculate(i, channel.isOutputEnabled(), u_set_v, i_set_a, u_mon_v, i_mon_a, ioexp_chip.cv, ioexp_chip.cc);
 
                 u_mon = channel.remapVoltageToAdcData(u_mon_v);
                 i_mon = channel.remapCurrentToAdcData(i_mon_a);
@@ -746,9 +820,29 @@ void AnalogDigitalConverterChip::updateValues() {
 DigitalAnalogConverterChip::DigitalAnalogConverterChip(AnalogDigitalConverterChip &adc_chip_)
     : adc_chip(adc_chip_)
     , state(IDLE)
+    , history_count(0)
 {
 }
 
+DigitalAnalogConverterChip::WriteStatistics &DigitalAnalogConverterChip::getWriteStatistics(int pin) {
+    return pin == DAC1_SELECT ? dac_chip1.write_stats : dac_chip2.write_stats;
+}
+
+void DigitalAnalogConverterChip::resetWriteStatistics(int pin) {
+    memset(&getWriteStatistics(pin), 0, sizeof(WriteStatistics));
+}
+
+const DigitalAnalogConverterChip::HistoryEntry *DigitalAnalogConverterChip::getHistory(int pin, int &count) {
+    DigitalAnalogConverterChip &chip = pin == DAC1_SELECT ? dac_chip1 : dac_chip2;
+    count = chip.history_count;
+    return chip.history;
+}
+
+void DigitalAnalogConverterChip::clearHistory(int pin) {
+    DigitalAnalogConverterChip &chip = pin == DAC1_SELECT ? dac_chip1 : dac_chip2;
+    chip.history_count = 0;
+}
+
 void DigitalAnalogConverterChip::select() {
     state = IDLE;
 }
@@ -769,6 +863,29 @@ uint8_t DigitalAnalogConverterChip::transfer(uint8_t data) {
     else if (state == DATA_BUFFER_LSB) {
         value |= data;
         adc_chip.setDacValue(data_buffer, value);
+
+        if (history_count < HISTORY_SIZE) {
+            HistoryEntry &entry = history[history_count++];
+            entry.time = micros();
+            entry.buffer = data_buffer;
+            entry.value = value;
+        }
+
+        if (data_buffer == DigitalAnalogConverter::DATA_BUFFER_A) {
+            uint32_t now = micros();
+            if (write_stats.num_writes > 0) {
+                uint32_t interval = now - write_stats.last_write_time;
+                if (write_stats.num_writes == 1 || interval < write_stats.min_interval) {
+                    write_stats.min_interval = interval;
+                }
+                if (interval > write_stats.max_interval) {
+                    write_stats.max_interval = interval;
+                }
+            }
+            write_stats.last_write_time = now;
+            write_stats.last_value = value;
+            ++write_stats.num_writes;
+        }
     }
 
     return result;
@@ -47,8 +47,14 @@ uint8_t transfer(uint8_t data);
 
 /// This should be called periodically by the simulator main loop.
 /// For the case if some of the chips need to do something in the background.
+/// Interrupts are asynchronous on the real hardware, so this is also called
+/// whenever firmware reads the time, e.g. while it waits in spi_queue::delay.
 void tick();
 
+/// Called by the firmware noInterrupts/interrupts. While interrupts are disabled
+/// tick doesn't deliver anything, the pending interrupts are delivered when enabled.
+void enableInterrupts(bool enable);
+
 ////////////////////////////////////////////////////////////////////////////////
 
 /// Abstract base class for all the chips.
@@ -226,6 +232,10 @@ private:
 ////////////////////////////////////////////////////////////////////////////////
 
 /// ADS1120 chip simulation.
+///
+/// Single shot conversion takes 1 / data rate programmed in the register 01h.
+/// Result is latched and DRDY interrupt is raised when the conversion is done,
+/// see chips::tick. Noise, lost interrupts and corrupted reads can be injected.
 class AnalogDigitalConverterChip : public Chip {
     friend class DigitalAnalogConverterChip;
 
@@ -239,9 +249,33 @@ class AnalogDigitalConverterChip : public Chip {
     };
 
 public:
+    /// Injected faults, counts are decremented as faults are applied.
+    struct Faults {
+        /// Max. noise added to each conversion result, in ADC counts.
+        uint16_t noise;
+        /// Number of next conversions completed without the DRDY interrupt.
+        uint16_t missed_interrupts;
+        /// Number of next RDATA reads with one bit flipped.
+        uint16_t glitches;
+    };
+
+    struct Statistics {
+        uint32_t conversions;
+        uint32_t missed_interrupts;
+        uint32_t glitches;
+        /// Time from the end of conversion until DRDY interrupt is handled, in microseconds.
+        uint32_t max_latency;
+        uint32_t total_latency;
+        uint32_t num_latencies;
+    };
+
     AnalogDigitalConverterChip(IOExpanderChip &ioexp_chip_, int convend_pin_);
 
-    void tick();
+    static Faults &getFaults(int pin);
+    static Statistics &getStatistics(int pin);
+    static void resetStatistics(int pin);
+
+    void tick(uint32_t tick_usec);
 
     void select();
     uint8_t transfer(uint8_t data);
@@ -251,14 +285,22 @@ private:
     int convend_pin;
     State state;
     uint8_t register_index;
+    uint8_t register_end;
     uint8_t register_values[4];
     uint16_t u_mon;
     uint16_t i_mon;
     uint16_t u_set;
     uint16_t i_set;
-    int tick_counter;
-    bool start;
-
+    bool converting;
+    uint32_t conversion_start;
+    uint32_t conversion_time;
+    uint8_t conversion_mux;
+    uint16_t data;
+    uint16_t read_data;
+    Faults faults;
+    Statistics stats;
+
+    void startConversion();
     uint16_t getValue();
     void setDacValue(uint8_t data_buffer, uint16_t value);
     void updateValues();
@@ -275,8 +317,33 @@ class DigitalAnalogConverterChip : public Chip {
     };
 
 public:
+    /// Timing of the voltage (DATA_BUFFER_A) writes, used to verify LIST execution.
+    struct WriteStatistics {
+        uint32_t num_writes;
+        uint32_t last_write_time;
+        uint32_t min_interval;
+        uint32_t max_interval;
+        uint16_t last_value;
+    };
+
+    /// Captured DAC write, used to verify ramp profiles.
+    struct HistoryEntry {
+        uint32_t time;
+        uint8_t buffer;
+        uint16_t value;
+    };
+
+    /// Max. number of captured writes, capturing stops when history is full.
+    static const int HISTORY_SIZE = 512;
+
     DigitalAnalogConverterChip(AnalogDigitalConverterChip &adc_chip_);
 
+    static WriteStatistics &getWriteStatistics(int pin);
+    static void resetWriteStatistics(int pin);
+
+    static const HistoryEntry *getHistory(int pin, int &count);
+    static void clearHistory(int pin);
+
     void select();
     uint8_t transfer(uint8_t data);
 
@@ -285,6 +352,9 @@ private:
     State state;
     uint8_t data_buffer;
     uint16_t value;
+    WriteStatistics write_stats;
+    HistoryEntry history[HISTORY_SIZE];
+    int history_count;
 };
 
 ////////////////////////////////////////////////////////////////////////////////
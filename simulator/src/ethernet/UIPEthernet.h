@@ -27,6 +27,7 @@ namespace arduino {
 class Enc28J60Network {
 public:
     static void setControlCS(int pin);
+    static void setTransactionHooks(void (*begin)(void), void (*end)(void));
 };
 
 /// Arduino Ethernet object simulator
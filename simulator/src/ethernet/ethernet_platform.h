@@ -33,6 +33,10 @@ int write(const char *buffer, int buffer_size);
 
 void stop();
 
+bool udp_begin(int port);
+int udp_send(uint32_t ip_address, int port, const char *buffer, int buffer_size);
+void udp_stop();
+
 }
 }
 } // namespace eez::psu::ethernet_platform
@@ -20,6 +20,7 @@
 #include "UIPEthernet.h"
 #include "UIPServer.h"
 #include "UIPClient.h"
+#include "UIPUdp.h"
 #include "ethernet_platform.h"
 
 namespace eez {
@@ -32,6 +33,9 @@ namespace arduino {
 void Enc28J60Network::setControlCS(int pin) {
 }
 
+void Enc28J60Network::setTransactionHooks(void (*begin)(void), void (*end)(void)) {
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 SimulatorEthernet Ethernet;
@@ -103,6 +107,39 @@ void EthernetClient::stop() {
     ethernet_platform::stop();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+
+EthernetUDP::EthernetUDP() : remote_ip_address(0), remote_port(0), size(0) {
+}
+
+uint8_t EthernetUDP::begin(uint16_t port) {
+    return ethernet_platform::udp_begin(port) ? 1 : 0;
+}
+
+void EthernetUDP::stop() {
+    ethernet_platform::udp_stop();
+}
+
+int EthernetUDP::beginPacket(IPAddress ip, uint16_t port) {
+    remote_ip_address = ip;
+    remote_port = port;
+    size = 0;
+    return 1;
+}
+
+size_t EthernetUDP::write(const uint8_t *data, size_t len) {
+    if (size + len > sizeof(buffer)) {
+        len = sizeof(buffer) - size;
+    }
+    memcpy(buffer + size, data, len);
+    size += len;
+    return len;
+}
+
+int EthernetUDP::endPacket() {
+    return ethernet_platform::udp_send(remote_ip_address, remote_port, (const char *)buffer, (int)size) == (int)size ? 1 : 0;
+}
+
 }
 }
 }
@@ -29,8 +29,10 @@
 #endif
 
 #include "dll.h"
+#include "thread.h"
 
 #include <stdio.h>
+#include <atomic>
 
 #ifdef _WIN32
 #define LIB_FILE_PATH "eez_imgui.dll"
@@ -50,8 +52,36 @@ static bool g_lib_loaded = false;
 static eez_dll_lib_t g_lib = 0;
 static create_window_ptr_t g_create_window_ptr = 0;
 static get_desktop_resolution_ptr_t g_get_desktop_resolution_ptr = 0;
-static Window* g_window;
-static Data g_data;
+
+/// Front panel window is owned by the render thread.
+enum RenderThreadState {
+    RENDER_THREAD_NONE,
+    RENDER_THREAD_PENDING,
+    RENDER_THREAD_OPENED,
+    RENDER_THREAD_FAILED,
+    RENDER_THREAD_CLOSED
+};
+
+static eez_thread_handle_t g_render_thread;
+static std::atomic<int> g_render_thread_state(RENDER_THREAD_NONE);
+static std::atomic<bool> g_render_thread_quit(false);
+
+/// Triple buffer of data snapshots: firmware thread fills g_data[g_back],
+/// render thread draws g_data[g_front] and they are exchanged through g_middle.
+#define SNAPSHOT_INDEX_MASK 0x03
+#define SNAPSHOT_FRESH 0x04
+
+static Data g_data[3];
+static int g_back = 0;
+static std::atomic<int> g_middle(1);
+static int g_front = 2;
+
+/// Single producer (render thread), single consumer (firmware thread) input queue.
+#define INPUT_QUEUE_SIZE 32
+
+static Input g_input_queue[INPUT_QUEUE_SIZE];
+static std::atomic<int> g_input_queue_head(0);
+static std::atomic<int> g_input_queue_tail(0);
 
 static beep_ptr_t g_beep_ptr = 0;
 
@@ -73,38 +103,130 @@ void load_lib() {
     }
 }
 
+static void pushInput(Data *data) {
+    int tail = g_input_queue_tail.load(std::memory_order_relaxed);
+    int next = (tail + 1) % INPUT_QUEUE_SIZE;
+    if (next == g_input_queue_head.load(std::memory_order_acquire)) {
+        // firmware thread is not keeping up, drop this frame input
+        return;
+    }
+
+    Input &input = g_input_queue[tail];
+    input.reset = data->reset;
+    input.ch1_load_widget = data->ch1.loadWidget;
+    input.ch2_load_widget = data->ch2.loadWidget;
+    input.local_control_widget = data->local_control_widget;
+
+    g_input_queue_tail.store(next, std::memory_order_release);
+}
+
+static bool popInput(Input *input) {
+    int head = g_input_queue_head.load(std::memory_order_relaxed);
+    if (head == g_input_queue_tail.load(std::memory_order_acquire)) {
+        return false;
+    }
+
+    *input = g_input_queue[head];
+
+    g_input_queue_head.store((head + 1) % INPUT_QUEUE_SIZE, std::memory_order_release);
+    return true;
+}
+
+static THREAD_PROC(renderThread) {
+    int w, h;
+    g_get_desktop_resolution_ptr(&w, &h);
+
+    Window *window = g_create_window_ptr(getWindowDefinition(w, h));
+    if (!window) {
+        g_render_thread_state = RENDER_THREAD_FAILED;
+        return 0;
+    }
+
+    g_render_thread_state = RENDER_THREAD_OPENED;
+
+    bool has_data = false;
+
+    while (!g_render_thread_quit && window->pollEvent()) {
+        window->beginUpdate();
+
+        if (g_middle.load(std::memory_order_acquire) & SNAPSHOT_FRESH) {
+            g_front = g_middle.exchange(g_front, std::memory_order_acq_rel) & SNAPSHOT_INDEX_MASK;
+            has_data = true;
+        }
+
+        if (has_data) {
+            Data *data = &g_data[g_front];
+            render(window, data);
+            pushInput(data);
+        }
+
+        window->endUpdate();
+    }
+
+    delete window;
+
+    g_render_thread_state = RENDER_THREAD_CLOSED;
+    return 0;
+}
+
+static void joinRenderThread() {
+    eez_thread_join(g_render_thread);
+    g_render_thread = 0;
+    g_render_thread_quit = false;
+    g_render_thread_state = RENDER_THREAD_NONE;
+
+    // discard input from the closed window
+    g_input_queue_head = g_input_queue_tail.load();
+}
+
 bool isOpened() {
-    return g_window ? true : false;
+    return g_render_thread_state == RENDER_THREAD_OPENED;
 }
 
 bool open() {
-    if (g_window) {
+    if (g_render_thread_state == RENDER_THREAD_OPENED) {
         return true;
     }
 
+    if (g_render_thread_state != RENDER_THREAD_NONE) {
+        // window is closing
+        return false;
+    }
+
     load_lib();
     
     if (!g_create_window_ptr) {
         return false;
     }
 
-	int w, h;
-	g_get_desktop_resolution_ptr(&w, &h);
-    
-    g_window = g_create_window_ptr(getWindowDefinition(w, h));
+    g_render_thread_state = RENDER_THREAD_PENDING;
+    g_render_thread = eez_thread_create(renderThread, 0);
+    if (!g_render_thread) {
+        g_render_thread_state = RENDER_THREAD_NONE;
+        return false;
+    }
+
+    while (g_render_thread_state == RENDER_THREAD_PENDING) {
+        delay(1);
+    }
+
+    if (g_render_thread_state != RENDER_THREAD_OPENED) {
+        joinRenderThread();
+        return false;
+    }
 
     if (!persist_conf::dev_conf.gui_opened) {
         persist_conf::dev_conf.gui_opened = true;
         persist_conf::saveDevice();
     }
 
-    return g_window != 0;
+    return true;
 }
 
 void close() {
-    if (g_window) {
-        delete g_window;
-        g_window = 0;
+    if (g_render_thread) {
+        g_render_thread_quit = true;
+        joinRenderThread();
 
         if (persist_conf::dev_conf.gui_opened) {
             persist_conf::dev_conf.gui_opened = false;
@@ -114,24 +236,27 @@ void close() {
 }
 
 void tick() {
-    if (g_window) {
-        if (g_window->pollEvent()) {
-            g_window->beginUpdate();
-
-            fillData(&g_data);
-
-            render(g_window, &g_data);
-
-            processData(&g_data);
-
-            g_window->endUpdate();
+    if (g_render_thread_state == RENDER_THREAD_OPENED) {
+        Input input;
+        while (popInput(&input)) {
+            processData(&input);
         }
-        else {
-            close();
+
+        // Fill the next snapshot only after the render thread took the previous one,
+        // so framebuffer conversion runs at the display rate and not at the tick rate.
+        if (!(g_middle.load(std::memory_order_acquire) & SNAPSHOT_FRESH)) {
+            fillData(&g_data[g_back]);
+            g_back = g_middle.exchange(g_back | SNAPSHOT_FRESH, std::memory_order_acq_rel) & SNAPSHOT_INDEX_MASK;
         }
     }
+    else if (g_render_thread_state == RENDER_THREAD_CLOSED) {
+        // window was closed by the user
+        close();
+    }
 }
 
+/// Queues the tone and returns immediately. Without the GUI library (headless run)
+/// there is no audio backend and the tone is dropped.
 void beep(double freq, int duration) {
     load_lib();
     if (g_beep_ptr) {
@@ -29,7 +29,7 @@ namespace psu {
 namespace simulator {
 namespace front_panel {
 
-static char str_load[2][128];
+static float g_loadOnMouseDown[2] = { NAN, NAN };
 
 void fillChannelData(ChannelData *data, int ch) {
     if (CH_NUM >= ch) {
@@ -70,7 +70,7 @@ void fillChannelData(ChannelData *data, int ch) {
         if (channel.simulator.getLoadEnabled()) {
             data->load = channel.simulator.getLoad();
 
-            char *str = &str_load[ch - 1][0];
+            char *str = data->load_text;
             if (data->load == 0) {
                 strcpy(str, "Shorted!");
             }
@@ -86,11 +86,10 @@ void fillChannelData(ChannelData *data, int ch) {
                 *str = 0;
                 util::strcatLoad(str, data->load);
             }
-            data->load_text = str;
         }
         else {
             data->load = 0;
-            data->load_text = 0;
+            data->load_text[0] = 0;
         }
     }
     else {
@@ -101,14 +100,14 @@ void fillChannelData(ChannelData *data, int ch) {
         data->sense_plus = false;
         data->sense_minus = false;
         data->out_minus = false;
-        data->load_text = 0;
+        data->load_text[0] = 0;
 #elif EEZ_PSU_SELECTED_REVISION == EEZ_PSU_REVISION_R3B4
         data->cv = false;
         data->cc = false;
         data->out = false;
         data->sense = false;
         data->prog = false;
-        data->load_text = 0;
+        data->load_text[0] = 0;
 #endif
     }
 }
@@ -147,27 +146,28 @@ void fillData(Data *data) {
     fillLocalControlBuffer(data);
 }
 
-void processChannelData(ChannelData *data, int ch) {
+void processChannelData(imgui::UserWidget *loadWidget, int ch) {
     if (CH_NUM >= ch) {
         Channel &channel = Channel::get(ch - 1);
+        float &loadOnMouseDown = g_loadOnMouseDown[ch - 1];
      
-        if (data->loadWidget.mouse_data.is_down) {
-            if (data->loadWidget.mouse_data.down_x >= 0 &&
-                data->loadWidget.mouse_data.down_x < data->loadWidget.w &&
-                data->loadWidget.mouse_data.down_y >= 0 &&
-                data->loadWidget.mouse_data.down_y < data->loadWidget.h) 
+        if (loadWidget->mouse_data.is_down) {
+            if (loadWidget->mouse_data.down_x >= 0 &&
+                loadWidget->mouse_data.down_x < loadWidget->w &&
+                loadWidget->mouse_data.down_y >= 0 &&
+                loadWidget->mouse_data.down_y < loadWidget->h) 
             {
-                data->loadOnMouseDown = data->load;
+                loadOnMouseDown = channel.simulator.getLoadEnabled() ? channel.simulator.getLoad() : 0;
             } else {
-                data->loadOnMouseDown = NAN;
+                loadOnMouseDown = NAN;
             }
         }
 
-        if (!util::isNaN(data->loadOnMouseDown)) {
-            if (data->loadWidget.mouse_data.is_pressed) {
+        if (!util::isNaN(loadOnMouseDown)) {
+            if (loadWidget->mouse_data.is_pressed) {
                 if (channel.simulator.getLoadEnabled()) {
                     float step = 1;
-                    float load = data->loadOnMouseDown + step * (data->loadWidget.mouse_data.x - data->loadWidget.mouse_data.down_x);
+                    float load = loadOnMouseDown + step * (loadWidget->mouse_data.x - loadWidget->mouse_data.down_x);
                     if (load < 0 || util::isNaN(load)) {
                         load = 0;
                     } else if (load > 10000000) {
@@ -175,8 +175,8 @@ void processChannelData(ChannelData *data, int ch) {
                     }
                     channel.simulator.setLoad(load);
                 }
-            } else if (data->loadWidget.mouse_data.is_up) {
-                if (data->loadWidget.mouse_data.up_x == data->loadWidget.mouse_data.down_x && data->loadWidget.mouse_data.up_y == data->loadWidget.mouse_data.down_y) {
+            } else if (loadWidget->mouse_data.is_up) {
+                if (loadWidget->mouse_data.up_x == loadWidget->mouse_data.down_x && loadWidget->mouse_data.up_y == loadWidget->mouse_data.down_y) {
                     channel.simulator.setLoadEnabled(!channel.simulator.getLoadEnabled());
                 }
             }
@@ -184,10 +184,10 @@ void processChannelData(ChannelData *data, int ch) {
     }
 }
 
-void processData(Data *data) {
+void processData(Input *input) {
     static bool reseting = false;
 
-    if (data->reset) {
+    if (input->reset) {
         if (!reseting) {
             reseting = true;
             reset();
@@ -196,28 +196,28 @@ void processData(Data *data) {
     }
 
     //
-    processChannelData(&data->ch1, 1);
-    processChannelData(&data->ch2, 2);
+    processChannelData(&input->ch1_load_widget, 1);
+    processChannelData(&input->ch2_load_widget, 2);
 
     //
     bool is_down = false;
     int x = -1;
     int y = -1;
 
-    if (data->local_control_widget.mouse_data.is_pressed &&
-        data->local_control_widget.mouse_data.down_x >= 0 &&
-        data->local_control_widget.mouse_data.down_x < data->local_control_widget.w &&
-        data->local_control_widget.mouse_data.down_y >= 0 &&
-        data->local_control_widget.mouse_data.down_y < data->local_control_widget.h) 
+    imgui::UserWidget *local_control_widget = &input->local_control_widget;
+    if (local_control_widget->mouse_data.is_pressed &&
+        local_control_widget->mouse_data.down_x >= 0 &&
+        local_control_widget->mouse_data.down_x < local_control_widget->w &&
+        local_control_widget->mouse_data.down_y >= 0 &&
+        local_control_widget->mouse_data.down_y < local_control_widget->h) 
     {
         is_down = true;
-        x = (int)round(data->local_control_widget.mouse_data.x / (1.0 * data->local_control_widget.w / data->local_control_widget.pixels_w));
-        y = (int)round(data->local_control_widget.mouse_data.y / (1.0 * data->local_control_widget.h / data->local_control_widget.pixels_h));
+        x = (int)round(local_control_widget->mouse_data.x / (1.0 * local_control_widget->w / local_control_widget->pixels_w));
+        y = (int)round(local_control_widget->mouse_data.y / (1.0 * local_control_widget->h / local_control_widget->pixels_h));
     }
 
-    gui::touch::touch_write(is_down, x, y);
+    simulator::touchWrite(is_down, x, y);
 }
-
 }
 }
 }
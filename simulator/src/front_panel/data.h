@@ -38,9 +38,9 @@ struct ChannelData {
 	bool sense;
 	bool prog;
 #endif
-    const char *load_text;
+    /// Empty if load is disconnected.
+    char load_text[32];
     float load;
-    float loadOnMouseDown;
     imgui::UserWidget loadWidget;
 };
 
@@ -56,8 +56,16 @@ struct Data {
     imgui::UserWidget local_control_widget;
 };
 
+/// Input collected by the render thread in one frame, processed by the firmware thread.
+struct Input {
+    bool reset;
+    imgui::UserWidget ch1_load_widget;
+    imgui::UserWidget ch2_load_widget;
+    imgui::UserWidget local_control_widget;
+};
+
 void fillData(Data *data);
-void processData(Data *data);
+void processData(Input *input);
 
 }
 }
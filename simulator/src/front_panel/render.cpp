@@ -96,7 +96,7 @@ void render(Window *window, Data *data) {
     window->addOnOffImage(1071, 80, 17, 16, data->ch1.sense_plus, R1B9_IMAGE("led-yellow"), R1B9_IMAGE("led-off"));
     window->addOnOffImage(1159, 80, 17, 16, data->ch1.sense_minus, R1B9_IMAGE("led-yellow"), R1B9_IMAGE("led-off"));
     window->addOnOffImage(1247, 80, 17, 16, data->ch1.out_minus, R1B9_IMAGE("led-green"), R1B9_IMAGE("led-off"));
-    if (data->ch1.load_text) {
+    if (*data->ch1.load_text) {
         window->addImage(992, 184, 266, 71, R1B9_IMAGE("load"));
         window->addText(1047, 217, 156, 32, data->ch1.load_text);
     }
@@ -107,7 +107,7 @@ void render(Window *window, Data *data) {
     window->addOnOffImage(1071, 324, 17, 16, data->ch2.sense_plus, R1B9_IMAGE("led-yellow"), R1B9_IMAGE("led-off"));
     window->addOnOffImage(1159, 324, 17, 16, data->ch2.sense_minus, R1B9_IMAGE("led-yellow"), R1B9_IMAGE("led-off"));
     window->addOnOffImage(1247, 324, 17, 16, data->ch2.out_minus, R1B9_IMAGE("led-green"), R1B9_IMAGE("led-off"));
-    if (data->ch2.load_text) {
+    if (*data->ch2.load_text) {
         window->addImage(992, 428, 266, 71, R1B9_IMAGE("load"));
         window->addText(1047, 461, 156, 32, data->ch2.load_text);
     }
@@ -130,7 +130,7 @@ void render(Window *window, Data *data) {
     window->addOnOffImage(RECT(713, 267, 17, 17), data->ch1.out, R3B4_IMAGE("led-green"), R3B4_IMAGE("led-off"));
     window->addOnOffImage(RECT(689, 128, 17, 17), data->ch1.sense, R3B4_IMAGE("led-yellow"), R3B4_IMAGE("led-off"));
     window->addOnOffImage(RECT(650, 128, 17, 17), data->ch1.prog, R3B4_IMAGE("led-red"), R3B4_IMAGE("led-off"));
-    if (data->ch1.load_text) {
+    if (*data->ch1.load_text) {
         window->addImage(RECT(652, 294, 138, 66), R3B4_IMAGE("load"));
         window->addText(RECT(677, 326, 88, 29), data->ch1.load_text);
     } else {
@@ -143,7 +143,7 @@ void render(Window *window, Data *data) {
     window->addOnOffImage(RECT(894, 267, 17, 17), data->ch2.out, R3B4_IMAGE("led-green"), R3B4_IMAGE("led-off"));
     window->addOnOffImage(RECT(918, 128, 17, 17), data->ch2.sense, R3B4_IMAGE("led-yellow"), R3B4_IMAGE("led-off"));
     window->addOnOffImage(RECT(879, 128, 17, 17), data->ch2.prog, R3B4_IMAGE("led-red"), R3B4_IMAGE("led-off"));
-    if (data->ch2.load_text) {
+    if (*data->ch2.load_text) {
         window->addImage(RECT(834, 294, 138, 66), R3B4_IMAGE("load"));
         window->addText(RECT(859, 326, 88, 29), data->ch2.load_text);
     } else {
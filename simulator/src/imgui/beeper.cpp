@@ -21,8 +21,9 @@
 #include <SDL.h>
 #include <SDL_audio.h>
 
-#include <queue>
+#include <atomic>
 #include <cmath>
+#include <stdio.h>
 
 #include "dll.h"
 #undef min
@@ -32,64 +33,132 @@ namespace eez {
 const int AMPLITUDE = 28000;
 const int FREQUENCY = 44100;
 
+/// Tones not yet taken by the audio callback.
+const int TONE_QUEUE_SIZE = 16;
+
+/// Number of tones that can sound at the same time.
+const int NUM_VOICES = 4;
+
 struct BeepData {
     double freq;
     int samplesLeft;
     double v;
 };
 
+/// Single producer (firmware thread), single consumer (audio callback) tone queue.
+static BeepData g_tone_queue[TONE_QUEUE_SIZE];
+static std::atomic<int> g_tone_queue_head(0);
+static std::atomic<int> g_tone_queue_tail(0);
+
+/// Accessed only from the audio callback.
+static BeepData g_voices[NUM_VOICES];
+
+enum AudioBackend {
+    AUDIO_BACKEND_NONE,
+    AUDIO_BACKEND_SDL,
+    /// Audio device is not available (e.g. headless run), tones are dropped.
+    AUDIO_BACKEND_NULL
+};
+
+static AudioBackend g_audio_backend = AUDIO_BACKEND_NONE;
+static SDL_AudioDeviceID g_audio_device;
+
+static void startQueuedTones() {
+    int head = g_tone_queue_head.load(std::memory_order_relaxed);
+    int tail = g_tone_queue_tail.load(std::memory_order_acquire);
+
+    for (; head != tail; head = (head + 1) % TONE_QUEUE_SIZE) {
+        // take a free voice, or the one closest to its end
+        int i_voice = 0;
+        for (int i = 1; i < NUM_VOICES; ++i) {
+            if (g_voices[i].samplesLeft < g_voices[i_voice].samplesLeft) {
+                i_voice = i;
+            }
+        }
+        g_voices[i_voice] = g_tone_queue[head];
+    }
+
+    g_tone_queue_head.store(head, std::memory_order_release);
+}
+
 void audio_callback(void *userdata, Uint8 *_stream, int _length) {
-    BeepData &beep_data = *((BeepData *)userdata);
     Sint16* stream = (Sint16*)_stream;
     int length = _length / 2;
 
+    startQueuedTones();
+
     for (int i = 0; i < length; ++i) {
-        if (beep_data.samplesLeft > 0) {
-            stream[i] = (Sint16)(AMPLITUDE * std::sin(beep_data.v * 2 * M_PI / FREQUENCY));
-            beep_data.v += beep_data.freq;
-            --beep_data.samplesLeft;
-        } else {
-            stream[i] = 0;
+        int sample = 0;
+        int num_playing = 0;
+
+        for (int j = 0; j < NUM_VOICES; ++j) {
+            BeepData &voice = g_voices[j];
+            if (voice.samplesLeft > 0) {
+                sample += (int)(AMPLITUDE * std::sin(voice.v * 2 * M_PI / FREQUENCY));
+                voice.v += voice.freq;
+                --voice.samplesLeft;
+                ++num_playing;
+            }
         }
+
+        stream[i] = (Sint16)(num_playing > 1 ? sample / num_playing : sample);
     }
 }
 
-void beep(double freq, int duration) {
-    SDL_InitSubSystem(SDL_INIT_AUDIO);
+static bool openAudio() {
+    if (g_audio_backend == AUDIO_BACKEND_NONE) {
+        g_audio_backend = AUDIO_BACKEND_NULL;
 
-    BeepData beep_data;
+        if (SDL_InitSubSystem(SDL_INIT_AUDIO) != 0) {
+            printf("Failed to init audio: %s\n", SDL_GetError());
+            return false;
+        }
 
-    beep_data.freq = freq;
-    beep_data.samplesLeft = duration * FREQUENCY / 1000;
-    beep_data.v = 0;
+        SDL_AudioSpec desiredSpec;
 
-    SDL_AudioSpec desiredSpec;
-    
-    SDL_memset(&desiredSpec, 0, sizeof(desiredSpec));
+        SDL_memset(&desiredSpec, 0, sizeof(desiredSpec));
 
-    desiredSpec.freq = FREQUENCY;
-    desiredSpec.format = AUDIO_S16SYS;
-    desiredSpec.channels = 1;
-    desiredSpec.samples = 2048;
-    desiredSpec.callback = audio_callback;
-    desiredSpec.userdata = &beep_data;
+        desiredSpec.freq = FREQUENCY;
+        desiredSpec.format = AUDIO_S16SYS;
+        desiredSpec.channels = 1;
+        desiredSpec.samples = 512;
+        desiredSpec.callback = audio_callback;
+        desiredSpec.userdata = 0;
 
-    SDL_AudioSpec obtainedSpec;
+        SDL_AudioSpec obtainedSpec;
 
-    SDL_AudioDeviceID dev = SDL_OpenAudioDevice(NULL, 0, &desiredSpec, &obtainedSpec, 0);
-    if (dev == 0) {
-        printf("Failed to open audio: %s\n", SDL_GetError());
-    } else {
-        // start play audio
-        SDL_PauseAudioDevice(dev, 0);
+        g_audio_device = SDL_OpenAudioDevice(NULL, 0, &desiredSpec, &obtainedSpec, 0);
+        if (g_audio_device == 0) {
+            printf("Failed to open audio: %s\n", SDL_GetError());
+            return false;
+        }
 
-        // wait
-        do {
-            SDL_Delay(20);
-        } while (beep_data.samplesLeft > 0);
+        // device is kept open and outputs silence when there is no tone
+        SDL_PauseAudioDevice(g_audio_device, 0);
 
-        SDL_CloseAudioDevice(dev);
+        g_audio_backend = AUDIO_BACKEND_SDL;
     }
+
+    return g_audio_backend == AUDIO_BACKEND_SDL;
+}
+
+void beep(double freq, int duration) {
+    if (!openAudio()) {
+        return;
+    }
+
+    int tail = g_tone_queue_tail.load(std::memory_order_relaxed);
+    int next = (tail + 1) % TONE_QUEUE_SIZE;
+    if (next == g_tone_queue_head.load(std::memory_order_acquire)) {
+        // audio callback is not keeping up, drop the tone
+        return;
+    }
+
+    g_tone_queue[tail].freq = freq;
+    g_tone_queue[tail].samplesLeft = duration * FREQUENCY / 1000;
+    g_tone_queue[tail].v = 0;
+
+    g_tone_queue_tail.store(next, std::memory_order_release);
 }
 
 } // namespace eez
@@ -0,0 +1,321 @@
+/*
+ * EEZ PSU Firmware
+ * Copyright (C) 2015-present, Envox d.o.o.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+ 
+#include "psu.h"
+#include "load.h"
+
+namespace eez {
+namespace psu {
+namespace simulator {
+namespace load {
+
+/// Max. number of points in the CSV time series.
+#define LOAD_TABLE_SIZE 256
+
+/// Max. integration step of the capacitor voltage, in seconds.
+#define CAPACITOR_STEP 0.0001f
+/// Longer time since the last calculation (e.g. at start) is not integrated.
+#define CAPACITOR_MAX_TIME 0.1f
+
+struct TablePoint {
+    float time;
+    float level;
+};
+
+struct Scenario {
+    Mode mode;
+    Shape shape;
+    float from;
+    float to;
+    float time1;
+    float time2;
+    uint32_t start_time;
+
+    TablePoint table[LOAD_TABLE_SIZE];
+    int table_count;
+
+    float capacitance;
+    float u_cap;
+    uint32_t last_time;
+};
+
+static Scenario g_scenarios[CH_MAX];
+
+static void start(Scenario &scenario, Shape shape) {
+    scenario.shape = shape;
+    scenario.start_time = micros();
+}
+
+void reset(int channel_index) {
+    Scenario &scenario = g_scenarios[channel_index];
+    scenario.mode = MODE_RESISTANCE;
+    start(scenario, SHAPE_CONSTANT);
+}
+
+void setMode(int channel_index, Mode mode) {
+    g_scenarios[channel_index].mode = mode;
+}
+
+Mode getMode(int channel_index) {
+    return g_scenarios[channel_index].mode;
+}
+
+Shape getShape(int channel_index) {
+    return g_scenarios[channel_index].shape;
+}
+
+static float getTableLevel(const Scenario &scenario, float t) {
+    if (scenario.table_count == 0) {
+        return 0;
+    }
+
+    if (t <= scenario.table[0].time) {
+        return scenario.table[0].level;
+    }
+
+    for (int i = 1; i < scenario.table_count; ++i) {
+        const TablePoint &a = scenario.table[i - 1];
+        const TablePoint &b = scenario.table[i];
+        if (t < b.time) {
+            return a.level + (b.level - a.level) * (t - a.time) / (b.time - a.time);
+        }
+    }
+
+    return scenario.table[scenario.table_count - 1].level;
+}
+
+float getLevel(int channel_index) {
+    Scenario &scenario = g_scenarios[channel_index];
+
+    if (scenario.shape == SHAPE_CONSTANT && scenario.mode == MODE_RESISTANCE) {
+        return Channel::get(channel_index).simulator.getLoad();
+    }
+
+    float t = (micros() - scenario.start_time) / 1000000.0f;
+
+    switch (scenario.shape) {
+    case SHAPE_STEP:
+        return t < scenario.time1 ? scenario.from : scenario.to;
+
+    case SHAPE_RAMP:
+        if (t >= scenario.time1) {
+            return scenario.to;
+        }
+        return scenario.from + (scenario.to - scenario.from) * t / scenario.time1;
+
+    case SHAPE_PULSE:
+        return fmodf(t, scenario.time1) < scenario.time2 ? scenario.to : scenario.from;
+
+    case SHAPE_TABLE:
+        return getTableLevel(scenario, t);
+
+    default:
+        return scenario.from;
+    }
+}
+
+void setConstant(int channel_index, float level) {
+    Scenario &scenario = g_scenarios[channel_index];
+    if (scenario.mode == MODE_RESISTANCE) {
+        // constant resistance is the SIMU:LOAD value, used by getLevel
+        Channel::get(channel_index).simulator.setLoad(level);
+    }
+    scenario.from = level;
+    scenario.to = level;
+    start(scenario, SHAPE_CONSTANT);
+}
+
+void setStep(int channel_index, float from, float to, float delay) {
+    Scenario &scenario = g_scenarios[channel_index];
+    scenario.from = from;
+    scenario.to = to;
+    scenario.time1 = delay;
+    start(scenario, SHAPE_STEP);
+}
+
+void setRamp(int channel_index, float from, float to, float duration) {
+    Scenario &scenario = g_scenarios[channel_index];
+    scenario.from = from;
+    scenario.to = to;
+    scenario.time1 = duration;
+    start(scenario, SHAPE_RAMP);
+}
+
+void setPulse(int channel_index, float base, float pulse, float period, float width) {
+    Scenario &scenario = g_scenarios[channel_index];
+    scenario.from = base;
+    scenario.to = pulse;
+    scenario.time1 = period;
+    scenario.time2 = width;
+    start(scenario, SHAPE_PULSE);
+}
+
+bool loadTable(int channel_index, const char *file_path) {
+    FILE *fp = fopen(file_path, "r");
+    if (!fp) {
+        return false;
+    }
+
+    Scenario &scenario = g_scenarios[channel_index];
+    int count = 0;
+    bool result = true;
+
+    char line[128];
+    while (fgets(line, sizeof(line), fp)) {
+        float time, level;
+        if (line[0] == '#' || sscanf(line, "%f , %f", &time, &level) != 2) {
+            continue;
+        }
+
+        // time must be increasing
+        if (count == LOAD_TABLE_SIZE || time < 0 || level < 0 || (count > 0 && time <= scenario.table[count - 1].time)) {
+            result = false;
+            break;
+        }
+
+        scenario.table[count].time = time;
+        scenario.table[count].level = level;
+        ++count;
+    }
+
+    fclose(fp);
+
+    if (!result || count == 0) {
+        return false;
+    }
+
+    scenario.table_count = count;
+    start(scenario, SHAPE_TABLE);
+
+    return true;
+}
+
+void restart(int channel_index) {
+    g_scenarios[channel_index].start_time = micros();
+}
+
+void setCapacitance(int channel_index, float capacitance) {
+    g_scenarios[channel_index].capacitance = capacitance;
+}
+
+float getCapacitance(int channel_index) {
+    return g_scenarios[channel_index].capacitance;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+/// Current drawn by the load at the given voltage.
+static float getLoadCurrent(Mode mode, float level, float u) {
+    if (u <= 0) {
+        return 0;
+    }
+
+    if (mode == MODE_RESISTANCE) {
+        return level > 0 ? u / level : INFINITY;
+    }
+
+    if (mode == MODE_CURRENT) {
+        return level;
+    }
+
+    return level / u;
+}
+
+/// Operating point without the capacitance.
+static void calculateSteadyState(Mode mode, float level, float u_set, float i_set, float &u, float &i, bool &cc) {
+    float i_load = getLoadCurrent(mode, level, u_set);
+    if (i_load <= i_set) {
+        u = u_set;
+        i = i_load;
+        cc = false;
+    } else {
+        // resistance is the only load that settles at the lower voltage,
+        // current and power sinks pull the output down
+        u = mode == MODE_RESISTANCE ? i_set * level : 0;
+        i = i_set;
+        cc = true;
+    }
+}
+
+void calculate(int channel_index, bool output_enabled, float u_set, float i_set, float &u_mon, float &i_mon, bool &cv, bool &cc) {
+    Scenario &scenario = g_scenarios[channel_index];
+
+    uint32_t now = micros();
+    float dt = (now - scenario.last_time) / 1000000.0f;
+    scenario.last_time = now;
+    if (dt > CAPACITOR_MAX_TIME) {
+        dt = CAPACITOR_MAX_TIME;
+    }
+
+    Mode mode = scenario.mode;
+    float level = getLevel(channel_index);
+
+    float u_ss, i_ss;
+    bool cc_ss;
+    calculateSteadyState(mode, level, u_set, i_set, u_ss, i_ss, cc_ss);
+
+    if (!output_enabled || scenario.capacitance <= 0 || scenario.u_cap == u_ss) {
+        scenario.u_cap = output_enabled ? u_ss : 0;
+        u_mon = u_ss;
+        i_mon = i_ss;
+        cv = !cc_ss;
+        cc = cc_ss;
+        return;
+    }
+
+    // Capacitor is charged with the current limit below the steady state voltage.
+    // Above it, it is discharged by the load, while the output supplies the current
+    // limit in CC or nothing in CV, as the output can't sink current.
+    float u = scenario.u_cap;
+    bool charging = u < u_ss;
+    float i_source = charging || cc_ss ? i_set : 0;
+
+    while (dt > 0) {
+        float step = dt < CAPACITOR_STEP ? dt : CAPACITOR_STEP;
+        dt -= step;
+
+        u += (i_source - getLoadCurrent(mode, level, u)) * step / scenario.capacitance;
+
+        if (charging ? u >= u_ss : u <= u_ss) {
+            u = u_ss;
+            break;
+        }
+    }
+
+    if (u < 0) {
+        u = 0;
+    }
+    scenario.u_cap = u;
+
+    if (u == u_ss) {
+        u_mon = u_ss;
+        i_mon = i_ss;
+        cv = !cc_ss;
+        cc = cc_ss;
+    } else {
+        u_mon = u;
+        i_mon = i_source;
+        cv = false;
+        cc = i_source > 0;
+    }
+}
+
+}
+}
+}
+} // namespace eez::psu::simulator::load
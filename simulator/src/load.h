@@ -0,0 +1,78 @@
+/*
+ * EEZ PSU Firmware
+ * Copyright (C) 2015-present, Envox d.o.o.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+ 
+#pragma once
+
+namespace eez {
+namespace psu {
+namespace simulator {
+/// Electronic load connected to the channel output when SIMU:LOAD:STATe is ON.
+///
+/// Load level is interpreted as resistance, sink current or power, and can change
+/// in time by the scenario: constant, step, ramp, pulse train or time series from
+/// the CSV file. Optional capacitance in parallel with the load is charged from the
+/// output, so the inrush current and CC to CV transitions are simulated as well.
+/// Time is measured with micros() from the moment the scenario is set.
+namespace load {
+
+enum Mode {
+    MODE_RESISTANCE,
+    MODE_CURRENT,
+    MODE_POWER
+};
+
+enum Shape {
+    SHAPE_CONSTANT,
+    SHAPE_STEP,
+    SHAPE_RAMP,
+    SHAPE_PULSE,
+    SHAPE_TABLE
+};
+
+/// Back to the constant resistance given with Channel::Simulator::setLoad.
+void reset(int channel_index);
+
+void setMode(int channel_index, Mode mode);
+Mode getMode(int channel_index);
+Shape getShape(int channel_index);
+
+/// Level at the current time.
+float getLevel(int channel_index);
+
+void setConstant(int channel_index, float level);
+void setStep(int channel_index, float from, float to, float delay);
+void setRamp(int channel_index, float from, float to, float duration);
+void setPulse(int channel_index, float base, float pulse, float period, float width);
+/// Load "<time in seconds>,<level>" lines, levels are linearly interpolated
+/// and the last one is held.
+bool loadTable(int channel_index, const char *file_path);
+
+/// Start the scenario from the beginning.
+void restart(int channel_index);
+
+void setCapacitance(int channel_index, float capacitance);
+float getCapacitance(int channel_index);
+
+/// Calculate output voltage and current, and the regulation mode, for the
+/// programmed voltage and current limit of the channel.
+void calculate(int channel_index, bool output_enabled, float u_set, float i_set, float &u_mon, float &i_mon, bool &cv, bool &cc);
+
+}
+}
+}
+} // namespace eez::psu::simulator::load
@@ -18,18 +18,58 @@
 
 #include "psu.h"
 #include "main_loop.h"
+#include "script_runner.h"
 #if OPTION_DISPLAY
 #include "front_panel/control.h"
 #endif
 
 using namespace eez::psu;
 
-int main() {
+static void usage() {
+    printf("Usage: eez_psu_sim [--script <file> [--repeat <n>] [--record]] [--sweep]\n");
+}
+
+int main(int argc, char **argv) {
+    const char *script = 0;
+    int repeat = 1;
+    bool record = false;
+    bool sweep = false;
+
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--script") == 0 && i + 1 < argc) {
+            script = argv[++i];
+        } else if (strcmp(argv[i], "--repeat") == 0 && i + 1 < argc) {
+            repeat = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--record") == 0) {
+            record = true;
+        } else if (strcmp(argv[i], "--sweep") == 0) {
+            sweep = true;
+        } else {
+            usage();
+            return 2;
+        }
+    }
+
     simulator::init();
     boot();
-	main_loop();
+
+    int result = 0;
+    if (script || sweep) {
+        // headless run, no stdin input
+        int failed = 0;
+        if (script) {
+            failed += simulator::script_runner::runScript(script, repeat, record);
+        }
+        if (sweep) {
+            failed += simulator::script_runner::runSweep();
+        }
+        result = failed > 0 ? 1 : 0;
+    } else {
+        main_loop();
+    }
+
 #if OPTION_DISPLAY
     simulator::front_panel::close();
 #endif
-    return 0;
+    return result;
 }
@@ -22,7 +22,11 @@
 
 #include "simulator_psu.h"
 #include "chips.h"
+#include "load.h"
+#include "arduino_internal.h"
+#include "gui.h"
 #if OPTION_DISPLAY
+#include "lcd.h"
 #include "front_panel/control.h"
 #endif
 
@@ -69,6 +73,31 @@ bool get_resistance_from_param(scpi_t *context, const scpi_number_t &param, floa
     return true;
 }
 
+static scpi_choice_def_t load_mode_choice[] = {
+    { "RESistance", load::MODE_RESISTANCE },
+    { "CURRent", load::MODE_CURRENT },
+    { "POWer", load::MODE_POWER },
+    SCPI_CHOICE_LIST_END /* termination of option list */
+};
+
+/// Load level in ohms, amperes or watts, depending on the load mode.
+static bool get_load_level_param(scpi_t *context, float &value) {
+    if (!SCPI_ParamFloat(context, &value, TRUE)) {
+        return false;
+    }
+
+    if (value < 0 || value > SIM_LOAD_MAX) {
+        SCPI_ErrorPush(context, SCPI_ERROR_DATA_OUT_OF_RANGE);
+        return false;
+    }
+
+    return true;
+}
+
+static bool get_load_time_param(scpi_t *context, float &value, float min) {
+    return get_duration_param(context, value, min, SIM_LOAD_TIME_MAX, min);
+}
+
 static bool get_resistance_param(scpi_t *context, float &value) {
     scpi_number_t param;
     if (!SCPI_ParamNumber(context, scpi_special_numbers_def, &param, true)) {
@@ -78,6 +107,24 @@ static bool get_resistance_param(scpi_t *context, float &value) {
     return get_resistance_from_param(context, param, value);
 }
 
+static bool get_file_path_param(scpi_t *context, char *file_path, size_t file_path_size) {
+    const char *param;
+    size_t len;
+    if (!SCPI_ParamCharacters(context, &param, &len, true)) {
+        return false;
+    }
+
+    if (len >= file_path_size) {
+        SCPI_ErrorPush(context, SCPI_ERROR_CHARACTER_DATA_TOO_LONG);
+        return false;
+    }
+
+    strncpy(file_path, param, len);
+    file_path[len] = 0;
+
+    return true;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 scpi_result_t scpi_simu_LoadState(scpi_t *context) {
@@ -119,6 +166,7 @@ scpi_result_t scpi_simu_Load(scpi_t *context) {
     }
 
     channel->simulator.setLoad(value);
+    load::reset(channel->index - 1);
 
     return SCPI_RES_OK;
 }
@@ -158,6 +206,178 @@ scpi_result_t scpi_simu_LoadQ(scpi_t *context) {
     return result_float(context, value);
 }
 
+scpi_result_t scpi_simu_LoadMode(scpi_t *context) {
+    int32_t mode;
+    if (!SCPI_ParamChoice(context, load_mode_choice, &mode, TRUE)) {
+        return SCPI_RES_ERR;
+    }
+
+    Channel *channel = param_channel(context, FALSE, TRUE);
+    if (!channel) {
+        return SCPI_RES_ERR;
+    }
+
+    load::setMode(channel->index - 1, (load::Mode)mode);
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_simu_LoadModeQ(scpi_t *context) {
+    Channel *channel = param_channel(context, FALSE, TRUE);
+    if (!channel) {
+        return SCPI_RES_ERR;
+    }
+
+    const char *text;
+    SCPI_ChoiceToName(load_mode_choice, load::getMode(channel->index - 1), &text);
+    SCPI_ResultMnemonic(context, text);
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_simu_LoadLevel(scpi_t *context) {
+    float level;
+    if (!get_load_level_param(context, level)) {
+        return SCPI_RES_ERR;
+    }
+
+    Channel *channel = param_channel(context, FALSE, TRUE);
+    if (!channel) {
+        return SCPI_RES_ERR;
+    }
+
+    load::setConstant(channel->index - 1, level);
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_simu_LoadLevelQ(scpi_t *context) {
+    Channel *channel = param_channel(context, FALSE, TRUE);
+    if (!channel) {
+        return SCPI_RES_ERR;
+    }
+
+    return result_float(context, load::getLevel(channel->index - 1));
+}
+
+scpi_result_t scpi_simu_LoadStep(scpi_t *context) {
+    // <level before>,<level after>,<delay>
+    float from, to, delay;
+    if (!get_load_level_param(context, from) || !get_load_level_param(context, to) || !get_load_time_param(context, delay, 0)) {
+        return SCPI_RES_ERR;
+    }
+
+    Channel *channel = param_channel(context, FALSE, TRUE);
+    if (!channel) {
+        return SCPI_RES_ERR;
+    }
+
+    load::setStep(channel->index - 1, from, to, delay);
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_simu_LoadRamp(scpi_t *context) {
+    // <start level>,<end level>,<duration>
+    float from, to, duration;
+    if (!get_load_level_param(context, from) || !get_load_level_param(context, to) || !get_load_time_param(context, duration, SIM_LOAD_TIME_MIN)) {
+        return SCPI_RES_ERR;
+    }
+
+    Channel *channel = param_channel(context, FALSE, TRUE);
+    if (!channel) {
+        return SCPI_RES_ERR;
+    }
+
+    load::setRamp(channel->index - 1, from, to, duration);
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_simu_LoadPulse(scpi_t *context) {
+    // <base level>,<pulse level>,<period>,<pulse width>
+    float base, pulse, period, width;
+    if (!get_load_level_param(context, base) || !get_load_level_param(context, pulse) ||
+        !get_load_time_param(context, period, SIM_LOAD_TIME_MIN) || !get_load_time_param(context, width, 0))
+    {
+        return SCPI_RES_ERR;
+    }
+
+    if (width > period) {
+        SCPI_ErrorPush(context, SCPI_ERROR_DATA_OUT_OF_RANGE);
+        return SCPI_RES_ERR;
+    }
+
+    Channel *channel = param_channel(context, FALSE, TRUE);
+    if (!channel) {
+        return SCPI_RES_ERR;
+    }
+
+    load::setPulse(channel->index - 1, base, pulse, period, width);
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_simu_LoadTable(scpi_t *context) {
+    char file_path[256];
+    if (!get_file_path_param(context, file_path, sizeof(file_path))) {
+        return SCPI_RES_ERR;
+    }
+
+    Channel *channel = param_channel(context, FALSE, TRUE);
+    if (!channel) {
+        return SCPI_RES_ERR;
+    }
+
+    if (!load::loadTable(channel->index - 1, file_path)) {
+        SCPI_ErrorPush(context, SCPI_ERROR_EXECUTION_ERROR);
+        return SCPI_RES_ERR;
+    }
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_simu_LoadRestart(scpi_t *context) {
+    Channel *channel = param_channel(context, FALSE, TRUE);
+    if (!channel) {
+        return SCPI_RES_ERR;
+    }
+
+    load::restart(channel->index - 1);
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_simu_LoadCapacitance(scpi_t *context) {
+    float capacitance;
+    if (!SCPI_ParamFloat(context, &capacitance, TRUE)) {
+        return SCPI_RES_ERR;
+    }
+
+    if (capacitance < 0 || capacitance > SIM_LOAD_CAPACITANCE_MAX) {
+        SCPI_ErrorPush(context, SCPI_ERROR_DATA_OUT_OF_RANGE);
+        return SCPI_RES_ERR;
+    }
+
+    Channel *channel = param_channel(context, FALSE, TRUE);
+    if (!channel) {
+        return SCPI_RES_ERR;
+    }
+
+    load::setCapacitance(channel->index - 1, capacitance);
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_simu_LoadCapacitanceQ(scpi_t *context) {
+    Channel *channel = param_channel(context, FALSE, TRUE);
+    if (!channel) {
+        return SCPI_RES_ERR;
+    }
+
+    return result_float(context, load::getCapacitance(channel->index - 1));
+}
+
 scpi_result_t scpi_simu_VoltageProgramExternal(scpi_t *context) {
 	float value;
 	if (!get_voltage_param(context, value, 0, 0)) {
@@ -308,6 +528,251 @@ scpi_result_t scpi_simu_TemperatureQ(scpi_t *context) {
     return result_float(context, value);
 }
 
+scpi_result_t scpi_simu_DacStatisticsQ(scpi_t *context) {
+    Channel *channel = param_channel(context, FALSE, TRUE);
+    if (!channel) {
+        return SCPI_RES_ERR;
+    }
+
+    chips::DigitalAnalogConverterChip::WriteStatistics &stats = chips::DigitalAnalogConverterChip::getWriteStatistics(channel->dac_pin);
+
+    SCPI_ResultInt(context, stats.num_writes);
+    SCPI_ResultInt(context, stats.min_interval);
+    SCPI_ResultInt(context, stats.max_interval);
+    SCPI_ResultInt(context, stats.last_value);
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_simu_DacStatisticsReset(scpi_t *context) {
+    Channel *channel = param_channel(context, FALSE, TRUE);
+    if (!channel) {
+        return SCPI_RES_ERR;
+    }
+
+    chips::DigitalAnalogConverterChip::resetWriteStatistics(channel->dac_pin);
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_simu_DacHistoryQ(scpi_t *context) {
+    Channel *channel = param_channel(context, FALSE, TRUE);
+    if (!channel) {
+        return SCPI_RES_ERR;
+    }
+
+    // <time since the first write in us>,<0 for voltage or 1 for current>,<DAC code>,...
+    int count;
+    const chips::DigitalAnalogConverterChip::HistoryEntry *history = chips::DigitalAnalogConverterChip::getHistory(channel->dac_pin, count);
+    for (int i = 0; i < count; ++i) {
+        SCPI_ResultInt(context, history[i].time - history[0].time);
+        SCPI_ResultInt(context, history[i].buffer == DigitalAnalogConverter::DATA_BUFFER_A ? 0 : 1);
+        SCPI_ResultInt(context, history[i].value);
+    }
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_simu_DacHistoryClear(scpi_t *context) {
+    Channel *channel = param_channel(context, FALSE, TRUE);
+    if (!channel) {
+        return SCPI_RES_ERR;
+    }
+
+    chips::DigitalAnalogConverterChip::clearHistory(channel->dac_pin);
+
+    return SCPI_RES_OK;
+}
+
+/// Get count of injected faults, followed by the optional channel.
+static Channel *get_fault_count_param(scpi_t *context, uint16_t &count) {
+    int32_t value;
+    if (!SCPI_ParamInt(context, &value, TRUE)) {
+        return 0;
+    }
+
+    if (value < 0 || value > 65535) {
+        SCPI_ErrorPush(context, SCPI_ERROR_DATA_OUT_OF_RANGE);
+        return 0;
+    }
+
+    Channel *channel = param_channel(context, FALSE, TRUE);
+    if (channel) {
+        count = (uint16_t)value;
+    }
+    return channel;
+}
+
+scpi_result_t scpi_simu_AdcNoise(scpi_t *context) {
+    uint16_t noise;
+    Channel *channel = get_fault_count_param(context, noise);
+    if (!channel) {
+        return SCPI_RES_ERR;
+    }
+
+    chips::AnalogDigitalConverterChip::getFaults(channel->adc_pin).noise = noise;
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_simu_AdcNoiseQ(scpi_t *context) {
+    Channel *channel = param_channel(context, FALSE, TRUE);
+    if (!channel) {
+        return SCPI_RES_ERR;
+    }
+
+    SCPI_ResultInt(context, chips::AnalogDigitalConverterChip::getFaults(channel->adc_pin).noise);
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_simu_AdcDrop(scpi_t *context) {
+    // lose DRDY interrupt of the next <count> conversions
+    uint16_t count;
+    Channel *channel = get_fault_count_param(context, count);
+    if (!channel) {
+        return SCPI_RES_ERR;
+    }
+
+    chips::AnalogDigitalConverterChip::getFaults(channel->adc_pin).missed_interrupts = count;
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_simu_AdcGlitch(scpi_t *context) {
+    // flip one bit in the next <count> conversion data reads
+    uint16_t count;
+    Channel *channel = get_fault_count_param(context, count);
+    if (!channel) {
+        return SCPI_RES_ERR;
+    }
+
+    chips::AnalogDigitalConverterChip::getFaults(channel->adc_pin).glitches = count;
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_simu_AdcStatisticsQ(scpi_t *context) {
+    Channel *channel = param_channel(context, FALSE, TRUE);
+    if (!channel) {
+        return SCPI_RES_ERR;
+    }
+
+    // <conversions>,<missed interrupts>,<glitches>,<max DRDY latency in us>,<average DRDY latency in us>
+    chips::AnalogDigitalConverterChip::Statistics &stats = chips::AnalogDigitalConverterChip::getStatistics(channel->adc_pin);
+    SCPI_ResultInt(context, stats.conversions);
+    SCPI_ResultInt(context, stats.missed_interrupts);
+    SCPI_ResultInt(context, stats.glitches);
+    SCPI_ResultInt(context, stats.max_latency);
+    SCPI_ResultInt(context, stats.num_latencies > 0 ? stats.total_latency / stats.num_latencies : 0);
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_simu_AdcStatisticsReset(scpi_t *context) {
+    Channel *channel = param_channel(context, FALSE, TRUE);
+    if (!channel) {
+        return SCPI_RES_ERR;
+    }
+
+    chips::AnalogDigitalConverterChip::resetStatistics(channel->adc_pin);
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_simu_AudioLogQ(scpi_t *context) {
+    // <time since the first note in ms>,<frequency>,<duration in ms>,<priority>,...
+    int count;
+    const simulator::AudioEvent *log = simulator::getAudioLog(count);
+    for (int i = 0; i < count; ++i) {
+        SCPI_ResultInt(context, log[i].time - log[0].time);
+        SCPI_ResultInt(context, log[i].frequency);
+        SCPI_ResultInt(context, log[i].duration);
+        SCPI_ResultInt(context, log[i].priority);
+    }
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_simu_AudioLogClear(scpi_t *context) {
+    simulator::clearAudioLog();
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_simu_TouchTrace(scpi_t *context) {
+    char file_path[256];
+    if (!get_file_path_param(context, file_path, sizeof(file_path))) {
+        return SCPI_RES_ERR;
+    }
+
+    if (!simulator::playTouchTrace(file_path)) {
+        SCPI_ErrorPush(context, SCPI_ERROR_EXECUTION_ERROR);
+        return SCPI_RES_ERR;
+    }
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_simu_TouchTraceQ(scpi_t *context) {
+    SCPI_ResultBool(context, simulator::isTouchTracePlaying());
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_simu_TouchRecord(scpi_t *context) {
+    char file_path[256];
+    if (!get_file_path_param(context, file_path, sizeof(file_path))) {
+        return SCPI_RES_ERR;
+    }
+
+    if (!simulator::startTouchRecording(file_path)) {
+        SCPI_ErrorPush(context, SCPI_ERROR_EXECUTION_ERROR);
+        return SCPI_RES_ERR;
+    }
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_simu_TouchRecordStop(scpi_t *context) {
+    simulator::stopTouchRecording();
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_simu_TouchStatisticsQ(scpi_t *context) {
+#if OPTION_DISPLAY
+    // <samples>,<applied moves>,<coalesced moves>,<max latency in us>,<average latency in us>
+    gui::TouchStatistics &stats = gui::getTouchStatistics();
+    SCPI_ResultInt(context, stats.samples);
+    SCPI_ResultInt(context, stats.moves);
+    SCPI_ResultInt(context, stats.coalesced);
+    SCPI_ResultInt(context, stats.max_latency);
+    SCPI_ResultInt(context, stats.num_latencies > 0 ? stats.total_latency / stats.num_latencies : 0);
+
+    return SCPI_RES_OK;
+#else
+    SCPI_ErrorPush(context, SCPI_ERROR_EXECUTION_ERROR);
+    return SCPI_RES_ERR;
+#endif
+}
+
+scpi_result_t scpi_simu_TouchStatisticsReset(scpi_t *context) {
+#if OPTION_DISPLAY
+    gui::resetTouchStatistics();
+#endif
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_simu_Trigger(scpi_t *context) {
+    // pulse on the external trigger input
+    arduino::setInputPin(EXT_TRIG, HIGH);
+    arduino::setInputPin(EXT_TRIG, LOW);
+
+    return SCPI_RES_OK;
+}
+
 scpi_result_t scpi_simu_GUI(scpi_t *context) {
 #if OPTION_DISPLAY
     if (!simulator::front_panel::open()) {
@@ -322,6 +787,80 @@ scpi_result_t scpi_simu_GUI(scpi_t *context) {
 #endif
 }
 
+scpi_result_t scpi_simu_GUIHeadless(scpi_t *context) {
+    bool enable;
+    if (!SCPI_ParamBool(context, &enable, TRUE)) {
+        return SCPI_RES_ERR;
+    }
+
+    simulator::setGuiHeadless(enable);
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_simu_GUIHeadlessQ(scpi_t *context) {
+    SCPI_ResultBool(context, simulator::isGuiHeadless());
+
+    return SCPI_RES_OK;
+}
+
+scpi_result_t scpi_simu_GUICapture(scpi_t *context) {
+#if OPTION_DISPLAY
+    char file_path[256];
+    if (!get_file_path_param(context, file_path, sizeof(file_path))) {
+        return SCPI_RES_ERR;
+    }
+
+    if (!simulator::saveFramebuffer(file_path)) {
+        SCPI_ErrorPush(context, SCPI_ERROR_EXECUTION_ERROR);
+        return SCPI_RES_ERR;
+    }
+
+    return SCPI_RES_OK;
+#else
+    SCPI_ErrorPush(context, SCPI_ERROR_EXECUTION_ERROR);
+    return SCPI_RES_ERR;
+#endif
+}
+
+scpi_result_t scpi_simu_GUICaptureQ(scpi_t *context) {
+#if OPTION_DISPLAY
+    // RGB565 pixels as stored in the framebuffer, row by row
+    size_t len = gui::lcd::lcd.getDisplayXSize() * gui::lcd::lcd.getDisplayYSize() * sizeof(word);
+    SCPI_ResultArbitraryBlock(context, gui::lcd::lcd.buffer, len);
+
+    return SCPI_RES_OK;
+#else
+    SCPI_ErrorPush(context, SCPI_ERROR_EXECUTION_ERROR);
+    return SCPI_RES_ERR;
+#endif
+}
+
+scpi_result_t scpi_simu_GUIStatisticsQ(scpi_t *context) {
+#if OPTION_DISPLAY
+    // <frames>,<pixels in the last frame>,<max pixels per frame>,<average pixels per frame>,<total pixels>
+    gui::FrameStatistics &stats = gui::getFrameStatistics();
+    SCPI_ResultInt(context, stats.frames);
+    SCPI_ResultInt(context, stats.last_pixels);
+    SCPI_ResultInt(context, stats.max_pixels);
+    SCPI_ResultInt(context, stats.frames > 0 ? stats.total_pixels / stats.frames : 0);
+    SCPI_ResultInt(context, stats.total_pixels);
+
+    return SCPI_RES_OK;
+#else
+    SCPI_ErrorPush(context, SCPI_ERROR_EXECUTION_ERROR);
+    return SCPI_RES_ERR;
+#endif
+}
+
+scpi_result_t scpi_simu_GUIStatisticsReset(scpi_t *context) {
+#if OPTION_DISPLAY
+    gui::resetFrameStatistics();
+#endif
+
+    return SCPI_RES_OK;
+}
+
 scpi_result_t scpi_simu_Exit(scpi_t *context) {
     simulator::exit();
 
@@ -23,6 +23,17 @@
     SCPI_COMMAND("SIMUlator:LOAD:STATe?", scpi_simu_LoadStateQ) \
     SCPI_COMMAND("SIMUlator:LOAD", scpi_simu_Load) \
     SCPI_COMMAND("SIMUlator:LOAD?", scpi_simu_LoadQ) \
+    SCPI_COMMAND("SIMUlator:LOAD:MODE", scpi_simu_LoadMode) \
+    SCPI_COMMAND("SIMUlator:LOAD:MODE?", scpi_simu_LoadModeQ) \
+    SCPI_COMMAND("SIMUlator:LOAD:LEVel", scpi_simu_LoadLevel) \
+    SCPI_COMMAND("SIMUlator:LOAD:LEVel?", scpi_simu_LoadLevelQ) \
+    SCPI_COMMAND("SIMUlator:LOAD:STEP", scpi_simu_LoadStep) \
+    SCPI_COMMAND("SIMUlator:LOAD:RAMP", scpi_simu_LoadRamp) \
+    SCPI_COMMAND("SIMUlator:LOAD:PULSe", scpi_simu_LoadPulse) \
+    SCPI_COMMAND("SIMUlator:LOAD:TABLe", scpi_simu_LoadTable) \
+    SCPI_COMMAND("SIMUlator:LOAD:RESTart", scpi_simu_LoadRestart) \
+    SCPI_COMMAND("SIMUlator:LOAD:CAPacitance", scpi_simu_LoadCapacitance) \
+    SCPI_COMMAND("SIMUlator:LOAD:CAPacitance?", scpi_simu_LoadCapacitanceQ) \
     SCPI_COMMAND("SIMUlator:VOLTage:PROGram:EXTernal", scpi_simu_VoltageProgramExternal) \
 	SCPI_COMMAND("SIMUlator:VOLTage:PROGram:EXTernal?", scpi_simu_VoltageProgramExternalQ) \
     SCPI_COMMAND("SIMUlator:LOAD?", scpi_simu_LoadQ) \
@@ -32,7 +43,32 @@
     SCPI_COMMAND("SIMUlator:RPOL?", scpi_simu_RPolQ) \
     SCPI_COMMAND("SIMUlator:TEMPerature", scpi_simu_Temperature) \
     SCPI_COMMAND("SIMUlator:TEMPerature?", scpi_simu_TemperatureQ) \
+    SCPI_COMMAND("SIMUlator:DAC:STATistics?", scpi_simu_DacStatisticsQ) \
+    SCPI_COMMAND("SIMUlator:DAC:STATistics:RESet", scpi_simu_DacStatisticsReset) \
+    SCPI_COMMAND("SIMUlator:DAC:HISTory?", scpi_simu_DacHistoryQ) \
+    SCPI_COMMAND("SIMUlator:DAC:HISTory:CLEar", scpi_simu_DacHistoryClear) \
+    SCPI_COMMAND("SIMUlator:ADC:NOISe", scpi_simu_AdcNoise) \
+    SCPI_COMMAND("SIMUlator:ADC:NOISe?", scpi_simu_AdcNoiseQ) \
+    SCPI_COMMAND("SIMUlator:ADC:DROP", scpi_simu_AdcDrop) \
+    SCPI_COMMAND("SIMUlator:ADC:GLITch", scpi_simu_AdcGlitch) \
+    SCPI_COMMAND("SIMUlator:ADC:STATistics?", scpi_simu_AdcStatisticsQ) \
+    SCPI_COMMAND("SIMUlator:ADC:STATistics:RESet", scpi_simu_AdcStatisticsReset) \
+    SCPI_COMMAND("SIMUlator:AUDio:LOG?", scpi_simu_AudioLogQ) \
+    SCPI_COMMAND("SIMUlator:AUDio:LOG:CLEar", scpi_simu_AudioLogClear) \
+    SCPI_COMMAND("SIMUlator:TOUCh:TRACe", scpi_simu_TouchTrace) \
+    SCPI_COMMAND("SIMUlator:TOUCh:TRACe?", scpi_simu_TouchTraceQ) \
+    SCPI_COMMAND("SIMUlator:TOUCh:RECord", scpi_simu_TouchRecord) \
+    SCPI_COMMAND("SIMUlator:TOUCh:RECord:STOP", scpi_simu_TouchRecordStop) \
+    SCPI_COMMAND("SIMUlator:TOUCh:STATistics?", scpi_simu_TouchStatisticsQ) \
+    SCPI_COMMAND("SIMUlator:TOUCh:STATistics:RESet", scpi_simu_TouchStatisticsReset) \
+    SCPI_COMMAND("SIMUlator:TRIGger", scpi_simu_Trigger) \
     SCPI_COMMAND("SIMUlator:GUI", scpi_simu_GUI) \
+    SCPI_COMMAND("SIMUlator:GUI:HEADless", scpi_simu_GUIHeadless) \
+    SCPI_COMMAND("SIMUlator:GUI:HEADless?", scpi_simu_GUIHeadlessQ) \
+    SCPI_COMMAND("SIMUlator:GUI:CAPTure", scpi_simu_GUICapture) \
+    SCPI_COMMAND("SIMUlator:GUI:CAPTure?", scpi_simu_GUICaptureQ) \
+    SCPI_COMMAND("SIMUlator:GUI:STATistics?", scpi_simu_GUIStatisticsQ) \
+    SCPI_COMMAND("SIMUlator:GUI:STATistics:RESet", scpi_simu_GUIStatisticsReset) \
     SCPI_COMMAND("SIMUlator:EXIT", scpi_simu_Exit) \
     SCPI_COMMAND("SIMUlator:QUIT", scpi_simu_Exit) \
 
@@ -0,0 +1,431 @@
+/*
+ * EEZ PSU Firmware
+ * Copyright (C) 2015-present, Envox d.o.o.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+ 
+#include "psu.h"
+#include "serial_psu.h"
+#include "scpi_psu.h"
+#include "long_operation.h"
+#include "main_loop.h"
+#include "script_runner.h"
+#if OPTION_DISPLAY
+#include "gui.h"
+#include "lcd.h"
+#endif
+
+#include <string>
+#include <vector>
+
+namespace eez {
+namespace psu {
+namespace simulator {
+namespace script_runner {
+
+/// Argument no command accepts, used to test error handling of every command.
+#define INVALID_ARGUMENT " 9.9E37"
+
+/// Patterns skipped by the sweep, because they exit the simulator, wait for
+/// the time given in argument, write files or destroy the saved profiles.
+static const char *g_sweepSkip[] = {
+    "DEBUG",
+    "SIMUlator:EXIT",
+    "SIMUlator:QUIT",
+    "SIMUlator:GUI",
+    "SIMUlator:GUI:CAPTure",
+    "SIMUlator:TOUCh:RECord",
+    "MEMory:STATe:DELete:ALL",
+    0
+};
+
+static std::string g_output;
+static std::vector<std::string> g_responses;
+static size_t g_nextResponse;
+
+static uint32_t g_numCommands;
+static uint64_t g_totalCommandTime;
+static uint32_t g_maxCommandTime;
+static uint32_t g_maxTickTime;
+
+// touch state set by %touch and %release, written on every tick as the front panel does
+static bool g_touchPressed;
+static int g_touchX = -1;
+static int g_touchY = -1;
+
+static void resetStatistics() {
+    g_numCommands = 0;
+    g_totalCommandTime = 0;
+    g_maxCommandTime = 0;
+    g_maxTickTime = 0;
+}
+
+/// Throughput is calculated from the time spent in commands, %wait is not included.
+static void printStatistics(const char *name) {
+    printf("%s: %u commands, %.0f commands/s, worst command %u us, worst loop %u us\n",
+        name, (unsigned)g_numCommands,
+        g_totalCommandTime > 0 ? g_numCommands * 1000000.0 / g_totalCommandTime : 0.0,
+        (unsigned)g_maxCommandTime, (unsigned)g_maxTickTime);
+}
+
+static void tickMeasured() {
+    uint32_t start = micros();
+    simulator::tick();
+    uint32_t duration = micros() - start;
+    if (duration > g_maxTickTime) {
+        g_maxTickTime = duration;
+    }
+}
+
+/// Split captured output to response lines, **SRQ and similar notices are skipped.
+static void collectResponses() {
+    g_responses.clear();
+    g_nextResponse = 0;
+
+    size_t pos = 0;
+    while (pos < g_output.size()) {
+        size_t end = g_output.find('\n', pos);
+        if (end == std::string::npos) {
+            end = g_output.size();
+        }
+
+        std::string line = g_output.substr(pos, end - pos);
+        while (!line.empty() && (line[line.size() - 1] == '\r' || line[line.size() - 1] == ' ')) {
+            line.erase(line.size() - 1);
+        }
+
+        if (!line.empty() && line.compare(0, 2, "**") != 0) {
+            g_responses.push_back(line);
+        }
+
+        pos = end + 1;
+    }
+
+    g_output.clear();
+}
+
+static void sendCommand(const char *command) {
+    Serial.capture(&g_output);
+
+    uint32_t start = micros();
+
+    for (const char *p = command; *p; ++p) {
+        scpi::input(serial::scpi_context, *p);
+    }
+    scpi::input(serial::scpi_context, '\n');
+
+    // one pass of the main loop, more if command started long operation
+    do {
+        tickMeasured();
+    } while (long_operation::isBusy());
+
+    uint32_t duration = micros() - start;
+
+    Serial.capture(0);
+
+    ++g_numCommands;
+    g_totalCommandTime += duration;
+    if (duration > g_maxCommandTime) {
+        g_maxCommandTime = duration;
+    }
+
+    collectResponses();
+}
+
+static void runFor(uint32_t ms) {
+    Serial.capture(&g_output);
+    uint32_t start = millis();
+    while (millis() - start < ms) {
+        simulator::touchWrite(g_touchPressed, g_touchX, g_touchY);
+        tickMeasured();
+        delay(TICK_TIMEOUT);
+    }
+    Serial.capture(0);
+    g_output.clear();
+}
+
+static void popErrors(std::vector<int> &errors) {
+    scpi_error_info_t info;
+    while (SCPI_ErrorPopInfo(&serial::scpi_context, &info)) {
+        errors.push_back(info.code);
+    }
+}
+
+static std::string errorsToString(const std::vector<int> &errors) {
+    std::string result;
+    char buffer[16];
+    for (size_t i = 0; i < errors.size(); ++i) {
+        sprintf(buffer, i > 0 ? " %d" : "%d", errors[i]);
+        result += buffer;
+    }
+    return result.empty() ? "none" : result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+static bool checkResponse(const char *expected, std::string &actual) {
+    if (g_nextResponse >= g_responses.size()) {
+        actual = "no response";
+        return false;
+    }
+
+    actual = g_responses[g_nextResponse++];
+    return strcmp(expected, "*") == 0 || actual == expected;
+}
+
+static bool checkErrors(const char *expected, std::string &actual) {
+    std::vector<int> expectedErrors;
+    while (*expected) {
+        char *end;
+        long code = strtol(expected, &end, 10);
+        if (end == expected) {
+            break;
+        }
+        if (code != 0) {
+            expectedErrors.push_back((int)code);
+        }
+        expected = end;
+    }
+
+    std::vector<int> errors;
+    popErrors(errors);
+
+    actual = errorsToString(errors);
+    return errors == expectedErrors;
+}
+
+/// Golden image path relative to the script directory.
+static std::string getGoldenPath(const char *script_path, const char *file_name) {
+    if (*file_name == '/' || *file_name == '\\' || (*file_name && file_name[1] == ':')) {
+        return file_name;
+    }
+
+    std::string path = script_path;
+    size_t pos = path.find_last_of("/\\");
+    if (pos == std::string::npos) {
+        return file_name;
+    }
+    return path.substr(0, pos + 1) + file_name;
+}
+
+static bool checkCapture(const char *file_path, bool record, std::string &actual) {
+#if OPTION_DISPLAY
+    gui::flush();
+
+    int w = gui::lcd::lcd.getDisplayXSize();
+    int h = gui::lcd::lcd.getDisplayYSize();
+    const word *buffer = gui::lcd::lcd.buffer;
+
+    if (record) {
+        if (!simulator::saveFramebuffer(file_path)) {
+            actual = "can't write golden image";
+            return false;
+        }
+        printf("%s: golden image recorded\n", file_path);
+        return true;
+    }
+
+    FILE *fp = fopen(file_path, "rb");
+    if (!fp) {
+        actual = "golden image missing, run with --record to record it";
+        return false;
+    }
+
+    std::vector<uint8_t> golden(w * h * 2);
+    size_t len = fread(&golden[0], 1, golden.size(), fp);
+    bool trailing = fgetc(fp) != EOF;
+    fclose(fp);
+
+    if (len != golden.size() || trailing) {
+        actual = "golden image size mismatch";
+        return false;
+    }
+
+    int numDiffs = 0;
+    int first = -1;
+    for (int i = 0; i < w * h; ++i) {
+        if (buffer[i] != (golden[2 * i] | (golden[2 * i + 1] << 8))) {
+            if (first == -1) {
+                first = i;
+            }
+            ++numDiffs;
+        }
+    }
+
+    if (numDiffs == 0) {
+        return true;
+    }
+
+    std::string actualPath = std::string(file_path) + ".actual.ppm";
+    simulator::saveFramebuffer(actualPath.c_str());
+
+    char text[128];
+    sprintf(text, "%d pixels differ, first at %d,%d", numDiffs, first % w, first / w);
+    actual = text;
+    return false;
+#else
+    actual = "no display";
+    return false;
+#endif
+}
+
+int runScript(const char *file_path, int repeat, bool record) {
+    FILE *fp = fopen(file_path, "r");
+    if (!fp) {
+        printf("%s: can't open file\n", file_path);
+        return 1;
+    }
+
+    std::vector<std::string> lines;
+    char line[1024];
+    while (fgets(line, sizeof(line), fp)) {
+        size_t len = strlen(line);
+        while (len > 0 && (line[len - 1] == '\n' || line[len - 1] == '\r')) {
+            line[--len] = 0;
+        }
+        lines.push_back(line);
+    }
+    fclose(fp);
+
+    resetStatistics();
+    int failed = 0;
+
+    for (int i = 0; i < repeat; ++i) {
+        for (size_t j = 0; j < lines.size(); ++j) {
+            const char *text = lines[j].c_str();
+            std::string actual;
+
+            if (*text == 0 || *text == '#') {
+                continue;
+            }
+
+            if (*text == '>') {
+                const char *expected = text[1] == ' ' ? text + 2 : text + 1;
+                if (!checkResponse(expected, actual)) {
+                    printf("%s:%d: expected response \"%s\", got \"%s\"\n", file_path, (int)(j + 1), expected, actual.c_str());
+                    ++failed;
+                }
+            } else if (*text == '!') {
+                if (!checkErrors(text + 1, actual)) {
+                    printf("%s:%d: expected errors \"%s\", got \"%s\"\n", file_path, (int)(j + 1), text + 1, actual.c_str());
+                    ++failed;
+                }
+            } else if (strncmp(text, "%wait ", 6) == 0) {
+                runFor((uint32_t)atol(text + 6));
+            } else if (strncmp(text, "%touch ", 7) == 0) {
+                int x, y;
+                if (sscanf(text + 7, "%d %d", &x, &y) == 2) {
+                    g_touchPressed = true;
+                    g_touchX = x;
+                    g_touchY = y;
+                } else {
+                    printf("%s:%d: invalid touch position\n", file_path, (int)(j + 1));
+                    ++failed;
+                }
+            } else if (strcmp(text, "%release") == 0) {
+                g_touchPressed = false;
+                g_touchX = -1;
+                g_touchY = -1;
+            } else if (strncmp(text, "%capture ", 9) == 0) {
+                std::string goldenPath = getGoldenPath(file_path, text + 9);
+                if (!checkCapture(goldenPath.c_str(), record, actual)) {
+                    printf("%s:%d: %s: %s\n", file_path, (int)(j + 1), goldenPath.c_str(), actual.c_str());
+                    ++failed;
+                }
+            } else {
+                sendCommand(text);
+            }
+        }
+    }
+
+    printStatistics(file_path);
+    printf("%s: %d failed checks\n", file_path, failed);
+
+    return failed;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+/// Make concrete command from pattern: optional parts are left out
+/// and channel number 1 is used for numeric suffix.
+static void patternToCommand(const char *pattern, char *command) {
+    int optional = 0;
+    for (; *pattern; ++pattern) {
+        if (*pattern == '[') {
+            ++optional;
+        } else if (*pattern == ']') {
+            --optional;
+        } else if (!optional) {
+            *command++ = *pattern == '#' ? '1' : *pattern;
+        }
+    }
+    *command = 0;
+}
+
+int runSweep() {
+    resetStatistics();
+    int failed = 0;
+    int numAccepted = 0;
+
+    sendCommand("SYST:POW ON");
+
+    for (const scpi_command_t *cmd = serial::scpi_context.cmdlist; cmd->pattern; ++cmd) {
+        bool skip = false;
+        for (int i = 0; g_sweepSkip[i]; ++i) {
+            if (strcmp(cmd->pattern, g_sweepSkip[i]) == 0) {
+                skip = true;
+                break;
+            }
+        }
+        if (skip) {
+            continue;
+        }
+
+        char command[256];
+        patternToCommand(cmd->pattern, command);
+        bool isQuery = command[strlen(command) - 1] == '?';
+
+        std::vector<int> errors;
+
+        sendCommand(command);
+        popErrors(errors);
+        if (isQuery && g_responses.empty() && errors.empty()) {
+            printf("%s: no response and no error\n", command);
+            ++failed;
+        } else if (!isQuery && !g_responses.empty()) {
+            printf("%s: unexpected response \"%s\"\n", command, g_responses[0].c_str());
+            ++failed;
+        }
+
+        errors.clear();
+        strcat(command, INVALID_ARGUMENT);
+        sendCommand(command);
+        popErrors(errors);
+        if (errors.empty()) {
+            printf("%s: invalid argument accepted\n", command);
+            ++numAccepted;
+        }
+    }
+
+    printStatistics("sweep");
+    printf("sweep: %d invalid arguments accepted, %d failed checks\n", numAccepted, failed);
+
+    return failed;
+}
+
+}
+}
+}
+} // namespace eez::psu::simulator::script_runner
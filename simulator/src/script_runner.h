@@ -0,0 +1,59 @@
+/*
+ * EEZ PSU Firmware
+ * Copyright (C) 2015-present, Envox d.o.o.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+ 
+#pragma once
+
+namespace eez {
+namespace psu {
+namespace simulator {
+/// Headless runner of SCPI scripts and command table sweep, used instead of
+/// the interactive main loop when simulator is started with command line options.
+///
+/// Script file syntax, one item per line:
+///
+///     # comment
+///     <command>       send command to the serial SCPI context
+///     > <response>    next response line of the previous command, "> *" matches any
+///     ! [<code> ...]  expected content of the error queue, the queue is emptied
+///     %wait <ms>      run the firmware main loop for given time
+///     %touch <x> <y>  press the touch screen at given position
+///     %release        release the touch screen
+///     %capture <file> finish the current frame and compare the framebuffer with the
+///                     golden image (raw RGB565, see saveFramebuffer), relative paths are
+///                     resolved from the script directory; missing golden image is a failed
+///                     check, on mismatch the actual image is saved next to it as <file>.actual.ppm
+///
+/// GUI is not drawn while the front panel is closed, use "SIMU:GUI:HEAD ON" before
+/// the touch and capture items.
+///
+/// Scripts in simulator/scripts are run by "make test" (simulator/platform/linux).
+///
+namespace script_runner {
+
+/// Run script file given number of times, returns number of failed checks.
+/// With record set, %capture items write the golden images instead of comparing.
+int runScript(const char *file_path, int repeat, bool record);
+
+/// Send every command from the command table, once without and once with an
+/// invalid argument, returns number of failed checks.
+int runSweep();
+
+}
+}
+}
+} // namespace eez::psu::simulator::script_runner
@@ -29,6 +29,10 @@
 #define SIM_LOAD_DEF 1000.0f
 #define SIM_LOAD_MAX 10000000.0F
 
+#define SIM_LOAD_TIME_MIN 0.001f
+#define SIM_LOAD_TIME_MAX 86400.0f
+#define SIM_LOAD_CAPACITANCE_MAX 1.0f
+
 #define SIM_TEMP_MIN 0
 #define SIM_TEMP_DEF 25.0f
 #define SIM_TEMP_MAX 120.0f
@@ -18,7 +18,9 @@
 
 #include "psu.h"
 #include "chips.h"
+#include "touch.h"
 #if OPTION_DISPLAY
+#include "lcd.h"
 #include "front_panel/control.h"
 #endif
 
@@ -47,6 +49,32 @@ namespace simulator {
 
 float temperature[temp_sensor::NUM_TEMP_SENSORS];
 
+#define AUDIO_LOG_SIZE 256
+static AudioEvent g_audioLog[AUDIO_LOG_SIZE];
+static int g_audioLogCount;
+
+#define TOUCH_TRACE_SIZE 4096
+struct TouchSample {
+    uint32_t time; // in milliseconds
+    int16_t x;
+    int16_t y;
+};
+static TouchSample g_touchTrace[TOUCH_TRACE_SIZE];
+static int g_touchTraceCount;
+static int g_touchTraceIndex;
+static uint32_t g_touchTraceStartTime;
+static bool g_touchTracePlaying;
+
+static FILE *g_touchRecordingFile;
+static uint32_t g_touchRecordingStartTime;
+static bool g_touchRecordingIsPressed;
+static int g_touchRecordingX;
+static int g_touchRecordingY;
+
+static bool g_guiHeadless;
+
+static void touchTraceTick();
+
 void init() {
     for (int i = 0; i < temp_sensor::NUM_TEMP_SENSORS; ++i) {
         temperature[i] = 25.0f;
@@ -55,6 +83,7 @@ void init() {
 
 void tick() {
     chips::tick();
+    touchTraceTick();
     psu::tick();
 #if OPTION_DISPLAY
     front_panel::tick();
@@ -97,6 +126,175 @@ char *getConfFilePath(char *file_name) {
     return file_path;
 }
 
+void logAudioEvent(uint16_t frequency, uint16_t duration, uint8_t priority) {
+    if (g_audioLogCount < AUDIO_LOG_SIZE) {
+        AudioEvent &event = g_audioLog[g_audioLogCount++];
+        event.time = millis();
+        event.frequency = frequency;
+        event.duration = duration;
+        event.priority = priority;
+    }
+}
+
+const AudioEvent *getAudioLog(int &count) {
+    count = g_audioLogCount;
+    return g_audioLog;
+}
+
+void clearAudioLog() {
+    g_audioLogCount = 0;
+}
+
+bool playTouchTrace(const char *file_path) {
+    FILE *fp = fopen(file_path, "r");
+    if (!fp) {
+        return false;
+    }
+
+    g_touchTraceCount = 0;
+
+    char line[128];
+    while (fgets(line, sizeof(line), fp) && g_touchTraceCount < TOUCH_TRACE_SIZE) {
+        unsigned long time;
+        int x, y;
+        if (line[0] == '#' || sscanf(line, "%lu %d %d", &time, &x, &y) != 3) {
+            continue;
+        }
+
+        TouchSample &sample = g_touchTrace[g_touchTraceCount++];
+        sample.time = (uint32_t)time;
+        sample.x = (int16_t)x;
+        sample.y = (int16_t)y;
+    }
+
+    fclose(fp);
+
+    g_touchTraceIndex = 0;
+    g_touchTraceStartTime = millis();
+    g_touchTracePlaying = g_touchTraceCount > 0;
+
+    return true;
+}
+
+bool isTouchTracePlaying() {
+    return g_touchTracePlaying;
+}
+
+static void touchTraceTick() {
+    if (!g_touchTracePlaying) {
+        return;
+    }
+
+    uint32_t time = millis() - g_touchTraceStartTime;
+
+    // skip to the latest sample due, as the touch controller would
+    int i = g_touchTraceIndex;
+    while (i < g_touchTraceCount && g_touchTrace[i].time <= time) {
+        ++i;
+    }
+
+    if (i > g_touchTraceIndex) {
+        g_touchTraceIndex = i;
+        TouchSample &sample = g_touchTrace[i - 1];
+        gui::touch::touch_write(sample.x >= 0 && sample.y >= 0, sample.x, sample.y);
+    }
+
+    if (g_touchTraceIndex == g_touchTraceCount) {
+        g_touchTracePlaying = false;
+        gui::touch::touch_write(false, -1, -1);
+    }
+}
+
+bool startTouchRecording(const char *file_path) {
+    stopTouchRecording();
+
+    g_touchRecordingFile = fopen(file_path, "w");
+    if (!g_touchRecordingFile) {
+        return false;
+    }
+
+    g_touchRecordingStartTime = millis();
+    g_touchRecordingIsPressed = false;
+    g_touchRecordingX = -1;
+    g_touchRecordingY = -1;
+
+    return true;
+}
+
+void stopTouchRecording() {
+    if (g_touchRecordingFile) {
+        fclose(g_touchRecordingFile);
+        g_touchRecordingFile = 0;
+    }
+}
+
+void touchWrite(bool is_pressed, int x, int y) {
+    if (g_touchRecordingFile) {
+        if (is_pressed != g_touchRecordingIsPressed || x != g_touchRecordingX || y != g_touchRecordingY) {
+            fprintf(g_touchRecordingFile, "%lu %d %d\n", (unsigned long)(millis() - g_touchRecordingStartTime), is_pressed ? x : -1, is_pressed ? y : -1);
+            g_touchRecordingIsPressed = is_pressed;
+            g_touchRecordingX = x;
+            g_touchRecordingY = y;
+        }
+    }
+
+    // trace replay owns the touch until it is finished
+    if (!g_touchTracePlaying) {
+        gui::touch::touch_write(is_pressed, x, y);
+    }
+}
+
+void setGuiHeadless(bool enable) {
+    g_guiHeadless = enable;
+}
+
+bool isGuiHeadless() {
+    return g_guiHeadless;
+}
+
+bool saveFramebuffer(const char *file_path) {
+#if OPTION_DISPLAY
+    FILE *fp = fopen(file_path, "wb");
+    if (!fp) {
+        return false;
+    }
+
+    int w = gui::lcd::lcd.getDisplayXSize();
+    int h = gui::lcd::lcd.getDisplayYSize();
+    const word *p = gui::lcd::lcd.buffer;
+
+    size_t len = strlen(file_path);
+    bool ppm = len > 4 && strcasecmp(file_path + len - 4, ".ppm") == 0;
+    if (ppm) {
+        fprintf(fp, "P6\n%d %d\n255\n", w, h);
+    }
+
+    for (int i = 0; i < w * h; ++i, ++p) {
+        uint8_t bytes[3];
+        if (ppm) {
+            // rrrrrggggggbbbbb, low bits repeated to get the full range
+            uint8_t r = (*p >> 11) & 0x1F;
+            uint8_t g = (*p >> 5) & 0x3F;
+            uint8_t b = *p & 0x1F;
+            bytes[0] = (r << 3) | (r >> 2);
+            bytes[1] = (g << 2) | (g >> 4);
+            bytes[2] = (b << 3) | (b >> 2);
+            fwrite(bytes, 1, 3, fp);
+        } else {
+            bytes[0] = *p & 0xFF;
+            bytes[1] = *p >> 8;
+            fwrite(bytes, 1, 2, fp);
+        }
+    }
+
+    bool result = !ferror(fp);
+    fclose(fp);
+    return result;
+#else
+    return false;
+#endif
+}
+
 void exit() {
     main_loop_exit();
 }
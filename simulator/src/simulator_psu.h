@@ -28,6 +28,7 @@
 #endif
 
 #include <stdlib.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <string.h>
 #include <math.h>
@@ -45,9 +46,6 @@
 
 extern void eez_psu_init();
 
-#define interrupts() 0
-#define noInterrupts() 0
-
 namespace eez {
 namespace psu {
 /// Firmware simulator.
@@ -61,6 +59,41 @@ float getTemperature(int sensor);
 
 char *getConfFilePath(char *file_name);
 
+/// Tone accepted by the sound sequencer.
+struct AudioEvent {
+    uint32_t time; // in milliseconds
+    uint16_t frequency;
+    uint16_t duration;
+    uint8_t priority;
+};
+
+/// Called by the sound sequencer for each played note, so the tests
+/// can check what is played without waiting for the tones to finish.
+void logAudioEvent(uint16_t frequency, uint16_t duration, uint8_t priority);
+const AudioEvent *getAudioLog(int &count);
+void clearAudioLog();
+
+/// Replay touch trace file, one "<time in ms> <x> <y>" line per sample,
+/// x and y are -1 when touch is released.
+bool playTouchTrace(const char *file_path);
+bool isTouchTracePlaying();
+
+/// Record front panel touch into the trace file, in the format accepted by playTouchTrace.
+bool startTouchRecording(const char *file_path);
+void stopTouchRecording();
+
+/// Called by the front panel for the current touch state.
+void touchWrite(bool is_pressed, int x, int y);
+
+/// Keep the GUI running when the front panel is not opened, so the framebuffer
+/// is drawn and can be captured in the headless runs.
+void setGuiHeadless(bool enable);
+bool isGuiHeadless();
+
+/// Save the LCD framebuffer, as binary PPM when the file name ends with ".ppm",
+/// otherwise as raw RGB565 pixels, little-endian, row by row.
+bool saveFramebuffer(const char *file_path);
+
 void exit();
 
 }